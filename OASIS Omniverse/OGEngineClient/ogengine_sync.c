@@ -0,0 +1,2173 @@
+﻿/**
+ * OASIS STAR API - Generic game integration layer implementation.
+ * Async auth, async inventory (with optional local-item sync), single-item sync.
+ * Compiles on Windows (Win32 threads) and elsewhere (pthreads).
+ */
+
+#include "ogengine_sync.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef OGENGINE_HAS_SEND_ITEM
+extern ogengine_result_t ogengine_send_item_to_avatar(const char*, const char*, int, const char*);
+extern ogengine_result_t ogengine_send_item_to_clan(const char*, const char*, int, const char*);
+#endif
+
+/* Optional stub for ogengine_queue_quest_level_time when not linking ogengine.dll (e.g. vkQuake with older lib).
+ * Define OGENGINE_PROVIDE_QUEST_LEVEL_TIME_STUB in the build to resolve LNK2001; otherwise link with a
+ * STAR API build that exports this (StarApiClient.cs UnmanagedCallersOnly). */
+#ifdef OGENGINE_PROVIDE_QUEST_LEVEL_TIME_STUB
+void ogengine_queue_quest_level_time(const char* game_source, int level_elapsed_seconds)
+{
+    (void)game_source;
+    (void)level_elapsed_seconds;
+}
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+/* Safe copy; always null-terminates, truncates to size-1 */
+static void str_copy(char* dst, const char* src, size_t size) {
+    if (!size) return;
+    if (!src) { dst[0] = '\0'; return; }
+    size_t n = 0;
+    while (n + 1 < size && src[n]) {
+        dst[n] = src[n];
+        n++;
+    }
+    dst[n] = '\0';
+}
+
+/* Optional trace hook (ogengine_sync_set_trace_cb): spans for pump, callbacks and worker operations. */
+static ogengine_sync_trace_fn g_trace_cb = NULL;
+static void* g_trace_user = NULL;
+#define SYNC_TRACE(name, phase) do { if (g_trace_cb) g_trace_cb((name), (phase), g_trace_user); } while (0)
+
+void ogengine_sync_set_trace_cb(ogengine_sync_trace_fn cb, void* user_data) {
+    g_trace_cb = cb;
+    g_trace_user = user_data;
+}
+
+int ogengine_sync_abi_version(void) {
+    return OGENGINE_SYNC_ABI_VERSION;
+}
+
+/* ---------------------------------------------------------------------------
+ * Worker pool: OGENGINE_SYNC_POOL_THREADS threads created once in ogengine_sync_init.
+ * Each worker owns a small job deque; submit deals jobs round-robin and a worker
+ * whose own deque is empty steals the oldest job from a sibling, so one slow HTTP
+ * call does not strand the jobs queued behind it. g_pool_queued counts jobs across
+ * all deques; a worker that decrements it is guaranteed to find one.
+ * --------------------------------------------------------------------------- */
+#ifndef OGENGINE_SYNC_POOL_THREADS
+#define OGENGINE_SYNC_POOL_THREADS 4
+#endif
+#define POOL_DEQUE_SIZE 64           /* per worker; power of two */
+#define POOL_SHUTDOWN_GRACE_MS 2000  /* how long cleanup waits for in-flight jobs */
+
+typedef struct {
+    ogengine_sync_job_fn fn;
+    void* arg;
+} sync_job_t;
+
+typedef struct {
+    sync_job_t jobs[POOL_DEQUE_SIZE];
+    unsigned head;  /* oldest job */
+    unsigned tail;  /* next free slot */
+    int index;
+    int named;      /* trace thread name sent */
+#ifdef _WIN32
+    CRITICAL_SECTION lock;
+    HANDLE thread;
+#else
+    pthread_mutex_t lock;
+    pthread_t thread;
+#endif
+} sync_worker_t;
+
+static sync_worker_t g_pool[OGENGINE_SYNC_POOL_THREADS];
+static int g_pool_threads = 0;
+static int g_pool_detached = 0;  /* workers left running by a non-idle pool_stop; their locks are still live */
+static int g_pool_live = 0;      /* worker threads that have not exited yet (under g_pool_wake_lock) */
+static int g_pool_stop = 0;
+static int g_pool_queued = 0;
+static int g_pool_busy = 0;
+static unsigned g_pool_next = 0;
+#ifdef _WIN32
+static CRITICAL_SECTION g_pool_wake_lock;
+static CONDITION_VARIABLE g_pool_wake;
+#else
+static pthread_mutex_t g_pool_wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_pool_wake = PTHREAD_COND_INITIALIZER;
+#endif
+
+static const char* const g_pool_thread_names[] = {
+    "ogengine_sync worker 0", "ogengine_sync worker 1", "ogengine_sync worker 2", "ogengine_sync worker 3",
+    "ogengine_sync worker 4", "ogengine_sync worker 5", "ogengine_sync worker 6", "ogengine_sync worker 7"
+};
+
+static void pool_wake_lock(void) {
+#ifdef _WIN32
+    EnterCriticalSection(&g_pool_wake_lock);
+#else
+    pthread_mutex_lock(&g_pool_wake_lock);
+#endif
+}
+
+static void pool_wake_unlock(void) {
+#ifdef _WIN32
+    LeaveCriticalSection(&g_pool_wake_lock);
+#else
+    pthread_mutex_unlock(&g_pool_wake_lock);
+#endif
+}
+
+static int pool_deque_push(sync_worker_t* w, ogengine_sync_job_fn fn, void* arg) {
+    int ok = 0;
+#ifdef _WIN32
+    EnterCriticalSection(&w->lock);
+#else
+    pthread_mutex_lock(&w->lock);
+#endif
+    if (w->tail - w->head < POOL_DEQUE_SIZE) {
+        sync_job_t* j = &w->jobs[w->tail & (POOL_DEQUE_SIZE - 1)];
+        j->fn = fn;
+        j->arg = arg;
+        w->tail++;
+        ok = 1;
+    }
+#ifdef _WIN32
+    LeaveCriticalSection(&w->lock);
+#else
+    pthread_mutex_unlock(&w->lock);
+#endif
+    return ok;
+}
+
+static int pool_deque_take(sync_worker_t* w, sync_job_t* out) {
+    int ok = 0;
+#ifdef _WIN32
+    EnterCriticalSection(&w->lock);
+#else
+    pthread_mutex_lock(&w->lock);
+#endif
+    if (w->head != w->tail) {
+        *out = w->jobs[w->head & (POOL_DEQUE_SIZE - 1)];
+        w->head++;
+        ok = 1;
+    }
+#ifdef _WIN32
+    LeaveCriticalSection(&w->lock);
+#else
+    pthread_mutex_unlock(&w->lock);
+#endif
+    return ok;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI pool_worker_proc(LPVOID param) {
+#else
+static void* pool_worker_proc(void* param) {
+#endif
+    sync_worker_t* self = (sync_worker_t*)param;
+    for (;;) {
+        sync_job_t job;
+        int i;
+        pool_wake_lock();
+        while (!g_pool_queued && !g_pool_stop) {
+#ifdef _WIN32
+            SleepConditionVariableCS(&g_pool_wake, &g_pool_wake_lock, INFINITE);
+#else
+            pthread_cond_wait(&g_pool_wake, &g_pool_wake_lock);
+#endif
+        }
+        if (g_pool_stop) {
+            g_pool_live--;
+            pool_wake_unlock();
+            break;
+        }
+        g_pool_queued--;
+        g_pool_busy++;
+        pool_wake_unlock();
+
+        /* Own deque first, then steal from the others. */
+        for (i = 0; ; i = (i + 1) % g_pool_threads) {
+            if (pool_deque_take(&g_pool[(self->index + i) % g_pool_threads], &job)) break;
+        }
+        if (g_trace_cb && !self->named) {
+            self->named = 1;
+            SYNC_TRACE(g_pool_thread_names[self->index], 'M');
+        }
+        job.fn(job.arg);
+
+        pool_wake_lock();
+        g_pool_busy--;
+        pool_wake_unlock();
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static void pool_start(void) {
+    int i;
+    int n = OGENGINE_SYNC_POOL_THREADS;
+    if (n > (int)(sizeof(g_pool_thread_names) / sizeof(g_pool_thread_names[0])))
+        n = (int)(sizeof(g_pool_thread_names) / sizeof(g_pool_thread_names[0]));
+#ifdef _WIN32
+    InitializeCriticalSection(&g_pool_wake_lock);
+    InitializeConditionVariable(&g_pool_wake);
+#endif
+    g_pool_stop = 0;
+    g_pool_queued = 0;
+    g_pool_busy = 0;
+    g_pool_threads = 0;
+    for (i = 0; i < n; i++) {
+        sync_worker_t* w = &g_pool[i];
+        memset(w, 0, sizeof(*w));
+        w->index = i;
+#ifdef _WIN32
+        InitializeCriticalSection(&w->lock);
+        w->thread = CreateThread(NULL, 0, pool_worker_proc, w, 0, NULL);
+        if (!w->thread) { DeleteCriticalSection(&w->lock); break; }
+#else
+        pthread_mutex_init(&w->lock, NULL);
+        if (pthread_create(&w->thread, NULL, pool_worker_proc, w) != 0) { pthread_mutex_destroy(&w->lock); break; }
+#endif
+        g_pool_threads++;
+    }
+    pool_wake_lock();
+    g_pool_live = g_pool_threads;
+    pool_wake_unlock();
+}
+
+/* Returns 1 if all workers exited (locks destroyed), 0 if some were still inside a job after the grace period
+ * and were detached; their locks are then left alive because the job may still take them. */
+static int pool_stop(void) {
+    int i, waited = 0, busy;
+    pool_wake_lock();
+    g_pool_stop = 1;
+#ifdef _WIN32
+    WakeAllConditionVariable(&g_pool_wake);
+#else
+    pthread_cond_broadcast(&g_pool_wake);
+#endif
+    busy = g_pool_busy;
+    pool_wake_unlock();
+    while (busy && waited < POOL_SHUTDOWN_GRACE_MS) {
+#ifdef _WIN32
+        Sleep(10);
+#else
+        struct timespec ts = { 0, 10 * 1000000L };
+        nanosleep(&ts, NULL);
+#endif
+        waited += 10;
+        pool_wake_lock();
+        busy = g_pool_busy;
+        pool_wake_unlock();
+    }
+    for (i = 0; i < g_pool_threads; i++) {
+        sync_worker_t* w = &g_pool[i];
+#ifdef _WIN32
+        if (!busy) WaitForSingleObject(w->thread, INFINITE);
+        CloseHandle(w->thread);
+        if (!busy) DeleteCriticalSection(&w->lock);
+#else
+        if (!busy) {
+            pthread_join(w->thread, NULL);
+            pthread_mutex_destroy(&w->lock);
+        } else {
+            pthread_detach(w->thread);
+        }
+#endif
+    }
+    g_pool_detached = busy ? g_pool_threads : 0;
+    g_pool_threads = 0;
+#ifdef _WIN32
+    if (!busy) DeleteCriticalSection(&g_pool_wake_lock);
+#endif
+    return busy ? 0 : 1;
+}
+
+/* After a non-idle pool_stop: 1 once every detached worker has exited, and then tears down the worker locks it left alive. */
+static int pool_drained(void) {
+    int i, live;
+    pool_wake_lock();
+    live = g_pool_live;
+    pool_wake_unlock();
+    if (live) return 0;
+    for (i = 0; i < g_pool_detached; i++) {
+#ifdef _WIN32
+        DeleteCriticalSection(&g_pool[i].lock);
+#else
+        pthread_mutex_destroy(&g_pool[i].lock);
+#endif
+    }
+    g_pool_detached = 0;
+#ifdef _WIN32
+    DeleteCriticalSection(&g_pool_wake_lock);
+#endif
+    return 1;
+}
+
+int ogengine_sync_job_submit(ogengine_sync_job_fn fn, void* arg) {
+    int i, n;
+    unsigned first;
+    if (!fn) return 0;
+    n = g_pool_threads;
+    if (n <= 0) return 0;
+    /* Workers submit follow-up ops too, so the round-robin cursor is shared. */
+    pool_wake_lock();
+    first = g_pool_next++;
+    pool_wake_unlock();
+    for (i = 0; i < n; i++) {
+        if (pool_deque_push(&g_pool[(first + (unsigned)i) % (unsigned)n], fn, arg)) {
+            pool_wake_lock();
+            g_pool_queued++;
+#ifdef _WIN32
+            WakeConditionVariable(&g_pool_wake);
+#else
+            pthread_cond_signal(&g_pool_wake);
+#endif
+            pool_wake_unlock();
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Completion queue: workers push finished operations onto one lock-free MPSC
+ * stack; the pump takes the whole stack with a single exchange and reverses it,
+ * so completions are delivered in the order they finished. g_done_head doubles
+ * as the has-work flag: an idle pump is one relaxed load and takes no locks.
+ * --------------------------------------------------------------------------- */
+typedef struct sync_done_s {
+    struct sync_done_s* next;
+    void (*deliver)(struct sync_done_s* done);  /* main thread */
+} sync_done_t;
+
+static sync_done_t* volatile g_done_head = NULL;
+
+#ifdef _WIN32
+static sync_done_t* done_load_relaxed(void) { return g_done_head; }
+static sync_done_t* done_exchange(sync_done_t* v) {
+    return (sync_done_t*)InterlockedExchangePointer((PVOID volatile*)&g_done_head, v);
+}
+static int done_cas(sync_done_t* expected, sync_done_t* desired) {
+    return InterlockedCompareExchangePointer((PVOID volatile*)&g_done_head, desired, expected) == expected;
+}
+static long flag_exchange(volatile long* p, long v) { return InterlockedExchange(p, v); }
+static long flag_load(volatile long* p) { return InterlockedCompareExchange(p, 0, 0); }
+static void counter_add(volatile long* p, long v) { InterlockedExchangeAdd(p, v); }
+#else
+static sync_done_t* done_load_relaxed(void) { return __atomic_load_n(&g_done_head, __ATOMIC_RELAXED); }
+static sync_done_t* done_exchange(sync_done_t* v) { return __atomic_exchange_n(&g_done_head, v, __ATOMIC_ACQ_REL); }
+static int done_cas(sync_done_t* expected, sync_done_t* desired) {
+    return __atomic_compare_exchange_n(&g_done_head, &expected, desired, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+static long flag_exchange(volatile long* p, long v) { return __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL); }
+static long flag_load(volatile long* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static void counter_add(volatile long* p, long v) { __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL); }
+#endif
+
+/* Any thread. A node must not be pushed again until it has been delivered. */
+static void done_push(sync_done_t* d) {
+    sync_done_t* head;
+    do {
+        head = done_load_relaxed();
+        d->next = head;
+    } while (!done_cas(head, d));
+}
+
+/* Main-thread backlog: completions taken from the stack but not yet delivered (pump budget ran out). */
+static sync_done_t* g_backlog_head = NULL;
+static sync_done_t* g_backlog_tail = NULL;
+static int g_backlog_count = 0;
+
+/* Main thread: move everything pushed so far to the end of the backlog, oldest first. */
+static void done_take_all(void) {
+    sync_done_t* d = done_exchange(NULL);
+    sync_done_t* fifo = NULL;
+    sync_done_t* last = d;
+    int n = 0;
+    while (d) {
+        sync_done_t* next = d->next;
+        d->next = fifo;
+        fifo = d;
+        d = next;
+        n++;
+    }
+    if (!fifo) return;
+    if (g_backlog_tail) g_backlog_tail->next = fifo;
+    else g_backlog_head = fifo;
+    g_backlog_tail = last;
+    g_backlog_count += n;
+}
+
+static int64_t sync_now_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (int64_t)((now.QuadPart / freq.QuadPart) * 1000000
+                   + (now.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION sync_lock_t;
+#else
+typedef pthread_mutex_t sync_lock_t;
+#endif
+
+static void sync_lock(sync_lock_t* l) {
+#ifdef _WIN32
+    EnterCriticalSection(l);
+#else
+    pthread_mutex_lock(l);
+#endif
+}
+
+static void sync_unlock(sync_lock_t* l) {
+#ifdef _WIN32
+    LeaveCriticalSection(l);
+#else
+    pthread_mutex_unlock(l);
+#endif
+}
+
+/* ---------------------------------------------------------------------------
+ * Operation handles: family in the top 4 bits, a per-family generation in the
+ * next 20 and the ring slot in the low 8, so a stale handle never matches a
+ * reused slot. Workers publish the operation they are running in thread-local
+ * state for the transport (ogengine_sync_current_op*); the abort callback
+ * tells it when a running operation is cancelled or times out. Deadlines are
+ * enforced by the pump, which only scans while g_deadlines_armed > 0.
+ * --------------------------------------------------------------------------- */
+enum { OP_FAMILY_AUTH = 1, OP_FAMILY_INVENTORY, OP_FAMILY_SEND, OP_FAMILY_USE };
+
+#define OP_GEN_MASK 0xFFFFFu
+#define OP_HANDLE(family, gen, slot) \
+    ((ogengine_sync_op_t)(((uint32_t)(family) << 28) | (((uint32_t)(gen) & OP_GEN_MASK) << 8) | ((uint32_t)(slot) & 0xFFu)))
+#define OP_HANDLE_FAMILY(h) ((unsigned)((h) >> 28))
+#define OP_HANDLE_SLOT(h) ((unsigned)((h) & 0xFFu))
+
+#define SYNC_ERR_TIMED_OUT "STAR operation timed out"
+
+static unsigned op_next_gen(unsigned gen) {
+    gen = (gen + 1) & OP_GEN_MASK;
+    return gen ? gen : 1;
+}
+
+static int64_t op_deadline(int64_t now, int timeout_ms) {
+    return timeout_ms > 0 ? now + (int64_t)timeout_ms * 1000 : 0;
+}
+
+/* Operations (auth and ring ops) whose deadline the pump still has to watch. */
+static volatile long g_deadlines_armed = 0;
+
+static ogengine_sync_abort_fn g_abort_cb = NULL;
+static void* g_abort_user = NULL;
+
+void ogengine_sync_set_abort_cb(ogengine_sync_abort_fn cb, void* user_data) {
+    g_abort_cb = cb;
+    g_abort_user = user_data;
+}
+
+static void sync_abort_notify(ogengine_sync_op_t handle) {
+    if (g_abort_cb && handle) g_abort_cb(handle, g_abort_user);
+}
+
+#ifdef _WIN32
+#define SYNC_THREAD_LOCAL __declspec(thread)
+#else
+#define SYNC_THREAD_LOCAL __thread
+#endif
+
+/* The operation this worker is running; zero outside one. */
+static SYNC_THREAD_LOCAL ogengine_sync_op_t t_cur_handle = 0;
+static SYNC_THREAD_LOCAL int64_t t_cur_deadline = 0;
+static SYNC_THREAD_LOCAL volatile long* t_cur_cancelled = NULL;
+
+static void sync_set_current(ogengine_sync_op_t handle, int64_t deadline_us, volatile long* cancelled) {
+    t_cur_handle = handle;
+    t_cur_deadline = deadline_us;
+    t_cur_cancelled = cancelled;
+}
+
+ogengine_sync_op_t ogengine_sync_current_op(void) {
+    return t_cur_handle;
+}
+
+int ogengine_sync_current_op_remaining_ms(void) {
+    int64_t left;
+    if (!t_cur_handle || !t_cur_deadline) return -1;
+    left = t_cur_deadline - sync_now_us();
+    if (left <= 0) return 0;
+    return left / 1000 > 0x7FFFFFFF ? 0x7FFFFFFF : (int)((left + 999) / 1000);
+}
+
+int ogengine_sync_current_op_cancelled(void) {
+    return t_cur_cancelled && flag_load(t_cur_cancelled) ? 1 : 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Stats: every delivered operation records four latencies from its timestamps
+ * (enqueue, worker start, worker done, pump delivery) into per-family log2
+ * histograms. Histograms and the delivered count are only touched on the main
+ * thread (pump, get_stats); the other counters are kept under the family lock.
+ * Two windows rotate every SYNC_STATS_WINDOW_US so the report covers the last
+ * one to two windows.
+ * --------------------------------------------------------------------------- */
+#define SYNC_STATS_WINDOW_US 10000000
+#define SYNC_STATS_FAMILIES (OP_FAMILY_USE + 1)
+
+enum { SYNC_PHASE_QUEUE = 0, SYNC_PHASE_NETWORK, SYNC_PHASE_DELIVERY, SYNC_PHASE_TOTAL, SYNC_PHASES };
+
+typedef struct {
+    ogengine_sync_histogram_t cur[SYNC_PHASES];
+    ogengine_sync_histogram_t prev[SYNC_PHASES];
+    unsigned delivered;                     /* main thread */
+    unsigned started, cancelled, timed_out; /* under the family lock */
+} sync_stats_t;
+
+static sync_stats_t g_stats[SYNC_STATS_FAMILIES];
+static int64_t g_stats_window_start = 0;
+
+static void hist_add(ogengine_sync_histogram_t* h, int64_t us) {
+    int b = 0;
+    if (us < 0) us = 0;
+    while (b < OGENGINE_SYNC_STATS_BUCKETS - 1 && us >= ((int64_t)OGENGINE_SYNC_STATS_BUCKET0_US << b))
+        b++;
+    h->buckets[b]++;
+    h->count++;
+    h->sum_us += (uint64_t)us;
+    if (us > (int64_t)h->max_us) h->max_us = us > 0xFFFFFFFF ? 0xFFFFFFFFu : (uint32_t)us;
+}
+
+static void hist_merge(ogengine_sync_histogram_t* dst, const ogengine_sync_histogram_t* src) {
+    int b;
+    for (b = 0; b < OGENGINE_SYNC_STATS_BUCKETS; b++)
+        dst->buckets[b] += src->buckets[b];
+    dst->count += src->count;
+    dst->sum_us += src->sum_us;
+    if (src->max_us > dst->max_us) dst->max_us = src->max_us;
+}
+
+/* Main thread. Start a new window when the current one is over; after two idle windows both are empty. */
+static void stats_roll(int64_t now) {
+    int f;
+    int64_t age = now - g_stats_window_start;
+    if (g_stats_window_start && age < SYNC_STATS_WINDOW_US) return;
+    for (f = 0; f < SYNC_STATS_FAMILIES; f++) {
+        if (g_stats_window_start && age < 2 * (int64_t)SYNC_STATS_WINDOW_US)
+            memcpy(g_stats[f].prev, g_stats[f].cur, sizeof(g_stats[f].prev));
+        else
+            memset(g_stats[f].prev, 0, sizeof(g_stats[f].prev));
+        memset(g_stats[f].cur, 0, sizeof(g_stats[f].cur));
+    }
+    g_stats_window_start = now;
+}
+
+/* Main thread, when the pump delivers an op. t_start/t_done are 0 if the op never reached a worker. */
+static void stats_record(int family, int64_t t_enqueue, int64_t t_start, int64_t t_done, int64_t t_delivered) {
+    sync_stats_t* st = &g_stats[family];
+    stats_roll(t_delivered);
+    st->delivered++;
+    if (t_start && t_done) {
+        hist_add(&st->cur[SYNC_PHASE_QUEUE], t_start - t_enqueue);
+        hist_add(&st->cur[SYNC_PHASE_NETWORK], t_done - t_start);
+        hist_add(&st->cur[SYNC_PHASE_DELIVERY], t_delivered - t_done);
+    }
+    hist_add(&st->cur[SYNC_PHASE_TOTAL], t_delivered - t_enqueue);
+}
+
+/* ---------------------------------------------------------------------------
+ * Auth state
+ * --------------------------------------------------------------------------- */
+#define AUTH_USERNAME_SIZE  64
+#define AUTH_AVATAR_SIZE    64
+#define AUTH_ERROR_SIZE     256
+#define AUTH_JWT_SIZE       2048
+
+static char g_auth_username_buf[AUTH_USERNAME_SIZE];
+static char g_auth_password_buf[64];
+static int  g_auth_in_progress = 0;
+static int  g_auth_has_result = 0;
+static int  g_auth_success = 0;
+static char g_auth_username_out[AUTH_USERNAME_SIZE];
+static char g_auth_avatar_id_out[AUTH_AVATAR_SIZE];
+static char g_auth_jwt_out[AUTH_JWT_SIZE];
+static char g_auth_error_msg[AUTH_ERROR_SIZE];
+static ogengine_sync_auth_on_done_fn g_auth_on_done = NULL;
+static void* g_auth_on_done_user = NULL;
+/* Bumped by every start and withdrawal; a job whose generation no longer matches drops its result. */
+static unsigned g_auth_gen = 0;
+static ogengine_sync_op_t g_auth_handle = 0;
+static int64_t g_auth_deadline_us = 0;
+static int g_auth_armed = 0;
+static volatile long* g_auth_cancel_flag = NULL;  /* running job's cancelled flag (on its stack) */
+static int64_t g_auth_t_enqueue = 0, g_auth_t_start = 0, g_auth_t_done = 0;  /* stats; t_enqueue 0 = nothing to record */
+
+#ifdef _WIN32
+static CRITICAL_SECTION g_auth_lock;
+#else
+static pthread_mutex_t g_auth_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Auth has one result slot; its completion node is queued at most once until the pump delivers it. */
+static void auth_deliver(sync_done_t* done);
+static sync_done_t g_auth_done = { NULL, auth_deliver };
+static volatile long g_auth_done_queued = 0;
+
+static void auth_signal_done(void) {
+    if (flag_exchange(&g_auth_done_queued, 1) == 0)
+        done_push(&g_auth_done);
+}
+
+/* Caller holds g_auth_lock. Stop watching the auth deadline. */
+static void auth_disarm_locked(void) {
+    if (g_auth_armed) {
+        g_auth_armed = 0;
+        counter_add(&g_deadlines_armed, -1);
+    }
+}
+
+/* Caller holds g_auth_lock. Detach the running job: it is flagged cancelled and whatever it returns is dropped. */
+static void auth_withdraw_locked(void) {
+    g_auth_gen = op_next_gen(g_auth_gen);
+    if (g_auth_cancel_flag) {
+        flag_exchange(g_auth_cancel_flag, 1);
+        g_auth_cancel_flag = NULL;
+    }
+    g_auth_in_progress = 0;
+    auth_disarm_locked();
+    g_auth_t_enqueue = 0;
+}
+
+static void auth_job(void* param) {
+    unsigned gen = (unsigned)(uintptr_t)param;
+    volatile long cancelled = 0;
+    char user[AUTH_USERNAME_SIZE], pass[64];
+    char jwt[AUTH_JWT_SIZE] = {0};
+    ogengine_result_t auth_result = OGENGINE_ERROR_NOT_INITIALIZED;
+    ogengine_result_t avatar_result = OGENGINE_ERROR_NOT_INITIALIZED;
+    char avatar_id[AUTH_AVATAR_SIZE] = {0};
+    const char* err = NULL;
+    ogengine_sync_op_t handle;
+    int64_t deadline;
+
+    sync_lock(&g_auth_lock);
+    if (gen != g_auth_gen) {  /* withdrawn before a worker picked it up */
+        sync_unlock(&g_auth_lock);
+        return;
+    }
+    str_copy(user, g_auth_username_buf, sizeof(user));
+    str_copy(pass, g_auth_password_buf, sizeof(pass));
+    g_auth_cancel_flag = &cancelled;
+    g_auth_t_start = sync_now_us();
+    handle = g_auth_handle;
+    deadline = g_auth_deadline_us;
+    sync_unlock(&g_auth_lock);
+
+    SYNC_TRACE("sync.auth", 'B');
+    sync_set_current(handle, deadline, &cancelled);
+    /* Authenticate and capture JWT in one call so games can persist to oasisstar.json (no dependency on get_current_jwt export).
+     * The JWT lands in a local buffer: a withdrawn job must not overwrite a newer login's token. */
+    auth_result = ogengine_authenticate_with_jwt_out(user, pass, jwt, sizeof(jwt));
+    if (auth_result == OGENGINE_SUCCESS && !flag_load(&cancelled)) {
+        avatar_result = ogengine_get_avatar_id(avatar_id, sizeof(avatar_id));
+        if (avatar_result != OGENGINE_SUCCESS)
+            err = ogengine_get_last_error();
+    } else {
+        err = ogengine_get_last_error();
+    }
+    sync_set_current(0, 0, NULL);
+    SYNC_TRACE("sync.auth", 'E');
+
+    sync_lock(&g_auth_lock);
+    if (g_auth_cancel_flag == &cancelled)
+        g_auth_cancel_flag = NULL;
+    if (gen != g_auth_gen) {  /* cancelled, timed out or force-reset while running */
+        sync_unlock(&g_auth_lock);
+        return;
+    }
+    g_auth_in_progress = 0;
+    auth_disarm_locked();
+    g_auth_t_done = sync_now_us();
+    g_auth_has_result = 1;
+    g_auth_success = (auth_result == OGENGINE_SUCCESS && avatar_result == OGENGINE_SUCCESS) ? 1 : 0;
+    str_copy(g_auth_username_out, user, sizeof(g_auth_username_out));
+    str_copy(g_auth_avatar_id_out, avatar_id, sizeof(g_auth_avatar_id_out));
+    str_copy(g_auth_jwt_out, jwt, sizeof(g_auth_jwt_out));
+    str_copy(g_auth_error_msg, err ? err : "", sizeof(g_auth_error_msg));
+    sync_unlock(&g_auth_lock);
+    auth_signal_done();
+}
+
+void ogengine_sync_auth_start(const char* username, const char* password, ogengine_sync_auth_on_done_fn on_done, void* user_data) {
+    (void)ogengine_sync_auth_start_op(username, password, 0, on_done, user_data);
+}
+
+ogengine_sync_op_t ogengine_sync_auth_start_op(const char* username, const char* password, int timeout_ms,
+    ogengine_sync_auth_on_done_fn on_done, void* user_data) {
+    ogengine_sync_op_t handle;
+    unsigned gen;
+    int64_t now = sync_now_us();
+    sync_lock(&g_auth_lock);
+    /* In progress, or thread finished but ogengine_sync_pump() has not run the on_done callback yet — do not clear buffers or start a second SSO. */
+    if (g_auth_in_progress || g_auth_has_result) {
+        sync_unlock(&g_auth_lock);
+        return 0;
+    }
+    g_auth_on_done = on_done;
+    g_auth_on_done_user = user_data;
+    str_copy(g_auth_username_buf, username ? username : "", sizeof(g_auth_username_buf));
+    str_copy(g_auth_password_buf, password ? password : "", sizeof(g_auth_password_buf));
+    g_auth_in_progress = 1;
+    g_auth_gen = gen = op_next_gen(g_auth_gen);
+    g_auth_handle = handle = OP_HANDLE(OP_FAMILY_AUTH, gen, 0);
+    g_auth_deadline_us = op_deadline(now, timeout_ms);
+    g_auth_t_enqueue = now;
+    g_auth_t_start = g_auth_t_done = 0;
+    g_stats[OP_FAMILY_AUTH].started++;
+    if (g_auth_deadline_us) {
+        g_auth_armed = 1;
+        counter_add(&g_deadlines_armed, 1);
+    }
+    sync_unlock(&g_auth_lock);
+    if (ogengine_sync_job_submit(auth_job, (void*)(uintptr_t)gen)) return handle;
+    /* No worker: report failure through the normal result path so the game is not left waiting. */
+    sync_lock(&g_auth_lock);
+    if (gen == g_auth_gen) {
+        g_auth_in_progress = 0;
+        auth_disarm_locked();
+        g_auth_has_result = 1;
+        g_auth_success = 0;
+        str_copy(g_auth_error_msg, "STAR sync worker pool not running (call ogengine_sync_init)", sizeof(g_auth_error_msg));
+    }
+    sync_unlock(&g_auth_lock);
+    auth_signal_done();
+    return handle;
+}
+
+/* Cancel the auth behind handle: a running job is detached and an undelivered result dropped. */
+static int auth_cancel(ogengine_sync_op_t handle) {
+    int was_running = 0, cancelled = 0;
+    sync_lock(&g_auth_lock);
+    if (handle == g_auth_handle && (g_auth_in_progress || g_auth_has_result)) {
+        was_running = g_auth_in_progress;
+        auth_withdraw_locked();
+        g_auth_has_result = 0;
+        g_auth_on_done = NULL;
+        g_auth_on_done_user = NULL;
+        g_stats[OP_FAMILY_AUTH].cancelled++;
+        cancelled = 1;
+    }
+    sync_unlock(&g_auth_lock);
+    if (was_running) sync_abort_notify(handle);
+    return cancelled;
+}
+
+/* Pump: fail an auth whose deadline passed. The job is detached; the failure is delivered like a result. */
+static void auth_expire(int64_t now) {
+    ogengine_sync_op_t handle = 0;
+    sync_lock(&g_auth_lock);
+    if (g_auth_in_progress && g_auth_armed && now >= g_auth_deadline_us) {
+        handle = g_auth_handle;
+        auth_withdraw_locked();
+        g_auth_has_result = 1;
+        g_auth_success = 0;
+        str_copy(g_auth_username_out, g_auth_username_buf, sizeof(g_auth_username_out));
+        g_auth_avatar_id_out[0] = '\0';
+        g_auth_jwt_out[0] = '\0';
+        str_copy(g_auth_error_msg, SYNC_ERR_TIMED_OUT, sizeof(g_auth_error_msg));
+        g_stats[OP_FAMILY_AUTH].timed_out++;
+    }
+    sync_unlock(&g_auth_lock);
+    if (!handle) return;
+    sync_abort_notify(handle);
+    auth_signal_done();
+}
+
+static void auth_deliver(sync_done_t* done) {
+    ogengine_sync_auth_on_done_fn auth_fn = NULL;
+    void* auth_ud = NULL;
+    int64_t t_enqueue = 0, t_start = 0, t_done = 0;
+    (void)done;
+    /* Cleared first: a job finishing during the callback queues the node again. */
+    flag_exchange(&g_auth_done_queued, 0);
+    sync_lock(&g_auth_lock);
+    if (g_auth_has_result && g_auth_on_done) {
+        auth_fn = g_auth_on_done;
+        auth_ud = g_auth_on_done_user;
+        g_auth_on_done = NULL;
+        g_auth_on_done_user = NULL;
+    }
+    if (g_auth_has_result && g_auth_t_enqueue) {
+        t_enqueue = g_auth_t_enqueue;
+        t_start = g_auth_t_start;
+        t_done = g_auth_t_done;
+        g_auth_t_enqueue = 0;
+    }
+    sync_unlock(&g_auth_lock);
+    if (t_enqueue)
+        stats_record(OP_FAMILY_AUTH, t_enqueue, t_start, t_done, sync_now_us());
+    if (auth_fn) {
+        SYNC_TRACE("sync.auth on_done", 'B');
+        auth_fn(auth_ud);
+        SYNC_TRACE("sync.auth on_done", 'E');
+    }
+}
+
+int ogengine_sync_auth_poll(void) {
+#ifdef _WIN32
+    EnterCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_lock(&g_auth_lock);
+#endif
+    if (g_auth_in_progress) {
+#ifdef _WIN32
+        LeaveCriticalSection(&g_auth_lock);
+#else
+        pthread_mutex_unlock(&g_auth_lock);
+#endif
+        return 0;
+    }
+    if (g_auth_has_result) {
+#ifdef _WIN32
+        LeaveCriticalSection(&g_auth_lock);
+#else
+        pthread_mutex_unlock(&g_auth_lock);
+#endif
+        return 1;
+    }
+#ifdef _WIN32
+    LeaveCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_unlock(&g_auth_lock);
+#endif
+    return -1;
+}
+
+int ogengine_sync_auth_get_result(int* success_out,
+    char* username_buf, size_t username_size,
+    char* avatar_id_buf, size_t avatar_id_size,
+    char* error_msg_buf, size_t error_msg_size) {
+#ifdef _WIN32
+    EnterCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_lock(&g_auth_lock);
+#endif
+    if (!g_auth_has_result) {
+#ifdef _WIN32
+        LeaveCriticalSection(&g_auth_lock);
+#else
+        pthread_mutex_unlock(&g_auth_lock);
+#endif
+        return 0;
+    }
+    if (success_out) *success_out = g_auth_success;
+    if (username_buf && username_size) str_copy(username_buf, g_auth_username_out, username_size);
+    if (avatar_id_buf && avatar_id_size) str_copy(avatar_id_buf, g_auth_avatar_id_out, avatar_id_size);
+    if (error_msg_buf && error_msg_size) str_copy(error_msg_buf, g_auth_error_msg, error_msg_size);
+    g_auth_has_result = 0;
+#ifdef _WIN32
+    LeaveCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_unlock(&g_auth_lock);
+#endif
+    return 1;
+}
+
+void ogengine_sync_auth_get_result_jwt(char* jwt_buf, size_t jwt_size) {
+    if (!jwt_buf || !jwt_size) return;
+#ifdef _WIN32
+    EnterCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_lock(&g_auth_lock);
+#endif
+    str_copy(jwt_buf, g_auth_jwt_out, jwt_size);
+#ifdef _WIN32
+    LeaveCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_unlock(&g_auth_lock);
+#endif
+}
+
+int ogengine_sync_auth_in_progress(void) {
+#ifdef _WIN32
+    EnterCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_lock(&g_auth_lock);
+#endif
+    int in_progress = g_auth_in_progress;
+#ifdef _WIN32
+    LeaveCriticalSection(&g_auth_lock);
+#else
+    pthread_mutex_unlock(&g_auth_lock);
+#endif
+    return in_progress;
+}
+
+void ogengine_sync_auth_force_reset(void) {
+    ogengine_sync_op_t handle;
+    int was_running;
+    sync_lock(&g_auth_lock);
+    handle = g_auth_handle;
+    was_running = g_auth_in_progress;
+    if (was_running || g_auth_has_result) g_stats[OP_FAMILY_AUTH].cancelled++;
+    auth_withdraw_locked();
+    g_auth_has_result = 0;
+    g_auth_on_done = NULL;
+    g_auth_on_done_user = NULL;
+    sync_unlock(&g_auth_lock);
+    if (was_running) sync_abort_notify(handle);
+}
+
+/* ---------------------------------------------------------------------------
+ * Operation queues (inventory, send_item, use_item)
+ *
+ * Each family keeps a bounded ring of operation objects, each with its own
+ * arguments, on_done/user_data and result. start() appends at tail and up to
+ * max_running ops of the family are handed to the worker pool at a time. A
+ * finished op goes onto the completion queue; the pump publishes its result as
+ * the family's current result, then runs its on_done, so *_get_result() inside
+ * the callback reads that op. The slot is freed only after delivery, so it
+ * stays valid while its callback runs.
+ *
+ * A cancelled op never calls back. Queued, it is skipped at dispatch; running,
+ * it keeps its place against max_running until the worker returns (run() may
+ * still be inside the client, e.g. a use's queue + flush or an inventory
+ * refresh writing the local items' synced flags), then its slot and result are
+ * released and the next op starts; finished, the pump drops it. An op past its deadline is cancelled the same way and its on_done
+ * runs with a timed-out failure published as the family's current result.
+ * --------------------------------------------------------------------------- */
+#define QUEUE_MAX_RUNNING 4
+#define QUEUE_ERR_NO_POOL "STAR sync worker pool not running (call ogengine_sync_init)"
+#define QUEUE_ERR_FULL "STAR sync queue full; operation not started"
+#define QUEUE_EXPIRE_MAX 32  /* timeouts handled per queue per pump */
+
+/* OP_ABANDONED: cancelled while running; still counted in running, slot freed when its worker returns. */
+enum { OP_FREE = 0, OP_QUEUED, OP_RUNNING, OP_DONE, OP_ABANDONED };
+
+typedef struct sync_queue_s sync_queue_t;
+
+/* First member of every family op struct. */
+typedef struct {
+    sync_done_t done;       /* completion queue link; first so a sync_done_t* is the op */
+    int state;
+    sync_queue_t* queue;
+    void (*on_done)(void* user_data);
+    void* user_data;
+    ogengine_sync_op_t handle;
+    int64_t deadline_us;    /* 0 = none; fixed once queued */
+    int armed;              /* counted in g_deadlines_armed (under the queue lock) */
+    volatile long cancelled;
+    int64_t t_enqueue, t_start, t_done;  /* stats; start/done written by the worker */
+} sync_op_t;
+
+struct sync_queue_s {
+    sync_lock_t* lock;
+    unsigned char* ops;     /* family op array, op_size stride */
+    size_t op_size;
+    unsigned cap;           /* power of two */
+    int max_running;        /* <= QUEUE_MAX_RUNNING */
+    void (*run)(sync_op_t* op);                     /* worker thread, no lock held */
+    void (*fail)(sync_op_t* op, const char* err);   /* set a failure result */
+    void (*deliver)(sync_op_t* op);                 /* main thread: publish result, run on_done */
+    void (*release)(sync_op_t* op);                 /* optional: free an undelivered result */
+    void (*publish_error)(const char* err);         /* main thread: make a failure the current result */
+    int family;             /* OP_FAMILY_* */
+    unsigned gen;           /* last handle generation */
+    unsigned head;          /* oldest slot not yet delivered and freed */
+    unsigned next;          /* oldest op not yet handed to a worker */
+    unsigned tail;          /* next free slot */
+    int running;
+    int pending;            /* queued + running */
+    int peak;               /* highest pending since the stats were reset */
+};
+
+#define QUEUE_OP(q, i) ((sync_op_t*)((q)->ops + (size_t)((i) & ((q)->cap - 1)) * (q)->op_size))
+
+static void queue_job(void* arg);
+
+/* Caller holds q->lock. */
+static void queue_disarm_locked(sync_op_t* op) {
+    if (op->armed) {
+        op->armed = 0;
+        counter_add(&g_deadlines_armed, -1);
+    }
+}
+
+/* Caller holds q->lock. Slots are freed out of order; head only moves past a contiguous run of
+ * free slots, so tail never overwrites a live op. */
+static void queue_free_locked(sync_queue_t* q, sync_op_t* op) {
+    queue_disarm_locked(op);
+    op->state = OP_FREE;
+    while (q->head != q->next && QUEUE_OP(q, q->head)->state == OP_FREE)
+        q->head++;
+}
+
+/* Caller holds q->lock. Marks queued ops running up to max_running; they are submitted after unlocking.
+ * Cancelled ops met on the way are freed without running. */
+static int queue_take_runnable(sync_queue_t* q, sync_op_t** out) {
+    int n = 0;
+    while (q->running < q->max_running && q->next != q->tail) {
+        sync_op_t* op = QUEUE_OP(q, q->next++);
+        if (flag_load(&op->cancelled)) {
+            queue_free_locked(q, op);
+            continue;
+        }
+        op->state = OP_RUNNING;
+        q->running++;
+        out[n++] = op;
+    }
+    return n;
+}
+
+static void queue_finish(sync_op_t* op);
+
+static void queue_submit(sync_op_t** ops, int n) {
+    int i;
+    for (i = 0; i < n; i++) {
+        if (!ogengine_sync_job_submit(queue_job, ops[i])) {
+            ops[i]->queue->fail(ops[i], QUEUE_ERR_NO_POOL);
+            queue_finish(ops[i]);
+        }
+    }
+}
+
+/* Mark op done, hand it to the completion queue and start whatever it was holding back.
+ * An op abandoned while running is not delivered: its result is released and its slot freed. */
+static void queue_finish(sync_op_t* op) {
+    sync_queue_t* q = op->queue;
+    sync_op_t* start[QUEUE_MAX_RUNNING];
+    int n, abandoned;
+    sync_lock(q->lock);
+    abandoned = op->state == OP_ABANDONED;
+    q->running--;
+    if (abandoned) {
+        if (q->release) q->release(op);
+        queue_free_locked(q, op);
+    } else {
+        op->state = OP_DONE;
+        q->pending--;
+    }
+    n = queue_take_runnable(q, start);
+    sync_unlock(q->lock);
+    if (!abandoned) done_push(&op->done);
+    queue_submit(start, n);
+}
+
+/* Main thread, from the pump: run the op's delivery (unless cancelled after it finished), then free its slot. */
+static void queue_deliver_done(sync_done_t* done) {
+    sync_op_t* op = (sync_op_t*)done;
+    sync_queue_t* q = op->queue;
+    if (!flag_load(&op->cancelled)) {
+        stats_record(q->family, op->t_enqueue, op->t_start, op->t_done, sync_now_us());
+        q->deliver(op);
+    }
+    else if (q->release)
+        q->release(op);
+    sync_lock(q->lock);
+    queue_free_locked(q, op);
+    sync_unlock(q->lock);
+}
+
+static void queue_job(void* arg) {
+    sync_op_t* op = (sync_op_t*)arg;
+    if (!flag_load(&op->cancelled)) {
+        sync_set_current(op->handle, op->deadline_us, &op->cancelled);
+        op->t_start = sync_now_us();
+        op->queue->run(op);
+        op->t_done = sync_now_us();
+        sync_set_current(0, 0, NULL);
+    }
+    queue_finish(op);
+}
+
+/* Append a copy of op and return its handle. If the ring is full the op fails at once, is delivered on the
+ * calling thread and 0 is returned. */
+static ogengine_sync_op_t queue_push(sync_queue_t* q, sync_op_t* op, int timeout_ms) {
+    sync_op_t* start[QUEUE_MAX_RUNNING];
+    sync_op_t* slot;
+    ogengine_sync_op_t handle;
+    int64_t now = sync_now_us();
+    int n;
+    op->queue = q;
+    sync_lock(q->lock);
+    if (q->tail - q->head >= q->cap) {
+        sync_unlock(q->lock);
+        q->fail(op, QUEUE_ERR_FULL);
+        op->state = OP_DONE;
+        q->deliver(op);
+        return 0;
+    }
+    slot = QUEUE_OP(q, q->tail);
+    memcpy(slot, op, q->op_size);
+    slot->done.next = NULL;
+    slot->done.deliver = queue_deliver_done;
+    slot->state = OP_QUEUED;
+    q->gen = op_next_gen(q->gen);
+    slot->handle = handle = OP_HANDLE(q->family, q->gen, q->tail & (q->cap - 1));
+    slot->deadline_us = op_deadline(now, timeout_ms);
+    slot->armed = slot->deadline_us != 0;
+    slot->cancelled = 0;
+    slot->t_enqueue = now;
+    slot->t_start = slot->t_done = 0;
+    if (slot->armed) counter_add(&g_deadlines_armed, 1);
+    q->tail++;
+    q->pending++;
+    if (q->pending > q->peak) q->peak = q->pending;
+    g_stats[q->family].started++;
+    n = queue_take_runnable(q, start);
+    sync_unlock(q->lock);
+    queue_submit(start, n);
+    return handle;
+}
+
+static int queue_pending(sync_queue_t* q) {
+    int pending;
+    sync_lock(q->lock);
+    pending = q->pending;
+    sync_unlock(q->lock);
+    return pending;
+}
+
+/* Caller holds q->lock. Cancel a queued or running op; returns 1 if it was running. A running op keeps
+ * counting in q->running until its worker returns (queue_finish), so the next op never overlaps it. */
+static int queue_cancel_locked(sync_queue_t* q, sync_op_t* op) {
+    flag_exchange(&op->cancelled, 1);
+    queue_disarm_locked(op);
+    q->pending--;
+    if (op->state != OP_RUNNING) return 0;
+    op->state = OP_ABANDONED;
+    return 1;
+}
+
+static int queue_cancel(sync_queue_t* q, ogengine_sync_op_t handle) {
+    sync_op_t* start[QUEUE_MAX_RUNNING];
+    sync_op_t* op;
+    int n = 0, was_running = 0, cancelled = 0;
+    if (OP_HANDLE_SLOT(handle) >= q->cap) return 0;
+    op = QUEUE_OP(q, OP_HANDLE_SLOT(handle));
+    sync_lock(q->lock);
+    if (op->handle == handle && !flag_load(&op->cancelled)) {
+        if (op->state == OP_QUEUED || op->state == OP_RUNNING) {
+            was_running = queue_cancel_locked(q, op);
+            n = queue_take_runnable(q, start);
+            g_stats[q->family].cancelled++;
+            cancelled = 1;
+        } else if (op->state == OP_DONE) {
+            flag_exchange(&op->cancelled, 1);  /* on the completion queue; the pump drops it */
+            g_stats[q->family].cancelled++;
+            queue_disarm_locked(op);
+            cancelled = 1;
+        }
+    }
+    sync_unlock(q->lock);
+    if (was_running) sync_abort_notify(handle);
+    queue_submit(start, n);
+    return cancelled;
+}
+
+typedef struct {
+    void (*on_done)(void* user_data);
+    void* user_data;
+    ogengine_sync_op_t handle;
+    int was_running;
+} sync_expired_t;
+
+/* Main thread: set while queue_expire runs the on_done of an op whose request had already gone out, so the
+ * outcome is unknown rather than failed (the optimistic use ledger keeps the effect). */
+static int g_expired_after_send = 0;
+
+/* Pump: cancel ops whose deadline passed and run their on_done with a timed-out failure. on_done/user_data
+ * are copied under the lock; a running op's own result fields still belong to its worker. */
+static void queue_expire(sync_queue_t* q, int64_t now) {
+    sync_op_t* start[QUEUE_MAX_RUNNING];
+    sync_expired_t expired[QUEUE_EXPIRE_MAX];
+    unsigned i;
+    int n, m = 0, k;
+    sync_lock(q->lock);
+    for (i = q->head; i != q->tail && m < QUEUE_EXPIRE_MAX; i++) {
+        sync_op_t* op = QUEUE_OP(q, i);
+        if (!op->armed || now < op->deadline_us) continue;
+        if (op->state != OP_QUEUED && op->state != OP_RUNNING) continue;
+        if (flag_load(&op->cancelled)) continue;
+        expired[m].on_done = op->on_done;
+        expired[m].user_data = op->user_data;
+        expired[m].handle = op->handle;
+        expired[m].was_running = queue_cancel_locked(q, op);
+        g_stats[q->family].timed_out++;
+        m++;
+    }
+    n = m ? queue_take_runnable(q, start) : 0;
+    sync_unlock(q->lock);
+    queue_submit(start, n);
+    for (k = 0; k < m; k++) {
+        if (expired[k].was_running) sync_abort_notify(expired[k].handle);
+        q->publish_error(SYNC_ERR_TIMED_OUT);
+        if (expired[k].on_done) {
+            SYNC_TRACE("sync timed out on_done", 'B');
+            g_expired_after_send = expired[k].was_running;
+            expired[k].on_done(expired[k].user_data);
+            g_expired_after_send = 0;
+            SYNC_TRACE("sync timed out on_done", 'E');
+        }
+    }
+}
+
+/* Drop every op; only valid once no worker can touch the ring (pool stopped). Queued ops never get on_done. */
+static void queue_reset(sync_queue_t* q) {
+    unsigned i;
+    sync_lock(q->lock);
+    for (i = q->head; i != q->tail; i++) {
+        sync_op_t* op = QUEUE_OP(q, i);
+        if (op->state == OP_DONE && q->release) q->release(op);
+        op->state = OP_FREE;
+        op->armed = 0;
+    }
+    q->head = q->next = q->tail = 0;
+    q->running = q->pending = 0;
+    sync_unlock(q->lock);
+}
+
+/* ---------------------------------------------------------------------------
+ * Inventory state
+ * --------------------------------------------------------------------------- */
+#define INV_ERROR_SIZE 256
+#define INV_QUEUE_SIZE 8
+
+/* Optional add_item log callback: set by ogengine_sync_set_add_item_log_cb; invoked from main thread. */
+static ogengine_sync_add_item_log_fn g_add_item_log_cb = NULL;
+static void* g_add_item_log_user = NULL;
+#define ADD_ITEM_LOG_NAMES_MAX 32
+#define ADD_ITEM_LOG_NAME_SIZE 128
+
+typedef struct {
+    sync_op_t base;
+    ogengine_sync_local_item_t* local_items;
+    int local_count;
+    char default_src[64];
+    ogengine_item_list_t* list;
+    ogengine_result_t result;
+    char error_msg[INV_ERROR_SIZE];
+    char add_item_error[INV_ERROR_SIZE]; /* first add_item failure reason (e.g. "Avatar ID is not set...") */
+    int logged_count;
+    char logged_names[ADD_ITEM_LOG_NAMES_MAX][ADD_ITEM_LOG_NAME_SIZE];
+} inv_op_t;
+
+/* Current (last delivered) result, read by ogengine_sync_inventory_get_result. */
+static int g_inv_has_result = 0;
+static ogengine_item_list_t* g_inv_list = NULL;
+static ogengine_result_t g_inv_result = OGENGINE_ERROR_NOT_INITIALIZED;
+static char g_inv_error_msg[INV_ERROR_SIZE] = {0};
+
+#ifdef _WIN32
+static CRITICAL_SECTION g_inv_lock;
+#else
+static pthread_mutex_t g_inv_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void inventory_run(sync_op_t* op);
+static void inventory_fail(sync_op_t* op, const char* err);
+static void inventory_deliver(sync_op_t* op);
+static void inventory_release(sync_op_t* op);
+static void inventory_publish_error(const char* err);
+static inv_op_t g_inv_ops[INV_QUEUE_SIZE];
+/* One refresh at a time: ops share the game's local item array and its synced flags. */
+static sync_queue_t g_inv_queue = {
+    &g_inv_lock, (unsigned char*)g_inv_ops, sizeof(inv_op_t), INV_QUEUE_SIZE, 1,
+    inventory_run, inventory_fail, inventory_deliver, inventory_release, inventory_publish_error,
+    OP_FAMILY_INVENTORY, 0, 0, 0, 0, 0, 0, 0
+};
+
+static int g_sync_initialized = 0;
+static int g_sync_draining = 0;  /* cleanup left workers inside a job; locks stay initialized until they exit */
+
+/* ---------------------------------------------------------------------------
+ * Send item state
+ * --------------------------------------------------------------------------- */
+#define SEND_TARGET_SIZE 256
+#define SEND_ITEM_NAME_SIZE 256
+#define SEND_ITEM_ID_SIZE 64
+#define SEND_ERROR_SIZE 384
+#define SEND_QUEUE_SIZE 16
+
+typedef struct {
+    sync_op_t base;
+    char target[SEND_TARGET_SIZE];
+    char item_name[SEND_ITEM_NAME_SIZE];
+    char item_id[SEND_ITEM_ID_SIZE];
+    int quantity;
+    int to_clan;
+    int success;
+    char error_msg[SEND_ERROR_SIZE];
+} send_op_t;
+
+#ifdef _WIN32
+static CRITICAL_SECTION g_send_lock;
+#else
+static pthread_mutex_t g_send_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+static int g_send_has_result = 0;
+static int g_send_success = 0;
+static char g_send_error_msg[SEND_ERROR_SIZE] = {0};
+
+static void send_item_run(sync_op_t* op);
+static void send_item_fail(sync_op_t* op, const char* err);
+static void send_item_deliver(sync_op_t* op);
+static void send_item_publish_error(const char* err);
+static send_op_t g_send_ops[SEND_QUEUE_SIZE];
+/* Sends are independent requests, so several run at once. */
+static sync_queue_t g_send_queue = {
+    &g_send_lock, (unsigned char*)g_send_ops, sizeof(send_op_t), SEND_QUEUE_SIZE, QUEUE_MAX_RUNNING,
+    send_item_run, send_item_fail, send_item_deliver, NULL, send_item_publish_error,
+    OP_FAMILY_SEND, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* ---------------------------------------------------------------------------
+ * Use item state
+ * --------------------------------------------------------------------------- */
+#define USE_ITEM_NAME_SIZE 256
+#define USE_CONTEXT_SIZE 128
+#define USE_ERROR_SIZE 384
+#define USE_QUEUE_SIZE 32
+
+typedef struct {
+    sync_op_t base;
+    char item_name[USE_ITEM_NAME_SIZE];
+    char context[USE_CONTEXT_SIZE];
+    int success;
+    char error_msg[USE_ERROR_SIZE];
+} use_op_t;
+
+#ifdef _WIN32
+static CRITICAL_SECTION g_use_lock;
+#else
+static pthread_mutex_t g_use_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+static int g_use_has_result = 0;
+static int g_use_success = 0;
+static char g_use_error_msg[USE_ERROR_SIZE] = {0};
+
+static void use_item_run(sync_op_t* op);
+static void use_item_fail(sync_op_t* op, const char* err);
+static void use_item_deliver(sync_op_t* op);
+static void use_item_publish_error(const char* err);
+static use_op_t g_use_ops[USE_QUEUE_SIZE];
+/* One at a time: queue_use_item + flush_use_item_jobs share the client's job queue, so a concurrent
+ * flush could report another op's outcome. Queued uses are still never dropped. */
+static sync_queue_t g_use_queue = {
+    &g_use_lock, (unsigned char*)g_use_ops, sizeof(use_op_t), USE_QUEUE_SIZE, 1,
+    use_item_run, use_item_fail, use_item_deliver, NULL, use_item_publish_error,
+    OP_FAMILY_USE, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* Optimistic uses awaiting the server (main thread only; see the optimistic use section). */
+typedef struct {
+    int used;
+    ogengine_sync_op_t handle;
+    const ogengine_sync_use_effect_t* effect;
+    void* user_data;
+    char item_name[USE_ITEM_NAME_SIZE];
+} optimistic_use_t;
+
+static optimistic_use_t g_optimistic[OGENGINE_SYNC_MAX_PENDING_USES];
+
+static void use_item_run(sync_op_t* base) {
+    use_op_t* op = (use_op_t*)base;
+    const char* err = NULL;
+    SYNC_TRACE("sync.use_item", 'B');
+    ogengine_queue_use_item(op->item_name, op->context[0] ? op->context : "unknown");
+    op->success = (ogengine_flush_use_item_jobs() == OGENGINE_SUCCESS) ? 1 : 0;
+    if (!op->success)
+        err = ogengine_get_last_error();
+    str_copy(op->error_msg, err ? err : "", sizeof(op->error_msg));
+    SYNC_TRACE("sync.use_item", 'E');
+}
+
+static void use_item_fail(sync_op_t* base, const char* err) {
+    use_op_t* op = (use_op_t*)base;
+    op->success = 0;
+    str_copy(op->error_msg, err, sizeof(op->error_msg));
+}
+
+static void use_item_set_result(int success, const char* error_msg) {
+    sync_lock(&g_use_lock);
+    g_use_has_result = 1;
+    g_use_success = success;
+    str_copy(g_use_error_msg, error_msg, sizeof(g_use_error_msg));
+    sync_unlock(&g_use_lock);
+}
+
+static void use_item_publish_error(const char* err) {
+    use_item_set_result(0, err);
+}
+
+static void use_item_deliver(sync_op_t* base) {
+    use_op_t* op = (use_op_t*)base;
+    use_item_set_result(op->success, op->error_msg);
+    if (base->on_done) {
+        SYNC_TRACE("sync.use_item on_done", 'B');
+        base->on_done(base->user_data);
+        SYNC_TRACE("sync.use_item on_done", 'E');
+    }
+}
+
+void ogengine_sync_use_item_start(const char* item_name, const char* context, ogengine_sync_use_item_on_done_fn on_done, void* user_data) {
+    (void)ogengine_sync_use_item_start_op(item_name, context, 0, on_done, user_data);
+}
+
+ogengine_sync_op_t ogengine_sync_use_item_start_op(const char* item_name, const char* context, int timeout_ms,
+    ogengine_sync_use_item_on_done_fn on_done, void* user_data) {
+    use_op_t op;
+    memset(&op, 0, sizeof(op));
+    str_copy(op.item_name, item_name ? item_name : "", sizeof(op.item_name));
+    str_copy(op.context, context ? context : "", sizeof(op.context));
+    op.base.on_done = on_done;
+    op.base.user_data = user_data;
+    return queue_push(&g_use_queue, &op.base, timeout_ms);
+}
+
+int ogengine_sync_use_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size) {
+    sync_lock(&g_use_lock);
+    if (!g_use_has_result) {
+        sync_unlock(&g_use_lock);
+        return 0;
+    }
+    if (success_out) *success_out = g_use_success;
+    if (error_msg_buf && error_msg_size) str_copy(error_msg_buf, g_use_error_msg, error_msg_size);
+    g_use_has_result = 0;
+    sync_unlock(&g_use_lock);
+    return 1;
+}
+
+int ogengine_sync_use_item_in_progress(void) {
+    return queue_pending(&g_use_queue);
+}
+
+static void send_item_run(sync_op_t* base) {
+    send_op_t* op = (send_op_t*)base;
+    ogengine_result_t res;
+    const char* err = NULL;
+    SYNC_TRACE("sync.send_item", 'B');
+    if (op->to_clan)
+        res = ogengine_send_item_to_clan(op->target, op->item_name, op->quantity, op->item_id[0] ? op->item_id : NULL);
+    else
+        res = ogengine_send_item_to_avatar(op->target, op->item_name, op->quantity, op->item_id[0] ? op->item_id : NULL);
+    op->success = (res == OGENGINE_SUCCESS) ? 1 : 0;
+    if (!op->success)
+        err = ogengine_get_last_error();
+    str_copy(op->error_msg, err ? err : "", sizeof(op->error_msg));
+    SYNC_TRACE("sync.send_item", 'E');
+}
+
+static void send_item_fail(sync_op_t* base, const char* err) {
+    send_op_t* op = (send_op_t*)base;
+    op->success = 0;
+    str_copy(op->error_msg, err, sizeof(op->error_msg));
+}
+
+static void send_item_set_result(int success, const char* error_msg) {
+    sync_lock(&g_send_lock);
+    g_send_has_result = 1;
+    g_send_success = success;
+    str_copy(g_send_error_msg, error_msg, sizeof(g_send_error_msg));
+    sync_unlock(&g_send_lock);
+}
+
+static void send_item_publish_error(const char* err) {
+    send_item_set_result(0, err);
+}
+
+static void send_item_deliver(sync_op_t* base) {
+    send_op_t* op = (send_op_t*)base;
+    send_item_set_result(op->success, op->error_msg);
+    if (base->on_done) {
+        SYNC_TRACE("sync.send_item on_done", 'B');
+        base->on_done(base->user_data);
+        SYNC_TRACE("sync.send_item on_done", 'E');
+    }
+}
+
+void ogengine_sync_send_item_start(const char* target, const char* item_name, int quantity, int to_clan, const char* item_id, ogengine_sync_send_item_on_done_fn on_done, void* user_data) {
+    (void)ogengine_sync_send_item_start_op(target, item_name, quantity, to_clan, item_id, 0, on_done, user_data);
+}
+
+ogengine_sync_op_t ogengine_sync_send_item_start_op(const char* target, const char* item_name, int quantity, int to_clan, const char* item_id,
+    int timeout_ms, ogengine_sync_send_item_on_done_fn on_done, void* user_data) {
+    send_op_t op;
+    memset(&op, 0, sizeof(op));
+    str_copy(op.target, target ? target : "", sizeof(op.target));
+    str_copy(op.item_name, item_name ? item_name : "", sizeof(op.item_name));
+    str_copy(op.item_id, item_id && item_id[0] ? item_id : "", sizeof(op.item_id));
+    op.quantity = quantity < 1 ? 1 : quantity;
+    op.to_clan = to_clan ? 1 : 0;
+    op.base.on_done = on_done;
+    op.base.user_data = user_data;
+    return queue_push(&g_send_queue, &op.base, timeout_ms);
+}
+
+int ogengine_sync_send_item_poll(void) {
+    int state;
+    sync_lock(&g_send_lock);
+    state = g_send_queue.pending ? 0 : (g_send_has_result ? 1 : -1);
+    sync_unlock(&g_send_lock);
+    return state;
+}
+
+int ogengine_sync_send_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size) {
+    sync_lock(&g_send_lock);
+    if (!g_send_has_result) {
+        sync_unlock(&g_send_lock);
+        return 0;
+    }
+    if (success_out) *success_out = g_send_success;
+    if (error_msg_buf && error_msg_size) str_copy(error_msg_buf, g_send_error_msg, error_msg_size);
+    g_send_has_result = 0;
+    sync_unlock(&g_send_lock);
+    return 1;
+}
+
+int ogengine_sync_send_item_in_progress(void) {
+    return queue_pending(&g_send_queue);
+}
+
+static void sync_reset_state(void) {
+    done_exchange(NULL);  /* undelivered completions; the rings below own their slots */
+    g_backlog_head = g_backlog_tail = NULL;
+    g_backlog_count = 0;
+    g_auth_done_queued = 0;
+    g_auth_armed = 0;
+    g_deadlines_armed = 0;
+    queue_reset(&g_use_queue);
+    queue_reset(&g_send_queue);
+    queue_reset(&g_inv_queue);
+}
+
+static void sync_delete_locks(void) {
+#ifdef _WIN32
+    DeleteCriticalSection(&g_use_lock);
+    DeleteCriticalSection(&g_send_lock);
+    DeleteCriticalSection(&g_inv_lock);
+    DeleteCriticalSection(&g_auth_lock);
+#endif
+}
+
+void ogengine_sync_init(void) {
+    if (g_sync_initialized) return;
+    if (g_sync_draining) {
+        /* A worker from the last session may still hold these locks; do not re-initialize them under it. */
+        if (!pool_drained()) return;
+        sync_reset_state();
+        sync_delete_locks();
+        g_sync_draining = 0;
+    }
+#ifdef _WIN32
+    InitializeCriticalSection(&g_auth_lock);
+    InitializeCriticalSection(&g_inv_lock);
+    InitializeCriticalSection(&g_send_lock);
+    InitializeCriticalSection(&g_use_lock);
+#endif
+    pool_start();
+    g_sync_initialized = 1;
+}
+
+void ogengine_sync_cleanup(void) {
+    int pool_idle;
+    if (!g_sync_initialized) return;
+    pool_idle = pool_stop();
+    /* A job still inside an HTTP call after the grace period will take its family lock and slot when it returns;
+     * the reset and the lock teardown then wait for the next ogengine_sync_init to find the pool drained. */
+    if (pool_idle)
+        sync_reset_state();
+    else
+        g_sync_draining = 1;
+    memset(g_optimistic, 0, sizeof(g_optimistic));  /* never settled: no commit or rollback */
+    ogengine_sync_inventory_clear_result();
+    if (pool_idle)
+        sync_delete_locks();
+    g_sync_initialized = 0;
+}
+
+static void optimistic_cancelled(ogengine_sync_op_t op);
+
+void ogengine_sync_set_add_item_log_cb(ogengine_sync_add_item_log_fn cb, void* user_data) {
+    g_add_item_log_cb = cb;
+    g_add_item_log_user = user_data;
+}
+
+int ogengine_sync_cancel(ogengine_sync_op_t op) {
+    switch (OP_HANDLE_FAMILY(op)) {
+    case OP_FAMILY_AUTH:      return auth_cancel(op);
+    case OP_FAMILY_INVENTORY: return queue_cancel(&g_inv_queue, op);
+    case OP_FAMILY_SEND:      return queue_cancel(&g_send_queue, op);
+    case OP_FAMILY_USE:
+        if (!queue_cancel(&g_use_queue, op)) return 0;
+        optimistic_cancelled(op);
+        return 1;
+    default:                  return 0;
+    }
+}
+
+/** Run pending completion callbacks on the main thread. Call once per frame. */
+void ogengine_sync_pump(void) {
+    ogengine_sync_pump_budget(0);
+}
+
+int ogengine_sync_pump_budget(int budget_us) {
+    int64_t deadline = 0;
+    int delivered = 0;
+    int armed = flag_load(&g_deadlines_armed) > 0;
+    if (!g_backlog_head && !done_load_relaxed() && !armed) return 0;
+    SYNC_TRACE("ogengine_sync_pump", 'B');
+    if (armed) {
+        int64_t now = sync_now_us();
+        auth_expire(now);
+        queue_expire(&g_inv_queue, now);
+        queue_expire(&g_send_queue, now);
+        queue_expire(&g_use_queue, now);
+    }
+    if (budget_us > 0) deadline = sync_now_us() + budget_us;
+    done_take_all();
+    while (g_backlog_head) {
+        sync_done_t* d = g_backlog_head;
+        /* At least one per call so a slow callback cannot stall the backlog forever. */
+        if (deadline && delivered && sync_now_us() >= deadline) break;
+        g_backlog_head = d->next;  /* unlinked first: delivery may free and reuse the node */
+        if (!g_backlog_head) g_backlog_tail = NULL;
+        g_backlog_count--;
+        d->deliver(d);
+        delivered++;
+    }
+    SYNC_TRACE("ogengine_sync_pump", 'E');
+    return g_backlog_count + (done_load_relaxed() ? 1 : 0);
+}
+
+static void stats_family(int family, ogengine_sync_family_stats_t* out) {
+    sync_stats_t* st = &g_stats[family];
+    ogengine_sync_histogram_t* phase[SYNC_PHASES];
+    sync_queue_t* q = family == OP_FAMILY_INVENTORY ? &g_inv_queue
+                    : family == OP_FAMILY_SEND ? &g_send_queue
+                    : family == OP_FAMILY_USE ? &g_use_queue : NULL;
+    int i;
+    phase[SYNC_PHASE_QUEUE] = &out->queue_wait;
+    phase[SYNC_PHASE_NETWORK] = &out->network;
+    phase[SYNC_PHASE_DELIVERY] = &out->delivery;
+    phase[SYNC_PHASE_TOTAL] = &out->total;
+    for (i = 0; i < SYNC_PHASES; i++) {
+        hist_merge(phase[i], &st->prev[i]);
+        hist_merge(phase[i], &st->cur[i]);
+    }
+    out->delivered = st->delivered;
+    sync_lock(q ? q->lock : &g_auth_lock);
+    out->started = st->started;
+    out->cancelled = st->cancelled;
+    out->timed_out = st->timed_out;
+    out->pending = q ? q->pending : g_auth_in_progress;
+    out->peak_pending = q ? q->peak : (st->started ? 1 : 0);  /* one auth at a time */
+    sync_unlock(q ? q->lock : &g_auth_lock);
+}
+
+void ogengine_sync_get_stats(ogengine_sync_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    stats_roll(sync_now_us());
+    out->window_ms = SYNC_STATS_WINDOW_US / 1000;
+    stats_family(OP_FAMILY_AUTH, &out->auth);
+    stats_family(OP_FAMILY_INVENTORY, &out->inventory);
+    stats_family(OP_FAMILY_SEND, &out->send_item);
+    stats_family(OP_FAMILY_USE, &out->use_item);
+    out->backlog = g_backlog_count + (done_load_relaxed() ? 1 : 0);
+}
+
+void ogengine_sync_reset_stats(void) {
+    sync_queue_t* queues[3];
+    int f, i;
+    queues[0] = &g_inv_queue;
+    queues[1] = &g_send_queue;
+    queues[2] = &g_use_queue;
+    for (f = 0; f < SYNC_STATS_FAMILIES; f++) {
+        memset(g_stats[f].cur, 0, sizeof(g_stats[f].cur));
+        memset(g_stats[f].prev, 0, sizeof(g_stats[f].prev));
+        g_stats[f].delivered = 0;
+    }
+    g_stats_window_start = 0;
+    sync_lock(&g_auth_lock);
+    g_stats[OP_FAMILY_AUTH].started = g_stats[OP_FAMILY_AUTH].cancelled = g_stats[OP_FAMILY_AUTH].timed_out = 0;
+    sync_unlock(&g_auth_lock);
+    for (i = 0; i < 3; i++) {
+        sync_stats_t* st = &g_stats[queues[i]->family];
+        sync_lock(queues[i]->lock);
+        st->started = st->cancelled = st->timed_out = 0;
+        queues[i]->peak = queues[i]->pending;
+        sync_unlock(queues[i]->lock);
+    }
+}
+
+/* Upper edge of the bucket holding the pct-th sample, capped at the largest sample seen. */
+static double hist_percentile_ms(const ogengine_sync_histogram_t* h, unsigned pct) {
+    uint32_t rank, seen = 0;
+    int b;
+    if (!h->count) return 0.0;
+    rank = (uint32_t)(((uint64_t)h->count * pct + 99) / 100);
+    for (b = 0; b < OGENGINE_SYNC_STATS_BUCKETS - 1; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            uint64_t edge = (uint64_t)OGENGINE_SYNC_STATS_BUCKET0_US << b;
+            return (edge < h->max_us ? (double)edge : (double)h->max_us) / 1000.0;
+        }
+    }
+    return h->max_us / 1000.0;
+}
+
+static int stats_append(char* buf, size_t size, size_t* len, const char* name, const ogengine_sync_family_stats_t* f) {
+    const ogengine_sync_histogram_t* phase[SYNC_PHASES];
+    static const char* const phase_names[SYNC_PHASES] = { "queue", "network", "deliver", "total" };
+    int i, n;
+    phase[SYNC_PHASE_QUEUE] = &f->queue_wait;
+    phase[SYNC_PHASE_NETWORK] = &f->network;
+    phase[SYNC_PHASE_DELIVERY] = &f->delivery;
+    phase[SYNC_PHASE_TOTAL] = &f->total;
+    n = snprintf(buf + *len, size - *len,
+        "%-9s started %u delivered %u cancelled %u timed out %u pending %d (peak %d)\n",
+        name, f->started, f->delivered, f->cancelled, f->timed_out, f->pending, f->peak_pending);
+    if (n < 0 || (size_t)n >= size - *len) return 0;
+    *len += (size_t)n;
+    for (i = 0; i < SYNC_PHASES; i++) {
+        if (!phase[i]->count) continue;
+        n = snprintf(buf + *len, size - *len, "  %-8s n=%-5u p50 %8.1f  p95 %8.1f  max %8.1f ms\n",
+            phase_names[i], phase[i]->count, hist_percentile_ms(phase[i], 50),
+            hist_percentile_ms(phase[i], 95), phase[i]->max_us / 1000.0);
+        if (n < 0 || (size_t)n >= size - *len) return 0;
+        *len += (size_t)n;
+    }
+    return 1;
+}
+
+int ogengine_sync_format_stats(char* buf, size_t size) {
+    ogengine_sync_stats_t st;
+    size_t len = 0;
+    int n;
+    if (!buf || !size) return 0;
+    buf[0] = '\0';
+    ogengine_sync_get_stats(&st);
+    n = snprintf(buf, size, "ogengine_sync: last %u-%u s, completion backlog %d\n",
+        st.window_ms / 1000, 2 * st.window_ms / 1000, st.backlog);
+    if (n < 0 || (size_t)n >= size) return (int)(size - 1);
+    len = (size_t)n;
+    if (stats_append(buf, size, &len, "auth", &st.auth) &&
+        stats_append(buf, size, &len, "inventory", &st.inventory) &&
+        stats_append(buf, size, &len, "send_item", &st.send_item))
+        stats_append(buf, size, &len, "use_item", &st.use_item);
+    buf[len < size ? len : size - 1] = '\0';
+    return (int)len;
+}
+
+/* Case-insensitive name set over a fetched inventory (has_item matches names the same way). */
+typedef struct {
+    const char** names;
+    unsigned mask;
+} name_set_t;
+
+static unsigned name_hash(const char* s) {
+    unsigned h = 2166136261u;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 'A' && c <= 'Z') c = (unsigned char)(c - 'A' + 'a');
+        h = (h ^ c) * 16777619u;
+    }
+    return h;
+}
+
+static int name_equal(const char* a, const char* b) {
+    for (; *a && *b; a++, b++) {
+        unsigned char ca = (unsigned char)*a, cb = (unsigned char)*b;
+        if (ca >= 'A' && ca <= 'Z') ca = (unsigned char)(ca - 'A' + 'a');
+        if (cb >= 'A' && cb <= 'Z') cb = (unsigned char)(cb - 'A' + 'a');
+        if (ca != cb) return 0;
+    }
+    return *a == *b;
+}
+
+/* Returns 0 if allocation failed. Capacity covers the list plus `extra` later inserts at <= 50% load. */
+static int name_set_init(name_set_t* set, const ogengine_item_list_t* list, size_t extra) {
+    size_t want = ((list ? list->count : 0) + extra) * 2, i;
+    unsigned cap = 16;
+    while (cap < want) cap <<= 1;
+    set->names = (const char**)calloc(cap, sizeof(const char*));
+    set->mask = cap - 1;
+    if (!set->names) return 0;
+    if (list)
+        for (i = 0; i < list->count; i++)
+            if (list->items[i].name[0]) {
+                unsigned h = name_hash(list->items[i].name) & set->mask;
+                while (set->names[h] && !name_equal(set->names[h], list->items[i].name))
+                    h = (h + 1) & set->mask;
+                set->names[h] = list->items[i].name;
+            }
+    return 1;
+}
+
+/* Returns 1 if name was already present, else inserts it (name must outlive the set). */
+static int name_set_test_and_add(name_set_t* set, const char* name) {
+    unsigned h = name_hash(name) & set->mask;
+    while (set->names[h]) {
+        if (name_equal(set->names[h], name)) return 1;
+        h = (h + 1) & set->mask;
+    }
+    set->names[h] = name;
+    return 0;
+}
+
+static void inventory_run(sync_op_t* base) {
+    inv_op_t* op = (inv_op_t*)base;
+    ogengine_sync_local_item_t* local = op->local_items;
+    int local_count = op->local_count;
+    const char* default_src = op->default_src;
+    ogengine_item_list_t* list = NULL;
+    ogengine_result_t result = OGENGINE_ERROR_NOT_INITIALIZED;
+    const char* err = NULL;
+    int queued = 0;
+    int cancelled = 0;
+
+    SYNC_TRACE("sync.inventory", 'B');
+    op->add_item_error[0] = '\0';
+    op->logged_count = 0;
+
+    /* One inventory fetch serves both the "already have it?" check and the result. */
+    result = ogengine_get_inventory(&list);
+    if (result == OGENGINE_SUCCESS && !list)
+        result = OGENGINE_ERROR_API_ERROR;
+
+    /* Set-difference local items against that fetch, queue every add, then flush once. Stack: name ends with
+     * _NNNNNN (e.g. Shells_000001) – send base name, API increments Quantity, no presence check. Unlock: add only
+     * if the name is not in the fetched inventory (or already queued in this batch). If the fetch failed,
+     * unlock items stay unsynced for the next refresh rather than risk duplicates. */
+    /* Cancelled (or timed out) mid-way: stop at the next step; release() frees whatever list we hold. */
+    cancelled = flag_load(&base->cancelled) != 0;
+    if (!cancelled && local && local_count > 0 && default_src[0]) {
+        name_set_t have = { NULL, 0 };
+        int have_ok = (result == OGENGINE_SUCCESS) && name_set_init(&have, list, (size_t)local_count);
+        int i;
+        for (i = 0; i < local_count; i++) {
+            if (flag_load(&base->cancelled)) { cancelled = 1; break; }  /* a retry may already own local_items */
+            if (local[i].synced) continue;
+            {
+                const char* n = local[i].name;
+                size_t len = strlen(n);
+                int is_stack_event = 0;
+                if (len >= 8 && n[len - 7] == '_') {
+                    int j;
+                    is_stack_event = 1;
+                    for (j = 0; j < 6; j++)
+                        if (n[len - 6 + j] < '0' || n[len - 6 + j] > '9') { is_stack_event = 0; break; }
+                }
+                if (is_stack_event) {
+                    /* Send base name (no _NNNNNN) so API increments Quantity on existing item. */
+                    char base_name[128];
+                    size_t base_len = len >= 8 ? (size_t)(len - 7) : len;
+                    if (base_len >= sizeof(base_name)) base_len = sizeof(base_name) - 1;
+                    memcpy(base_name, n, base_len);
+                    base_name[base_len] = '\0';
+                    const char* nft = (local[i].nft_id[0] != '\0') ? local[i].nft_id : NULL;
+                    ogengine_queue_add_item(
+                        base_name,
+                        local[i].description,
+                        local[i].game_source[0] ? local[i].game_source : default_src,
+                        local[i].item_type[0] ? local[i].item_type : "KeyItem",
+                        nft, 1, 1);
+                    queued++;
+                    if (op->logged_count < ADD_ITEM_LOG_NAMES_MAX)
+                        str_copy(op->logged_names[op->logged_count++], base_name, ADD_ITEM_LOG_NAME_SIZE);
+                } else {
+                    if (!have_ok) continue;
+                    if (!name_set_test_and_add(&have, local[i].name)) {
+                        const char* nft = (local[i].nft_id[0] != '\0') ? local[i].nft_id : NULL;
+                        ogengine_queue_add_item(
+                            local[i].name,
+                            local[i].description,
+                            local[i].game_source[0] ? local[i].game_source : default_src,
+                            local[i].item_type[0] ? local[i].item_type : "KeyItem",
+                            nft, 1, 1);
+                        queued++;
+                        if (op->logged_count < ADD_ITEM_LOG_NAMES_MAX)
+                            str_copy(op->logged_names[op->logged_count++], local[i].name, ADD_ITEM_LOG_NAME_SIZE);
+                    }
+                }
+                local[i].synced = 1;
+            }
+        }
+        free((void*)have.names);
+        if (queued && !cancelled) {
+            ogengine_result_t flush_res = ogengine_flush_add_item_jobs();
+            if (flush_res != OGENGINE_SUCCESS) {
+                const char* flush_err = ogengine_get_last_error();
+                str_copy(op->add_item_error, flush_err ? flush_err : "flush add_item jobs failed", sizeof(op->add_item_error));
+            }
+        }
+    }
+
+    /* Merge: the list comes from the client allocator, so added items cannot be spliced in here; re-read
+     * once so the result reflects the batch. Nothing queued means the first fetch is already current. */
+    if (queued && !cancelled && !flag_load(&base->cancelled)) {
+        if (list) ogengine_free_item_list(list);
+        list = NULL;
+        result = ogengine_get_inventory(&list);
+    }
+    if (result != OGENGINE_SUCCESS) {
+        err = ogengine_get_last_error();
+        if (!err || !err[0]) err = "Unknown error";
+    } else if (!list) {
+        result = OGENGINE_ERROR_API_ERROR;
+        err = "Inventory API returned success but no data";
+    }
+    SYNC_TRACE("sync.inventory", 'E');
+
+    op->list = list;
+    op->result = result;
+    str_copy(op->error_msg, err ? err : "", sizeof(op->error_msg));
+    /* If add_item failed (e.g. not logged in / no avatar), surface that so user sees why pickups aren't saved */
+    if (op->add_item_error[0] != '\0') {
+        str_copy(op->error_msg, op->add_item_error, sizeof(op->error_msg));
+        if (op->result == OGENGINE_SUCCESS)
+            op->result = OGENGINE_ERROR_NOT_INITIALIZED; /* so UI shows error */
+    }
+    /* Callback is invoked from main thread in ogengine_sync_pump(), not from this worker. */
+}
+
+static void inventory_fail(sync_op_t* base, const char* err) {
+    inv_op_t* op = (inv_op_t*)base;
+    op->list = NULL;
+    op->result = OGENGINE_ERROR_INIT_FAILED;
+    str_copy(op->error_msg, err, sizeof(op->error_msg));
+}
+
+static void inventory_release(sync_op_t* base) {
+    inv_op_t* op = (inv_op_t*)base;
+    if (op->list) {
+        ogengine_free_item_list(op->list);
+        op->list = NULL;
+    }
+}
+
+static void inventory_publish_error(const char* err) {
+    ogengine_sync_inventory_deliver_result(NULL, OGENGINE_ERROR_NETWORK, err);
+}
+
+static void inventory_deliver(sync_op_t* base) {
+    inv_op_t* op = (inv_op_t*)base;
+    int i;
+    /* The op's list becomes the current result; an unclaimed previous list is freed. */
+    ogengine_sync_inventory_deliver_result(op->list, op->result, op->error_msg);
+    op->list = NULL;
+    if (base->on_done) {
+        SYNC_TRACE("sync.inventory on_done", 'B');
+        base->on_done(base->user_data);
+        SYNC_TRACE("sync.inventory on_done", 'E');
+    }
+    if (g_add_item_log_cb) {
+        int success = (op->add_item_error[0] == '\0') ? 1 : 0;
+        for (i = 0; i < op->logged_count; i++)
+            g_add_item_log_cb(op->logged_names[i], success, op->add_item_error, g_add_item_log_user);
+    }
+}
+
+void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* list, ogengine_result_t result, const char* error_msg) {
+    sync_lock(&g_inv_lock);
+    g_inv_has_result = 1;
+    if (g_inv_list)
+        ogengine_free_item_list(g_inv_list);
+    g_inv_list = list;
+    g_inv_result = result;
+    str_copy(g_inv_error_msg, error_msg ? error_msg : "", sizeof(g_inv_error_msg));
+    sync_unlock(&g_inv_lock);
+}
+
+void ogengine_sync_inventory_start(ogengine_sync_local_item_t* local_items,
+    int local_count,
+    const char* default_game_source,
+    ogengine_sync_inventory_on_done_fn on_done,
+    void* on_done_user) {
+    (void)ogengine_sync_inventory_start_op(local_items, local_count, default_game_source, 0, on_done, on_done_user);
+}
+
+ogengine_sync_op_t ogengine_sync_inventory_start_op(ogengine_sync_local_item_t* local_items,
+    int local_count,
+    const char* default_game_source,
+    int timeout_ms,
+    ogengine_sync_inventory_on_done_fn on_done,
+    void* on_done_user) {
+    inv_op_t op;
+    memset(&op, 0, sizeof(op));
+    op.local_items = local_items;
+    op.local_count = local_count < 0 ? 0 : local_count;
+    str_copy(op.default_src, default_game_source ? default_game_source : "", sizeof(op.default_src));
+    op.base.on_done = on_done;
+    op.base.user_data = on_done_user;
+    return queue_push(&g_inv_queue, &op.base, timeout_ms);
+}
+
+int ogengine_sync_inventory_poll(void) {
+    int state;
+    sync_lock(&g_inv_lock);
+    state = g_inv_queue.pending ? 0 : (g_inv_has_result ? 1 : -1);
+    sync_unlock(&g_inv_lock);
+    return state;
+}
+
+int ogengine_sync_inventory_get_result(ogengine_item_list_t** list_out,
+    ogengine_result_t* result_out,
+    char* error_msg_buf, size_t error_msg_size) {
+    sync_lock(&g_inv_lock);
+    if (!g_inv_has_result) {
+        sync_unlock(&g_inv_lock);
+        return 0;
+    }
+    if (list_out) *list_out = g_inv_list;
+    if (result_out) *result_out = g_inv_result;
+    if (error_msg_buf && error_msg_size) str_copy(error_msg_buf, g_inv_error_msg, error_msg_size);
+    g_inv_has_result = 0;
+    g_inv_list = NULL; /* ownership transferred to caller */
+    sync_unlock(&g_inv_lock);
+    return 1;
+}
+
+void ogengine_sync_inventory_clear_result(void) {
+    sync_lock(&g_inv_lock);
+    if (g_inv_list) {
+        ogengine_free_item_list(g_inv_list);
+        g_inv_list = NULL;
+    }
+    g_inv_has_result = 0;
+    sync_unlock(&g_inv_lock);
+}
+
+int ogengine_sync_inventory_in_progress(void) {
+    return queue_pending(&g_inv_queue);
+}
+
+ogengine_result_t ogengine_sync_single_item(const char* name,
+    const char* description,
+    const char* game_source,
+    const char* item_type,
+    const char* nft_id) {
+    ogengine_result_t res;
+    if (!name || !name[0]) return OGENGINE_ERROR_INVALID_PARAM;
+    if (ogengine_has_item(name))
+        return OGENGINE_SUCCESS;
+    ogengine_queue_add_item(name, description ? description : "", game_source ? game_source : "", item_type ? item_type : "KeyItem", nft_id, 1, 1);
+    res = ogengine_flush_add_item_jobs();
+    if (g_add_item_log_cb) {
+        int success = (res == OGENGINE_SUCCESS) ? 1 : 0;
+        const char* err = (res != OGENGINE_SUCCESS) ? ogengine_get_last_error() : "";
+        g_add_item_log_cb(name, success, err ? err : "", g_add_item_log_user);
+    }
+    return res;
+}
+
+/* ---------------------------------------------------------------------------
+ * Optimistic use-item: the game's effect is applied before the request is
+ * sent, the entry stays in g_optimistic until the server answers, then it is
+ * committed or rolled back from the pump. A use whose deadline passes after
+ * its request went out is not a failure: the server may still consume the
+ * item, so the effect is kept (commit) and the next inventory refresh shows
+ * the server's quantity once the entry has left the ledger.
+ * --------------------------------------------------------------------------- */
+
+static void optimistic_settle(optimistic_use_t* entry, int success, const char* error) {
+    optimistic_use_t done = *entry;
+    memset(entry, 0, sizeof(*entry));  /* out of the ledger before the game refreshes its inventory */
+    if (success) {
+        if (done.effect->commit) done.effect->commit(done.item_name, done.user_data);
+    } else if (done.effect->rollback) {
+        SYNC_TRACE("sync.use_item rollback", 'B');
+        done.effect->rollback(done.item_name, error && error[0] ? error : "Unknown error", done.user_data);
+        SYNC_TRACE("sync.use_item rollback", 'E');
+    }
+}
+
+static void optimistic_on_done(void* user_data) {
+    optimistic_use_t* entry = (optimistic_use_t*)user_data;
+    int success = 0;
+    char error[USE_ERROR_SIZE] = {0};
+    if (!ogengine_sync_use_item_get_result(&success, error, sizeof(error))) success = 0;
+    if (g_expired_after_send) success = 1;  /* outcome unknown: never take back an effect the server may have paid for */
+    if (entry->used) optimistic_settle(entry, success, error);
+}
+
+static void optimistic_cancelled(ogengine_sync_op_t op) {
+    int i;
+    for (i = 0; i < OGENGINE_SYNC_MAX_PENDING_USES; i++)
+        if (g_optimistic[i].used && g_optimistic[i].handle == op) {
+            optimistic_settle(&g_optimistic[i], 0, "STAR operation cancelled");
+            return;
+        }
+}
+
+ogengine_sync_op_t ogengine_sync_use_item_optimistic(const char* item_name, const char* context, int timeout_ms,
+    const ogengine_sync_use_effect_t* effect, void* user_data) {
+    optimistic_use_t* entry = NULL;
+    ogengine_sync_op_t handle;
+    int i;
+    if (!item_name || !item_name[0] || !effect) return OGENGINE_SYNC_OP_NONE;
+    for (i = 0; i < OGENGINE_SYNC_MAX_PENDING_USES && !entry; i++)
+        if (!g_optimistic[i].used) entry = &g_optimistic[i];
+    if (!entry) return OGENGINE_SYNC_OP_NONE;
+    if (effect->apply && !effect->apply(item_name, user_data)) return OGENGINE_SYNC_OP_NONE;
+    entry->used = 1;
+    entry->handle = OGENGINE_SYNC_OP_NONE;
+    entry->effect = effect;
+    entry->user_data = user_data;
+    str_copy(entry->item_name, item_name, sizeof(entry->item_name));
+    handle = ogengine_sync_use_item_start_op(item_name, context, timeout_ms, optimistic_on_done, entry);
+    /* Queue full: optimistic_on_done has already rolled the entry back. */
+    if (handle != OGENGINE_SYNC_OP_NONE) entry->handle = handle;
+    return handle;
+}
+
+int ogengine_sync_use_item_pending_count(const char* item_name) {
+    int i, n = 0;
+    if (!item_name || !item_name[0]) return 0;
+    for (i = 0; i < OGENGINE_SYNC_MAX_PENDING_USES; i++)
+        if (g_optimistic[i].used && name_equal(g_optimistic[i].item_name, item_name)) n++;
+    return n;
+}
+
+int ogengine_sync_use_item_adjust_list(ogengine_item_list_t* list) {
+    size_t i, kept = 0;
+    int adjusted = 0;
+    if (!list || !list->items) return 0;
+    for (i = 0; i < list->count; i++) {
+        ogengine_item_t* item = &list->items[i];
+        int pending = ogengine_sync_use_item_pending_count(item->name);
+        if (pending) {
+            int qty = (item->quantity > 0 ? item->quantity : 1) - pending;
+            adjusted++;
+            if (qty <= 0) continue;
+            item->quantity = qty;
+        }
+        if (kept != i) list->items[kept] = *item;
+        kept++;
+    }
+    list->count = kept;
+    return adjusted;
+}
@@ -0,0 +1,47 @@
+# ogengine_sync.cmake — C implementation of the STAR sync layer as one static library target.
+#
+# Every port links this instead of carrying its own copy of ogengine_sync.c:
+#
+#   include("<OASIS Omniverse>/OGEngineClient/ogengine_sync.cmake")
+#   target_link_libraries(<game> PRIVATE ogengine_sync)
+#
+# Linking it selects the C implementation, so do not define OASIS_STAR_SYNC_IN_CLIENT for the
+# game; the OGENGINE_SYNC_HAS_* feature macros and OGENGINE_SYNC_ABI_VERSION then come from
+# ogengine_sync.h.
+#
+# Options:
+#   OGENGINE_SYNC_CLIENT_INCLUDE_DIR  directory holding ogengine.h (default: OGEngineClient, where
+#                                     the client build deploys it)
+#   OGENGINE_SYNC_POOL_THREADS        worker pool size, 1-8 (default 4)
+
+if(TARGET ogengine_sync)
+    return()
+endif()
+
+set(OGENGINE_SYNC_DIR "${CMAKE_CURRENT_LIST_DIR}")
+set(OGENGINE_SYNC_CLIENT_INCLUDE_DIR "${OGENGINE_SYNC_DIR}" CACHE PATH "Directory containing ogengine.h")
+set(OGENGINE_SYNC_POOL_THREADS 4 CACHE STRING "ogengine_sync worker pool size (1-8)")
+
+find_package(Threads REQUIRED)
+
+add_library(ogengine_sync STATIC
+    "${OGENGINE_SYNC_DIR}/ogengine_sync.c"
+    "${OGENGINE_SYNC_DIR}/ogengine_sync.h"
+    "${OGENGINE_SYNC_DIR}/ogengine_sync_coro.h"
+)
+
+# C99 plus extensions: __thread and clock_gettime on POSIX.
+set_target_properties(ogengine_sync PROPERTIES
+    C_STANDARD 99
+    C_EXTENSIONS ON
+    POSITION_INDEPENDENT_CODE ON
+)
+
+target_include_directories(ogengine_sync PUBLIC
+    "${OGENGINE_SYNC_DIR}"
+    "${OGENGINE_SYNC_CLIENT_INCLUDE_DIR}"
+)
+
+target_compile_definitions(ogengine_sync PRIVATE OGENGINE_SYNC_POOL_THREADS=${OGENGINE_SYNC_POOL_THREADS})
+
+target_link_libraries(ogengine_sync PUBLIC Threads::Threads)
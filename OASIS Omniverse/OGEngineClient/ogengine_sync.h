@@ -0,0 +1,397 @@
+﻿/**
+ * OASIS STAR API - Generic game integration layer (async auth, async inventory, local-item sync)
+ *
+ * Use this from OQUAKE, ODOOM, or any game that links against star_api. It provides:
+ * - Async authentication (background thread; completion via callback from main thread)
+ * - Async inventory refresh (background thread; completion via callback from main thread)
+ * - Async send item (background thread; completion via callback from main thread)
+ * - Reusable sync logic so games don't duplicate threading/sync code
+ *
+ * All completion callbacks are invoked on the main thread when you call ogengine_sync_pump().
+ * Call ogengine_sync_pump() once per frame; no per-frame polling of individual operations.
+ *
+ * This file and ogengine_sync.c in OGEngineClient are the only copies in the repo; game build
+ * scripts copy them into the engine tree. Do not commit per-game forks.
+ *
+ * Build options:
+ * - Default: the game compiles ogengine_sync.c (this C implementation) and links it with star_api.
+ *   BUILD ODOOM / BUILD_OQUAKE do this unless OASIS_STAR_SYNC_IN_CLIENT=1. Only this mode has the
+ *   worker pool, op queues/handles, cancellation, stats, jobs and optimistic use (the
+ *   OGENGINE_SYNC_HAS_* macros below).
+ * - OASIS_STAR_SYNC_IN_CLIENT=1: ogengine_sync_* come from the star_api exports (C# implementation,
+ *   ABI MAJOR 1 only). Do NOT compile ogengine_sync.c; define OASIS_STAR_SYNC_IN_CLIENT for the game.
+ * - CMake games can include OGEngineClient/ogengine_sync.cmake and link the ogengine_sync
+ *   static library target instead of adding the source file.
+ * - If you get LNK2001 for ogengine_queue_quest_level_time: either link with a STAR API build
+ *   that exports it, or define OGENGINE_PROVIDE_QUEST_LEVEL_TIME_STUB for ogengine_sync.c, or
+ *   add only ogengine_quest_level_time_stub.c to the build (no macro needed).
+ */
+
+#ifndef STAR_SYNC_H
+#define STAR_SYNC_H
+
+#include "ogengine.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ---------------------------------------------------------------------------
+ * ABI version. MAJOR changes when an existing declaration or the layout of
+ * ogengine_sync_local_item_t changes (the C# exports implement MAJOR 1); MINOR
+ * counts C-only additions, each with its OGENGINE_SYNC_HAS_* macro:
+ * 1 trace hook, 2 jobs, 3 op queues, 4 pump budget, 5 op handles, 6 stats,
+ * 7 optimistic use.
+ * --------------------------------------------------------------------------- */
+#define OGENGINE_SYNC_ABI_MAJOR 1
+#define OGENGINE_SYNC_ABI_MINOR 7
+#define OGENGINE_SYNC_ABI_VERSION ((OGENGINE_SYNC_ABI_MAJOR << 16) | OGENGINE_SYNC_ABI_MINOR)
+
+/** ABI version of the linked C implementation (not exported by the C# client). A game built against a
+ *  prebuilt ogengine_sync library should check that (version >> 16) == OGENGINE_SYNC_ABI_MAJOR and
+ *  (version & 0xFFFF) >= the MINOR it needs. */
+int ogengine_sync_abi_version(void);
+
+/** Optional callback invoked after add_item (single or batch): (item_name, success, error_message, user_data). Called from main thread. */
+typedef void (*ogengine_sync_add_item_log_fn)(const char* item_name, int success, const char* error_message, void* user_data);
+
+/** Set optional callback for add_item results (e.g. for debug logging). Pass NULL to clear. */
+void ogengine_sync_set_add_item_log_cb(ogengine_sync_add_item_log_fn cb, void* user_data);
+
+/** Call once at game startup (e.g. from OQuake_STAR_Init). Initializes locks and starts the worker pool. Does nothing while a
+ *  worker left running by the previous cleanup is still inside a job; call again later (e.g. on the next beam-in). */
+void ogengine_sync_init(void);
+
+/** Call at game shutdown (e.g. from OQuake_STAR_Cleanup). Stops the worker pool, frees any pending inventory result and tears down
+ *  locks. Workers still inside a job after the grace period are detached and their locks kept until the next init finds them gone. */
+void ogengine_sync_cleanup(void);
+
+/**
+ * Call once per frame from the main thread. Runs any pending auth/inventory/send_item completion
+ * callbacks on the main thread. More efficient than polling each operation every frame.
+ */
+void ogengine_sync_pump(void);
+
+/* ---------------------------------------------------------------------------
+ * Frame-budgeted pump (C implementation only). Use instead of ogengine_sync_pump()
+ * to cap the time completion callbacks take in one frame: callbacks run in order
+ * until budget_us microseconds have passed, the rest wait for the next call. At
+ * least one callback runs per call. budget_us <= 0 means no limit.
+ * Returns how many completions are still waiting (0 = caught up; a count above 0
+ * may include one that finished since the call started).
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_PUMP_BUDGET 1
+#endif
+int ogengine_sync_pump_budget(int budget_us);
+
+/* ---------------------------------------------------------------------------
+ * Optional tracing hook (C implementation only; not exported by the C# star_sync).
+ * cb(name, phase, user_data) is called for span begin ('B') / end ('E') around the pump,
+ * each main-thread callback and each worker operation, and with phase 'M' once per worker
+ * thread to name it. Called from main and worker threads; OGLib's oglib_trace_sync_hook
+ * has this signature.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_TRACE_CB 1
+#endif
+typedef void (*ogengine_sync_trace_fn)(const char* name, int phase, void* user_data);
+
+/** Set (or clear with NULL) the trace hook. Call from the main thread before starting operations. */
+void ogengine_sync_set_trace_cb(ogengine_sync_trace_fn cb, void* user_data);
+
+/* ---------------------------------------------------------------------------
+ * Worker pool (C implementation only). ogengine_sync_init starts a fixed set of
+ * worker threads (OGENGINE_SYNC_POOL_THREADS, default 4) that run every auth,
+ * inventory, send_item and use_item operation; no thread is created per operation.
+ * Games can queue their own background work on the same pool.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_JOBS 1
+#endif
+typedef void (*ogengine_sync_job_fn)(void* arg);
+
+/** Run fn(arg) on a pool worker. Returns 1 if queued, 0 if the pool is not running or all queues are full. fn runs off the main thread and must not call ogengine_sync_pump. */
+int ogengine_sync_job_submit(ogengine_sync_job_fn fn, void* arg);
+
+/* ---------------------------------------------------------------------------
+ * Operation queues (C implementation only). Inventory, send_item and use_item
+ * starts are never dropped: each call queues its own operation with its own
+ * on_done/user_data and result, and ogengine_sync_pump() delivers completions in
+ * the order they finish (uses and inventory refreshes run one at a time, so for
+ * them that is call order). Inside on_done, *_get_result() returns that
+ * operation's result. A pump with nothing finished takes no locks.
+ * If a family's queue is full the operation fails at once and its on_done runs
+ * before the start call returns. The C# client keeps one operation per family
+ * and ignores starts while one is in progress.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_OP_QUEUES 1
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Local item entry: one item to sync to remote (has_item then add_item if missing).
+ * name, description, game_source, item_type are inputs; synced is output (1 when synced).
+ * nft_id: optional; if set, add_item is called with this NFT ID (item is linked to NFTHolon).
+ * Game allocates an array of these and passes to ogengine_sync_inventory_start.
+ * --------------------------------------------------------------------------- */
+typedef struct ogengine_sync_local_item {
+    char name[256];
+    char description[512];
+    char game_source[64];
+    char item_type[64];
+    char nft_id[128];  /* optional; empty = no NFT. When set, add_item stores NFTId in item MetaData. */
+    int  synced;  /* output: set to 1 by sync layer when item is on remote */
+} ogengine_sync_local_item_t;
+
+/* ---------------------------------------------------------------------------
+ * Async authentication
+ * --------------------------------------------------------------------------- */
+
+/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees auth finished. In the callback, call ogengine_sync_auth_get_result() to get the result. */
+typedef void (*ogengine_sync_auth_on_done_fn)(void* user_data);
+
+/** Start authentication on a background thread. When done, on_done(user_data) is invoked from main thread when you call ogengine_sync_pump(). Pass NULL to use polling (ogengine_sync_auth_poll/get_result). */
+void ogengine_sync_auth_start(const char* username, const char* password, ogengine_sync_auth_on_done_fn on_done, void* user_data);
+
+/** Returns: 0 = still in progress, 1 = finished (call ogengine_sync_auth_get_result), -1 = not started / no result. Only needed if not using callbacks. */
+int ogengine_sync_auth_poll(void);
+
+/** Get result after poll returned 1. Copies username/avatar_id/error into buffers. Returns 1 on success, 0 on failure. */
+int ogengine_sync_auth_get_result(
+    int* success_out,
+    char* username_buf, size_t username_size,
+    char* avatar_id_buf, size_t avatar_id_size,
+    char* error_msg_buf, size_t error_msg_size
+);
+/** Copy JWT from last auth result into jwt_buf (call after ogengine_sync_auth_get_result). For oasisstar.json / autobeamin. */
+void ogengine_sync_auth_get_result_jwt(char* jwt_buf, size_t jwt_size);
+
+/** Non-zero if an auth is currently in progress */
+int ogengine_sync_auth_in_progress(void);
+
+/** Force-clear auth state so a new auth can be started (e.g. after timeout). Call when the game has given up waiting.
+ *  C implementation: same as ogengine_sync_cancel on the current auth; the old job's late result is discarded and its callback never runs.
+ *  C# client: the previous auth thread may still complete later and invoke the callback once. */
+void ogengine_sync_auth_force_reset(void);
+
+/* ---------------------------------------------------------------------------
+ * Async inventory refresh (optionally sync local items first, then get_inventory)
+ * --------------------------------------------------------------------------- */
+
+/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees inventory finished. In the callback, call ogengine_sync_inventory_get_result() then ogengine_sync_inventory_clear_result() when done. Pass NULL to use polling. */
+typedef void (*ogengine_sync_inventory_on_done_fn)(void* user_data);
+
+/** Start inventory refresh on a background thread. Syncs local_items (has_item/add_item) then get_inventory.
+ *  With OGENGINE_SYNC_HAS_OP_QUEUES, overlapping refreshes queue and run one after another; local_items must stay valid until on_done.
+ *  local_items may be NULL (or count 0) to only fetch inventory.
+ *  on_done and on_done_user: optional; if non-NULL, on_done(user_data) is called from main thread in ogengine_sync_pump(). Pass NULL, NULL to use polling. */
+void ogengine_sync_inventory_start(
+    ogengine_sync_local_item_t* local_items,
+    int local_count,
+    const char* default_game_source,
+    ogengine_sync_inventory_on_done_fn on_done,
+    void* on_done_user
+);
+
+/** Returns: 0 = in progress, 1 = finished (call ogengine_sync_inventory_get_result and free the list), -1 = not started / no result */
+int ogengine_sync_inventory_poll(void);
+
+/** Get result after poll returned 1 (or inside on_done). Ownership of *list_out passes to the caller,
+ *  who must call ogengine_free_item_list() when done. */
+int ogengine_sync_inventory_get_result(
+    ogengine_item_list_t** list_out,
+    ogengine_result_t* result_out,
+    char* error_msg_buf, size_t error_msg_size
+);
+
+/** Clear the stored result (frees the list). Call after you've copied or used the list. */
+void ogengine_sync_inventory_clear_result(void);
+
+/** Deliver inventory result from the game's operation_callback(OGENGINE_OP_GET_INVENTORY). Call after ogengine_get_inventory() when callback fires. Takes ownership of list (may be NULL on error). */
+void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* list, ogengine_result_t result, const char* error_msg);
+
+/** Non-zero if an inventory refresh is currently queued or running (with op queues: how many) */
+int ogengine_sync_inventory_in_progress(void);
+
+/* ---------------------------------------------------------------------------
+ * One-shot sync of a single local item (has_item then add_item if missing).
+ * Can be called from main thread; use for immediate sync when e.g. player picks up a key.
+ * --------------------------------------------------------------------------- */
+ogengine_result_t ogengine_sync_single_item(
+    const char* name,
+    const char* description,
+    const char* game_source,
+    const char* item_type,
+    const char* nft_id  /* NULL or empty for non-NFT items */
+);
+
+/* ---------------------------------------------------------------------------
+ * Async send item (to avatar or clan) - same background-thread pattern as auth/inventory.
+ * --------------------------------------------------------------------------- */
+
+/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees send finished. In the callback, call ogengine_sync_send_item_get_result() to get success/error. */
+typedef void (*ogengine_sync_send_item_on_done_fn)(void* user_data);
+
+/** Start send-item on a background thread. to_clan: 1 = send to clan, 0 = send to avatar. item_id can be NULL. When done, on_done(user_data) is invoked from main thread in ogengine_sync_pump(). Pass NULL to use polling. */
+void ogengine_sync_send_item_start(const char* target, const char* item_name, int quantity, int to_clan, const char* item_id, ogengine_sync_send_item_on_done_fn on_done, void* user_data);
+
+/** Returns: 0 = in progress, 1 = finished (call ogengine_sync_send_item_get_result), -1 = not started / no result. Only needed if not using callbacks. */
+int ogengine_sync_send_item_poll(void);
+
+/** Get result after poll returned 1. success_out: 1 = success, 0 = failure. Returns 1 if result was consumed. */
+int ogengine_sync_send_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size);
+
+/** Non-zero if a send is currently queued or running (with op queues: how many) */
+int ogengine_sync_send_item_in_progress(void);
+
+/* ---------------------------------------------------------------------------
+ * Async use item (e.g. door/key) - runs on background thread so API is off main thread.
+ * --------------------------------------------------------------------------- */
+
+/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees use-item finished. */
+typedef void (*ogengine_sync_use_item_on_done_fn)(void* user_data);
+
+/** Start use-item on a background thread. When done, on_done(user_data) is invoked from main thread in ogengine_sync_pump(). Pass NULL for polling. */
+void ogengine_sync_use_item_start(const char* item_name, const char* context, ogengine_sync_use_item_on_done_fn on_done, void* user_data);
+
+/** Get result after use-item finished. success_out: 1 = success, 0 = failure. Returns 1 if result was consumed. */
+int ogengine_sync_use_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size);
+
+/** Non-zero if a use-item is currently queued or running (with op queues: how many) */
+int ogengine_sync_use_item_in_progress(void);
+
+/* ---------------------------------------------------------------------------
+ * Operation handles, cancellation and deadlines (C implementation only).
+ * The *_start_op variants start the same operations as *_start and return a
+ * handle (OGENGINE_SYNC_OP_NONE if nothing was started: auth already busy, or
+ * the family's queue full, in which case on_done has already run).
+ * timeout_ms > 0 sets a deadline, checked by ogengine_sync_pump(): an operation
+ * still queued or running when it passes fails with "STAR operation timed out"
+ * through its normal on_done / get_result.
+ * A cancelled operation never calls back: queued, it never runs; running, its
+ * worker is flagged and its result is released as soon as it returns, and the
+ * next queued operation of that family starts then (never alongside it).
+ *
+ * The client's HTTP calls take no timeout of their own, so the deadline reaches
+ * the transport cooperatively: code on a worker can read the operation it runs
+ * for (current_op*), and the abort callback fires when a running operation is
+ * cancelled or times out so the transport can abort that request.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_OP_HANDLES 1
+#endif
+typedef uint32_t ogengine_sync_op_t;
+#define OGENGINE_SYNC_OP_NONE ((ogengine_sync_op_t)0)
+
+ogengine_sync_op_t ogengine_sync_auth_start_op(const char* username, const char* password, int timeout_ms,
+    ogengine_sync_auth_on_done_fn on_done, void* user_data);
+ogengine_sync_op_t ogengine_sync_inventory_start_op(ogengine_sync_local_item_t* local_items, int local_count,
+    const char* default_game_source, int timeout_ms, ogengine_sync_inventory_on_done_fn on_done, void* on_done_user);
+ogengine_sync_op_t ogengine_sync_send_item_start_op(const char* target, const char* item_name, int quantity, int to_clan,
+    const char* item_id, int timeout_ms, ogengine_sync_send_item_on_done_fn on_done, void* user_data);
+ogengine_sync_op_t ogengine_sync_use_item_start_op(const char* item_name, const char* context, int timeout_ms,
+    ogengine_sync_use_item_on_done_fn on_done, void* user_data);
+
+/** Cancel an operation. Returns 1 if it had not been delivered yet (its on_done will not run), 0 if already delivered or unknown. */
+int ogengine_sync_cancel(ogengine_sync_op_t op);
+
+/** On a worker thread: handle of the operation being run, OGENGINE_SYNC_OP_NONE elsewhere. */
+ogengine_sync_op_t ogengine_sync_current_op(void);
+/** On a worker thread: milliseconds left before the current operation's deadline, 0 if passed, -1 if it has none. */
+int ogengine_sync_current_op_remaining_ms(void);
+/** On a worker thread: non-zero once the current operation was cancelled or timed out; its result will be discarded. */
+int ogengine_sync_current_op_cancelled(void);
+
+/** Abort hook: cb(op, user_data) runs on the cancelling thread (the pump, for timeouts) when a running operation is cancelled or times out. */
+typedef void (*ogengine_sync_abort_fn)(ogengine_sync_op_t op, void* user_data);
+void ogengine_sync_set_abort_cb(ogengine_sync_abort_fn cb, void* user_data);
+
+/* ---------------------------------------------------------------------------
+ * Latency and queue-depth stats (C implementation only). Every delivered
+ * operation is timed at enqueue, worker start, worker done and pump delivery;
+ * the phases between them go into log2 histograms per family covering the last
+ * one to two windows of window_ms. Cancelled and timed-out operations are
+ * counted but not timed. Bucket i holds samples below BUCKET0_US << i; the last
+ * bucket is open-ended.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_STATS 1
+#endif
+#define OGENGINE_SYNC_STATS_BUCKETS 20
+#define OGENGINE_SYNC_STATS_BUCKET0_US 128
+
+typedef struct ogengine_sync_histogram {
+    uint32_t count;
+    uint64_t sum_us;
+    uint32_t max_us;
+    uint32_t buckets[OGENGINE_SYNC_STATS_BUCKETS];
+} ogengine_sync_histogram_t;
+
+typedef struct ogengine_sync_family_stats {
+    ogengine_sync_histogram_t queue_wait;  /* enqueue -> worker start */
+    ogengine_sync_histogram_t network;     /* worker start -> worker done */
+    ogengine_sync_histogram_t delivery;    /* worker done -> on_done from the pump */
+    ogengine_sync_histogram_t total;       /* enqueue -> on_done */
+    uint32_t started, delivered, cancelled, timed_out;  /* since init or the last reset */
+    int pending;                           /* queued + running now */
+    int peak_pending;                      /* highest pending since the last reset */
+} ogengine_sync_family_stats_t;
+
+typedef struct ogengine_sync_stats {
+    uint32_t window_ms;
+    ogengine_sync_family_stats_t auth, inventory, send_item, use_item;
+    int backlog;                           /* completions waiting for the pump */
+} ogengine_sync_stats_t;
+
+/** Main thread. Snapshot of the current stats. */
+void ogengine_sync_get_stats(ogengine_sync_stats_t* out);
+/** Main thread. Clear histograms and counters; peaks restart from the current depth. */
+void ogengine_sync_reset_stats(void);
+/** Main thread. Write a text report (count, p50/p95/max ms per phase and family) into buf. Returns its length. */
+int ogengine_sync_format_stats(char* buf, size_t size);
+
+/* ---------------------------------------------------------------------------
+ * Optimistic use-item (C implementation only). The game's effect is applied at
+ * once and the use is recorded as pending; the request then runs like
+ * use_item_start_op. When the server answers, the pump calls commit, or
+ * rollback if it was rejected, timed out before its request was sent, failed
+ * to queue or was cancelled with ogengine_sync_cancel (main thread). A use that
+ * times out after its request went out may still succeed on the server, so it
+ * is committed: the effect stays and the next inventory fetch shows the
+ * server's quantity. Rollback must undo apply and tell the player. While a use is pending, the item's shown quantity should be one
+ * lower: pending_count / adjust_list do that for inventory lists the game
+ * fetched itself. All of it runs on the main thread.
+ * --------------------------------------------------------------------------- */
+#ifndef OASIS_STAR_SYNC_IN_CLIENT
+#define OGENGINE_SYNC_HAS_OPTIMISTIC_USE 1
+#endif
+#define OGENGINE_SYNC_MAX_PENDING_USES 32
+
+typedef struct ogengine_sync_use_effect {
+    /** Apply the item locally. Return 0 to refuse: nothing is sent or recorded. NULL = nothing to apply. */
+    int  (*apply)(const char* item_name, void* user_data);
+    /** The server accepted the use. May be NULL. */
+    void (*commit)(const char* item_name, void* user_data);
+    /** The server rejected the use (error says why): undo apply and notify. */
+    void (*rollback)(const char* item_name, const char* error, void* user_data);
+} ogengine_sync_use_effect_t;
+
+/** Apply effect now and start the use. effect must stay valid until commit/rollback (usually a static const).
+ *  Returns OGENGINE_SYNC_OP_NONE if nothing is pending: apply refused, OGENGINE_SYNC_MAX_PENDING_USES
+ *  reached (apply not called), or the queue was full (already rolled back). */
+ogengine_sync_op_t ogengine_sync_use_item_optimistic(const char* item_name, const char* context, int timeout_ms,
+    const ogengine_sync_use_effect_t* effect, void* user_data);
+/** Optimistic uses of item_name (case-insensitive) the server has not answered yet. */
+int ogengine_sync_use_item_pending_count(const char* item_name);
+/** Subtract pending uses from a fetched list in place; items that reach 0 are removed. Returns how many items were adjusted. */
+int ogengine_sync_use_item_adjust_list(ogengine_item_list_t* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STAR_SYNC_H */
@@ -0,0 +1,283 @@
+/**
+ * ogengine_sync_coro.h - C++20 coroutine facade over ogengine_sync
+ *
+ * Lets C++ game integrations write multi-step STAR flows linearly instead of
+ * chaining on_done callbacks and globals:
+ *
+ *   static star::task UseThenRefresh(std::string name) {
+ *       star::item_result used = co_await star::use_item(name.c_str(), "my_game");
+ *       if (!used.success) { LogError(used.error.c_str()); co_return; }
+ *       ApplyLocally(name);
+ *       star::inventory_result inv = co_await star::inventory();
+ *       if (inv.ok()) RebuildOverlay(inv.list.get());
+ *   }
+ *
+ * Each co_await starts the operation through the normal ogengine_sync_*_start
+ * call and suspends; the coroutine resumes on the main thread inside
+ * ogengine_sync_pump(), from the operation's on_done, so no extra thread or
+ * polling is involved. A star::task runs eagerly up to its first co_await and
+ * frees itself when it finishes.
+ *
+ * An operation that cannot start (auth already running; with the C# client, any
+ * family already busy; with op queues, a full queue) resumes at once with a
+ * failed result. With OGENGINE_SYNC_HAS_OP_HANDLES a timeout_ms > 0 makes the
+ * operation fail with "STAR operation timed out" instead of waiting forever. Do
+ * not ogengine_sync_cancel() an awaited operation: its on_done never runs, so
+ * the coroutine would never resume. Coroutines still suspended at
+ * ogengine_sync_cleanup() are never resumed and their frames leak.
+ *
+ * Needs C++20 coroutines; OGENGINE_SYNC_HAS_COROUTINES is defined when they are
+ * available, otherwise this header declares nothing.
+ */
+#ifndef OGENGINE_SYNC_CORO_H
+#define OGENGINE_SYNC_CORO_H
+
+#include "ogengine_sync.h"
+
+#if defined(__cplusplus) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define OGENGINE_SYNC_HAS_COROUTINES 1
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace star {
+
+/** Fire-and-forget coroutine: starts immediately, destroys its frame when it returns. */
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+struct item_list_deleter {
+    void operator()(ogengine_item_list_t* list) const noexcept { ogengine_free_item_list(list); }
+};
+using item_list_ptr = std::unique_ptr<ogengine_item_list_t, item_list_deleter>;
+
+struct auth_result {
+    bool success = false;
+    std::string username, avatar_id, jwt, error;
+};
+
+struct inventory_result {
+    ogengine_result_t result = OGENGINE_ERROR_NETWORK;
+    item_list_ptr list;
+    std::string error;
+    bool ok() const { return result == OGENGINE_SUCCESS && list; }
+};
+
+/** Result of send_item and use_item. */
+struct item_result {
+    bool success = false;
+    std::string error;
+};
+
+namespace detail {
+
+constexpr const char* kBusy = "STAR operation already in progress";
+
+/* Derived provides bool start() (false = nothing started and on_done will not run)
+ * and void capture() (reads the family's result; called from on_done). */
+template <class Derived, class Result>
+class awaiter {
+public:
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> waiter) {
+        waiter_ = waiter;
+        starting_ = true;
+        bool started = static_cast<Derived*>(this)->start();
+        starting_ = false;
+        if (!started && !done_) result_.error = kBusy;
+        /* on_done may already have run inside start() (e.g. queue full): continue without suspending. */
+        return started && !done_;
+    }
+
+    Result await_resume() { return std::move(result_); }
+
+protected:
+    static void on_done(void* self) {
+        Derived* d = static_cast<Derived*>(self);
+        awaiter* a = d;
+        d->capture();
+        a->done_ = true;
+        if (!a->starting_) a->waiter_.resume();
+    }
+
+    Result result_;
+
+private:
+    std::coroutine_handle<> waiter_;
+    bool starting_ = false;
+    bool done_ = false;
+};
+
+class auth_awaiter : public awaiter<auth_awaiter, auth_result> {
+public:
+    auth_awaiter(const char* username, const char* password, int timeout_ms)
+        : username_(username ? username : ""), password_(password ? password : ""), timeout_ms_(timeout_ms) {}
+
+    bool start() {
+        if (ogengine_sync_auth_in_progress()) return false;
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+        return ogengine_sync_auth_start_op(username_.c_str(), password_.c_str(), timeout_ms_, &on_done, this) != OGENGINE_SYNC_OP_NONE;
+#else
+        ogengine_sync_auth_start(username_.c_str(), password_.c_str(), &on_done, this);
+        return true;
+#endif
+    }
+
+    void capture() {
+        int success = 0;
+        char username[64] = {}, avatar_id[64] = {}, error[256] = {};
+        char jwt[2048] = {};
+        ogengine_sync_auth_get_result(&success, username, sizeof(username), avatar_id, sizeof(avatar_id), error, sizeof(error));
+        ogengine_sync_auth_get_result_jwt(jwt, sizeof(jwt));
+        result_.success = success != 0;
+        result_.username = username;
+        result_.avatar_id = avatar_id;
+        result_.jwt = jwt;
+        result_.error = error;
+    }
+
+private:
+    std::string username_, password_;
+    int timeout_ms_;
+};
+
+class inventory_awaiter : public awaiter<inventory_awaiter, inventory_result> {
+public:
+    inventory_awaiter(ogengine_sync_local_item_t* local_items, int local_count, const char* default_game_source, int timeout_ms)
+        : local_items_(local_items), local_count_(local_count),
+          game_source_(default_game_source ? default_game_source : ""), timeout_ms_(timeout_ms) {}
+
+    bool start() {
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+        return ogengine_sync_inventory_start_op(local_items_, local_count_, game_source_.c_str(), timeout_ms_, &on_done, this) != OGENGINE_SYNC_OP_NONE;
+#else
+#ifndef OGENGINE_SYNC_HAS_OP_QUEUES
+        if (ogengine_sync_inventory_in_progress()) return false;
+#endif
+        ogengine_sync_inventory_start(local_items_, local_count_, game_source_.c_str(), &on_done, this);
+        return true;
+#endif
+    }
+
+    void capture() {
+        ogengine_item_list_t* list = nullptr;
+        ogengine_result_t result = OGENGINE_ERROR_NETWORK;
+        char error[256] = {};
+        ogengine_sync_inventory_get_result(&list, &result, error, sizeof(error));
+        ogengine_sync_inventory_clear_result();
+        result_.result = result;
+        result_.list.reset(list);
+        result_.error = error;
+    }
+
+private:
+    ogengine_sync_local_item_t* local_items_;
+    int local_count_;
+    std::string game_source_;
+    int timeout_ms_;
+};
+
+class send_item_awaiter : public awaiter<send_item_awaiter, item_result> {
+public:
+    send_item_awaiter(const char* target, const char* item_name, int quantity, bool to_clan, const char* item_id, int timeout_ms)
+        : target_(target ? target : ""), item_name_(item_name ? item_name : ""), item_id_(item_id ? item_id : ""),
+          quantity_(quantity), to_clan_(to_clan), timeout_ms_(timeout_ms) {}
+
+    bool start() {
+        const char* item_id = item_id_.empty() ? nullptr : item_id_.c_str();
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+        return ogengine_sync_send_item_start_op(target_.c_str(), item_name_.c_str(), quantity_, to_clan_ ? 1 : 0, item_id,
+            timeout_ms_, &on_done, this) != OGENGINE_SYNC_OP_NONE;
+#else
+#ifndef OGENGINE_SYNC_HAS_OP_QUEUES
+        if (ogengine_sync_send_item_in_progress()) return false;
+#endif
+        ogengine_sync_send_item_start(target_.c_str(), item_name_.c_str(), quantity_, to_clan_ ? 1 : 0, item_id, &on_done, this);
+        return true;
+#endif
+    }
+
+    void capture() {
+        int success = 0;
+        char error[384] = {};
+        ogengine_sync_send_item_get_result(&success, error, sizeof(error));
+        result_.success = success != 0;
+        result_.error = error;
+    }
+
+private:
+    std::string target_, item_name_, item_id_;
+    int quantity_;
+    bool to_clan_;
+    int timeout_ms_;
+};
+
+class use_item_awaiter : public awaiter<use_item_awaiter, item_result> {
+public:
+    use_item_awaiter(const char* item_name, const char* context, int timeout_ms)
+        : item_name_(item_name ? item_name : ""), context_(context ? context : ""), timeout_ms_(timeout_ms) {}
+
+    bool start() {
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+        return ogengine_sync_use_item_start_op(item_name_.c_str(), context_.c_str(), timeout_ms_, &on_done, this) != OGENGINE_SYNC_OP_NONE;
+#else
+#ifndef OGENGINE_SYNC_HAS_OP_QUEUES
+        if (ogengine_sync_use_item_in_progress()) return false;
+#endif
+        ogengine_sync_use_item_start(item_name_.c_str(), context_.c_str(), &on_done, this);
+        return true;
+#endif
+    }
+
+    void capture() {
+        int success = 0;
+        char error[384] = {};
+        ogengine_sync_use_item_get_result(&success, error, sizeof(error));
+        result_.success = success != 0;
+        result_.error = error;
+    }
+
+private:
+    std::string item_name_, context_;
+    int timeout_ms_;
+};
+
+} // namespace detail
+
+/** co_await star::auth(user, pass) -> auth_result. Arguments are copied, so temporaries are fine. */
+inline detail::auth_awaiter auth(const char* username, const char* password, int timeout_ms = 0) {
+    return detail::auth_awaiter(username, password, timeout_ms);
+}
+
+/** co_await star::inventory() -> inventory_result, which owns the fetched list. local_items must stay valid until it resumes. */
+inline detail::inventory_awaiter inventory(ogengine_sync_local_item_t* local_items = nullptr, int local_count = 0,
+    const char* default_game_source = nullptr, int timeout_ms = 0) {
+    return detail::inventory_awaiter(local_items, local_count, default_game_source, timeout_ms);
+}
+
+/** co_await star::send_item(target, item, qty) -> item_result. */
+inline detail::send_item_awaiter send_item(const char* target, const char* item_name, int quantity, bool to_clan = false,
+    const char* item_id = nullptr, int timeout_ms = 0) {
+    return detail::send_item_awaiter(target, item_name, quantity, to_clan, item_id, timeout_ms);
+}
+
+/** co_await star::use_item(item, context) -> item_result. */
+inline detail::use_item_awaiter use_item(const char* item_name, const char* context, int timeout_ms = 0) {
+    return detail::use_item_awaiter(item_name, context, timeout_ms);
+}
+
+} // namespace star
+
+#endif /* C++20 coroutines */
+
+#endif /* OGENGINE_SYNC_CORO_H */
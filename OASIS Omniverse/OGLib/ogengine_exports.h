@@ -0,0 +1,206 @@
+﻿/**
+ * ogengine_exports.h — OGEngineClient ABI manifest
+ *
+ * One list of every function the STAR API client (ogengine.dll / libOGEngineClient.so)
+ * exports. Everything that binds to the client is generated from OGENGINE_EXPORTS:
+ *
+ *   - the C declarations below (so games no longer depend on an up-to-date copy of
+ *     ogengine.h for the prototypes they call);
+ *   - the runtime vtable in oglib_session.h (GetProcAddress / dlsym, resolved once);
+ *   - the static-link table in oglib_session.h (OGLIB_SESSION_STATIC: plain &symbol
+ *     entries, no loader, direct calls).
+ *
+ * Entry format: X(return type, name, (parameter list)).
+ *
+ * If a copy of ogengine.h was included first its types are used and the declarations
+ * here must agree with it (a drifted prototype is a compile error rather than a silent
+ * ABI mismatch). Otherwise this header defines the ABI types itself and marks
+ * ogengine.h as included.
+ *
+ * Scope: this is the ABI of the current NativeAOT client, matching the ogengine.h
+ * shipped with ODOOM, OQuake and OQuake2 and used by OGLib. The placeholder copies in
+ * OQuake3 and OQuake2-RTX and the NativeWrapper header predate it (different
+ * ogengine_queue_monster_kill / ogengine_set_callback signatures, and NativeWrapper has
+ * no ogengine_operation_callback_t). They are not generated from this list and must not
+ * be included in the same translation unit as OGLib.
+ *
+ * Adding an export: add it to the C# client, regenerate ogengine.def, then add one
+ * line to OGENGINE_EXPORTS (and an OGENGINE_HAS_* macro if games need to test for it).
+ */
+#ifndef OGENGINE_EXPORTS_H
+#define OGENGINE_EXPORTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef OGENGINE_H
+#define OGENGINE_H
+
+typedef struct {
+    /* WEB5 STAR API base URI (maps to C# Web5StarApiBaseUrl) */
+    const char* base_url;
+    const char* api_key;
+    const char* avatar_id;
+    int timeout_seconds;
+    /* Optional: which game binary is running (e.g. "ODOOM", "OQUAKE") for cross-game quest tracker rows. NULL = use quest/objective metadata + last progress only. */
+    const char* client_game_source;
+    /* 0 = remote (HTTP WEB5/WEB4). 1 = native in-process OASIS (requires a star_api build that embeds HyperDrive; default library returns OGENGINE_ERROR_INIT_FAILED). */
+    int32_t transport;
+    /* Optional: UTF-8 path to OASIS_DNA.json for native transport (for future native host). */
+    const char* oasis_dna_path;
+} ogengine_config_t;
+
+typedef struct {
+    char id[64];
+    char name[256];
+    char description[512];
+    char game_source[64];
+    char item_type[64];
+    char nft_id[128];  /* NFTId from MetaData when item is linked to NFTHolon; empty when not an NFT item */
+    int quantity;      /* Stack size. API increments if item exists and stack=1; otherwise new item gets this. */
+} ogengine_item_t;
+
+typedef struct {
+    ogengine_item_t* items;
+    size_t count;
+    size_t capacity;
+} ogengine_item_list_t;
+
+typedef enum {
+    OGENGINE_SUCCESS = 0,
+    OGENGINE_ERROR_INIT_FAILED = -1,
+    OGENGINE_ERROR_NOT_INITIALIZED = -2,
+    OGENGINE_ERROR_NETWORK = -3,
+    OGENGINE_ERROR_INVALID_PARAM = -4,
+    OGENGINE_ERROR_API_ERROR = -5
+} ogengine_result_t;
+
+typedef void (*ogengine_callback_t)(ogengine_result_t result, void* user_data);
+
+/** Operation type for ogengine_set_operation_callback. Game can run "profile loaded" only when type is OGENGINE_OP_PROFILE_LOADED. Other values (1-27) identify get_avatar_id, has_item, get_inventory, etc.; see StarApiClient.cs StarApiOp* constants. */
+#define OGENGINE_OP_PROFILE_LOADED 0
+#define OGENGINE_OP_GET_INVENTORY 3
+#define OGENGINE_OP_QUESTS_CACHE_REFRESHED 28
+typedef void (*ogengine_operation_callback_t)(ogengine_result_t result, int operation_type, void* user_data);
+
+#endif /* OGENGINE_H */
+
+#ifndef OGENGINE_HAS_QUEUE_PICKUP_WITH_MINT
+#define OGENGINE_HAS_QUEUE_PICKUP_WITH_MINT 1
+#endif
+#ifndef OGENGINE_HAS_QUEUE_QUEST_PROGRESS_FROM_PICKUP
+#define OGENGINE_HAS_QUEUE_QUEST_PROGRESS_FROM_PICKUP 1
+#endif
+#ifndef OGENGINE_HAS_START_QUEST_THEN_SET_ACTIVE_OBJECTIVE
+#define OGENGINE_HAS_START_QUEST_THEN_SET_ACTIVE_OBJECTIVE 1
+#endif
+#ifndef OGENGINE_HAS_QUEST_OBJECTIVES_CACHE_VERSION
+#define OGENGINE_HAS_QUEST_OBJECTIVES_CACHE_VERSION 1
+#endif
+#ifndef OGENGINE_HAS_CONSUME_LAST_MINT
+#define OGENGINE_HAS_CONSUME_LAST_MINT 1
+#endif
+#ifndef OGENGINE_HAS_CONSUME_LAST_BACKGROUND_ERROR
+#define OGENGINE_HAS_CONSUME_LAST_BACKGROUND_ERROR 1
+#endif
+
+/* Every OGEngineClient export. Documentation for each call lives in ogengine.h. */
+#define OGENGINE_EXPORTS(X) \
+    /* Lifecycle, auth and session */ \
+    X(ogengine_result_t, ogengine_init, (const ogengine_config_t* config)) \
+    X(void, ogengine_set_quest_progress_cache_refresh, (int mode)) \
+    X(ogengine_result_t, ogengine_authenticate, (const char* username, const char* password)) \
+    X(ogengine_result_t, ogengine_authenticate_with_jwt_out, (const char* username, const char* password, char* jwt_buf, size_t jwt_size)) \
+    X(ogengine_result_t, ogengine_set_saved_session, (const char* jwt)) \
+    X(ogengine_result_t, ogengine_restore_session, (void)) \
+    X(int, ogengine_get_current_username, (char* buf, size_t buf_size)) \
+    X(int, ogengine_get_current_jwt, (char* buf, size_t buf_size)) \
+    X(void, ogengine_set_refresh_token, (const char* refresh_token)) \
+    X(int, ogengine_get_current_refresh_token, (char* buf, size_t buf_size)) \
+    X(int, ogengine_is_session_expired, (void)) \
+    X(ogengine_result_t, ogengine_set_oasis_base_url, (const char* oasis_base_url)) \
+    X(void, ogengine_cleanup, (void)) \
+    /* Inventory */ \
+    X(bool, ogengine_has_item, (const char* item_name)) \
+    X(ogengine_result_t, ogengine_get_inventory, (ogengine_item_list_t** item_list)) \
+    X(void, ogengine_request_inventory_in_background, (void)) \
+    X(void, ogengine_invalidate_inventory_cache, (void)) \
+    X(void, ogengine_clear_cache, (void)) \
+    X(void, ogengine_free_item_list, (ogengine_item_list_t* item_list)) \
+    X(ogengine_result_t, ogengine_add_item, (const char* item_name, const char* description, const char* game_source, const char* item_type, const char* nft_id, int quantity, int stack)) \
+    X(ogengine_result_t, ogengine_mint_inventory_nft, (const char* item_name, const char* description, const char* game_source, const char* item_type, const char* provider, char* nft_id_out, char* hash_out, const char* send_to_address_after_minting)) \
+    X(bool, ogengine_use_item, (const char* item_name, const char* context)) \
+    X(void, ogengine_queue_add_item, (const char* item_name, const char* description, const char* game_source, const char* item_type, const char* nft_id, int quantity, int stack)) \
+    X(void, ogengine_queue_pickup_with_mint, (const char* item_name, const char* description, const char* game_source, const char* item_type, int do_mint, const char* provider, const char* send_to_address_after_minting, int quantity)) \
+    X(void, ogengine_queue_quest_progress_from_pickup, (const char* game_source, const char* item_type, const char* item_name)) \
+    X(ogengine_result_t, ogengine_flush_add_item_jobs, (void)) \
+    X(void, ogengine_queue_use_item, (const char* item_name, const char* context)) \
+    X(ogengine_result_t, ogengine_flush_use_item_jobs, (void)) \
+    /* Quests */ \
+    X(ogengine_result_t, ogengine_start_quest, (const char* quest_id)) \
+    X(ogengine_result_t, ogengine_start_quest_then_set_active_objective, (const char* quest_id, const char* objective_id)) \
+    X(ogengine_result_t, ogengine_complete_quest_objective, (const char* quest_id, const char* objective_id, const char* game_source)) \
+    X(ogengine_result_t, ogengine_complete_quest, (const char* quest_id)) \
+    X(int, ogengine_get_quests_string, (char* buf, size_t buf_size)) \
+    X(int, ogengine_get_top_level_quests_string, (char* buf, size_t buf_size)) \
+    X(int, ogengine_get_tracker_quest_name, (char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_sub_quests_string, (const char* parent_quest_id, char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_objectives_string, (const char* parent_quest_id, char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_objectives_cache_version, (void)) \
+    X(int, ogengine_get_quest_prereqs_string, (const char* quest_id, char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_objective_requirements_string, (const char* quest_id, const char* objective_id, char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_tracker_objectives_string, (const char* quest_id, char* buf, size_t buf_size)) \
+    X(int, ogengine_get_quest_tracker_active_objective_index, (const char* quest_id)) \
+    X(void, ogengine_invalidate_quest_cache, (void)) \
+    X(void, ogengine_refresh_quest_cache_in_background, (void)) \
+    X(void, ogengine_set_quest_popup_open, (int is_open)) \
+    /* NFTs, avatar and XP */ \
+    X(ogengine_result_t, ogengine_create_monster_nft, (const char* monster_name, const char* description, const char* game_source, const char* monster_stats, const char* provider, char* nft_id_out)) \
+    X(ogengine_result_t, ogengine_deploy_boss_nft, (const char* nft_id, const char* target_game, const char* location)) \
+    X(ogengine_result_t, ogengine_get_avatar_id, (char* avatar_id_out, size_t avatar_id_size)) \
+    X(ogengine_result_t, ogengine_set_avatar_id, (const char* avatar_id)) \
+    X(ogengine_result_t, ogengine_send_item_to_avatar, (const char* target_username_or_avatar_id, const char* item_name, int quantity, const char* item_id)) \
+    X(ogengine_result_t, ogengine_send_item_to_clan, (const char* clan_name_or_target, const char* item_name, int quantity, const char* item_id)) \
+    X(void, ogengine_queue_add_xp, (int amount)) \
+    X(void, ogengine_queue_monster_kill, (const char* engine_name, const char* display_name, int xp, int is_boss, int do_mint, const char* provider, const char* game_source)) \
+    X(void, ogengine_queue_quest_level_time, (const char* game_source, int level_elapsed_seconds)) \
+    X(int, ogengine_get_avatar_xp, (int* xp_out)) \
+    X(int, ogengine_get_avatar_karma, (long* karma_out)) \
+    X(void, ogengine_refresh_avatar_profile, (void)) \
+    X(int, ogengine_get_active_quest_id, (char* buf, size_t buf_size)) \
+    X(int, ogengine_get_active_objective_id, (char* buf, size_t buf_size)) \
+    X(ogengine_result_t, ogengine_set_active_quest, (const char* quest_id, const char* objective_id)) \
+    /* Errors, logging and callbacks */ \
+    X(const char*, ogengine_get_last_error, (void)) \
+    X(int, ogengine_consume_last_mint_result, (char* item_name_out, size_t item_name_size, char* nft_id_out, size_t nft_id_size, char* hash_out, size_t hash_size)) \
+    X(int, ogengine_consume_last_background_error, (char* buf, size_t size)) \
+    X(int, ogengine_consume_console_log, (char* buf, size_t size)) \
+    X(void, ogengine_log_to_file, (const char* message)) \
+    X(void, ogengine_set_debug, (int enabled)) \
+    X(void, ogengine_set_callback, (ogengine_callback_t callback, void* user_data)) \
+    X(void, ogengine_set_operation_callback, (ogengine_operation_callback_t callback, void* user_data)) \
+    /* Cross-game teleport, spawn, events, grants, portals */ \
+    X(int, ogengine_poll_teleport_request, (char* out_map, size_t map_len, float* out_x, float* out_y, float* out_z)) \
+    X(void, ogengine_confirm_teleport_arrival, (void)) \
+    X(void, ogengine_request_teleport, (const char* target_game, const char* target_map, float x, float y, float z)) \
+    X(int, ogengine_poll_spawn_event, (char* out_entity_id, size_t id_len, float* out_x, float* out_y, float* out_z)) \
+    X(void, ogengine_confirm_spawn, (const char* entity_id)) \
+    X(int, ogengine_poll_cross_game_event, (char* out_json, size_t json_len)) \
+    X(int, ogengine_poll_inventory_grant, (char* out_guid, size_t guid_len)) \
+    X(void, ogengine_notify_portal_unlock, (const char* portal_id))
+
+/* Declarations */
+#define OGENGINE_EXPORT_DECL(ret, name, params) ret name params;
+OGENGINE_EXPORTS(OGENGINE_EXPORT_DECL)
+#undef OGENGINE_EXPORT_DECL
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGENGINE_EXPORTS_H */
@@ -27,8 +27,14 @@
  *   oglib_json.h         — minimal JSON key→value extractor/writer
  *   oglib_config.h       — oasisstar.json load/save; star_config_t struct
  *   oglib_beamin.h       — beamin/beamout workflow (auth, session restore, persist)
- *   oglib_session.h      — runtime DLL forwarders (GetProcAddress / dlsym shims)
+ *   oglib_session.h      — OGEngineClient export vtable (resolved once) + session forwarders
+ *   ogengine_exports.h   — OGENGINE_EXPORTS manifest: ABI types + every client export
  *   oglib_crossgame.h    — cross-game ammo/weapon mapping defaults
+ *   oglib_events.h       — batched, pre-parsed cross-game spawn/objective event drain (OGLIB_EVENTS_IMPL)
+ *   oglib_log.h          — printf-style logger; optional async ring buffer (OGLIB_LOG_IMPL)
+ *   oglib_atomic.h       — portable atomics used by the lock-free queues
+ *   oglib_time.h         — monotonic microsecond clock (OGLIB_TIME_IMPL, implied by OGLIB_LOG_IMPL)
+ *   oglib_trace.h        — Chrome/Perfetto trace recorder (OGLIB_TRACE_ENABLE / _IMPL)
  *
  * See OGLib/README.md and OASIS Omniverse/ARCHITECTURE.md for full docs.
  */
@@ -36,9 +42,11 @@
 #define OGLIB_H
 
 #include "oglib_log.h"
+#include "oglib_trace.h"
 #include "oglib_str.h"
 #include "oglib_json.h"
 #include "oglib_crossgame.h"
+#include "oglib_events.h"
 #include "oglib_monster.h"
 #include "oglib_session.h"
 #include "oglib_config.h"
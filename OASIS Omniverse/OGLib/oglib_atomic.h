@@ -0,0 +1,77 @@
+/**
+ * oglib_atomic.h — OGLib portable atomics
+ *
+ * Minimal atomic load/store/CAS/add helpers that compile as C99 and C++ on
+ * MSVC (Interlocked* intrinsics) and GCC/Clang (__atomic builtins). Used by
+ * the lock-free queues in oglib_log.h and oglib_trace.h, which must be
+ * includable from both C engines (OQuake) and C++ engines (ODOOM) without
+ * depending on <stdatomic.h> or <atomic>.
+ *
+ * All operations are sequentially consistent except the explicit
+ * *_relaxed / *_acquire / *_release variants.
+ */
+#ifndef OGLIB_ATOMIC_H
+#define OGLIB_ATOMIC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+typedef volatile long          oglib_atomic32_t;
+typedef volatile long long     oglib_atomic64_t;
+
+static inline long oglib_atomic32_load_relaxed(oglib_atomic32_t* p) { return *p; }
+static inline long oglib_atomic32_load_acquire(oglib_atomic32_t* p) { long v = *p; _ReadWriteBarrier(); return v; }
+static inline void oglib_atomic32_store_release(oglib_atomic32_t* p, long v) { _ReadWriteBarrier(); *p = v; }
+static inline long oglib_atomic32_add(oglib_atomic32_t* p, long v) { return _InterlockedExchangeAdd(p, v) + v; }
+static inline long oglib_atomic32_exchange(oglib_atomic32_t* p, long v) { return _InterlockedExchange(p, v); }
+static inline int  oglib_atomic32_cas(oglib_atomic32_t* p, long expected, long desired)
+{
+    return _InterlockedCompareExchange(p, desired, expected) == expected;
+}
+
+static inline long long oglib_atomic64_load_relaxed(oglib_atomic64_t* p) { return *p; }
+static inline long long oglib_atomic64_load_acquire(oglib_atomic64_t* p) { long long v = *p; _ReadWriteBarrier(); return v; }
+static inline void oglib_atomic64_store_release(oglib_atomic64_t* p, long long v) { _ReadWriteBarrier(); *p = v; }
+static inline long long oglib_atomic64_add(oglib_atomic64_t* p, long long v) { return _InterlockedExchangeAdd64(p, v) + v; }
+static inline int oglib_atomic64_cas(oglib_atomic64_t* p, long long expected, long long desired)
+{
+    return _InterlockedCompareExchange64(p, desired, expected) == expected;
+}
+
+#else /* GCC / Clang */
+
+typedef volatile int32_t oglib_atomic32_t;
+typedef volatile int64_t oglib_atomic64_t;
+
+static inline int32_t oglib_atomic32_load_relaxed(oglib_atomic32_t* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline int32_t oglib_atomic32_load_acquire(oglib_atomic32_t* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void    oglib_atomic32_store_release(oglib_atomic32_t* p, int32_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static inline int32_t oglib_atomic32_add(oglib_atomic32_t* p, int32_t v) { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+static inline int32_t oglib_atomic32_exchange(oglib_atomic32_t* p, int32_t v) { return __atomic_exchange_n(p, v, __ATOMIC_SEQ_CST); }
+static inline int     oglib_atomic32_cas(oglib_atomic32_t* p, int32_t expected, int32_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static inline int64_t oglib_atomic64_load_relaxed(oglib_atomic64_t* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline int64_t oglib_atomic64_load_acquire(oglib_atomic64_t* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void    oglib_atomic64_store_release(oglib_atomic64_t* p, int64_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static inline int64_t oglib_atomic64_add(oglib_atomic64_t* p, int64_t v) { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+static inline int     oglib_atomic64_cas(oglib_atomic64_t* p, int64_t expected, int64_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+#endif /* _MSC_VER / GCC */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGLIB_ATOMIC_H */
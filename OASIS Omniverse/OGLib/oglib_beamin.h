@@ -4,11 +4,26 @@
  * Implements the standard "beam in" and "beam out" sequences that every OASIS game
  * needs. Both ODOOM and OQuake perform the same steps; this centralises them.
  *
- * Beamin sequence:
+ * Beamin is a small state machine driven from the game's main thread:
+ *
+ *   IDLE ──start──▶ AUTHENTICATING ──auth ok──▶ PREFETCHING ──all landed──▶ READY
+ *   IDLE ──restore─▶ RESTORING (GET avatar/current + prefetch in flight) ─┘
+ *   any in-flight state ──error / timeout──▶ FAILED
+ *
  *   1. ogengine_sync_auth_start(username, password, ...)  — async auth via star_sync
- *   2. On auth success: ogengine_request_inventory_in_background()
- *   3. Persist JWT + refresh token + username to oasisstar.json via oglib_config
- *   4. Invoke game callback so the game can update its HUD/console
+ *   2. On auth success persist JWT + refresh token + username to oasisstar.json
+ *   3. Launch profile (active quest), avatar stats (XP, karma), inventory and
+ *      top-level quest fetches together, so the HUD fills after one round trip
+ *   4. Invoke the game callback once every fetch has reported (or timed out)
+ *
+ * Session restore uses the same machine with every fetch alongside the restore
+ * request. done_cb fires when all of them have reported, or as soon as the client
+ * rejects the JWT (failure, session cleared).
+ *
+ * Wiring: forward the game's ogengine_operation_callback_t to oglib_beamin_on_operation
+ * (any thread) and call oglib_beamin_poll once per frame after ogengine_sync_pump.
+ * Games that run their own auth or restore (ODOOM, OQuake) enter the machine with
+ * oglib_beamin_begin and launch the fetches with oglib_beamin_prefetch.
  *
  * Beamout sequence:
  *   1. ogengine_cleanup()
@@ -29,6 +44,7 @@
 #define OGLIB_BEAMIN_H
 
 #include "oglib_config.h"
+#include "oglib_atomic.h"
 #include "ogengine.h"
 #include "ogengine_sync.h"
 
@@ -45,6 +61,30 @@ typedef enum {
     OGLIB_BEAMIN_TIMEOUT = 2
 } oglib_beamin_result_t;
 
+/**
+ * Beamin state (oglib_beamin_ctx_t.state).
+ */
+typedef enum {
+    OGLIB_BEAMIN_STATE_IDLE           = 0,
+    OGLIB_BEAMIN_STATE_AUTHENTICATING = 1,
+    OGLIB_BEAMIN_STATE_RESTORING      = 2,
+    OGLIB_BEAMIN_STATE_PREFETCHING    = 3,
+    OGLIB_BEAMIN_STATE_READY          = 4,
+    OGLIB_BEAMIN_STATE_FAILED         = 5
+} oglib_beamin_state_t;
+
+/** Prefetch bits for oglib_beamin_prefetch and oglib_beamin_ctx_t.pending. */
+#define OGLIB_BEAMIN_FETCH_PROFILE   0x1  /* active quest/objective (OGENGINE_OP_PROFILE_LOADED) */
+#define OGLIB_BEAMIN_FETCH_INVENTORY 0x2  /* OGENGINE_OP_GET_INVENTORY */
+#define OGLIB_BEAMIN_FETCH_QUESTS    0x4  /* top-level quest cache (OGENGINE_OP_QUESTS_CACHE_REFRESHED) */
+#define OGLIB_BEAMIN_FETCH_STATS     0x8  /* XP + karma; the client has no separate stats op, landed once ogengine_get_avatar_xp is valid */
+#define OGLIB_BEAMIN_FETCH_ALL       0xF
+
+/** Default time to wait for auth / restore / prefetch before giving up. */
+#ifndef OGLIB_BEAMIN_TIMEOUT_MS
+#define OGLIB_BEAMIN_TIMEOUT_MS 15000
+#endif
+
 /**
  * Callback signature for beamin completion.
  * @param result   Whether beamin succeeded.
@@ -67,20 +107,26 @@ typedef void (*oglib_beamout_done_fn)(void* user);
 typedef struct {
     star_config_t*          config;         /* shared config; session fields updated on success */
     const char*             config_path;    /* path to oasisstar.json for session persist */
-    oglib_beamin_done_fn done_cb;        /* called when auth + profile complete */
+    oglib_beamin_done_fn    done_cb;        /* called when auth + prefetch complete (or failed) */
     void*                   done_user;      /* passed through to done_cb */
+    int                     timeout_ms;     /* 0 = OGLIB_BEAMIN_TIMEOUT_MS */
     char                    username[256];  /* internal: copy of username for callback */
+    /* internal state; read-only for the game */
+    oglib_beamin_state_t    state;
+    oglib_atomic32_t        pending;        /* OGLIB_BEAMIN_FETCH_* bits still in flight */
+    oglib_atomic32_t        failed;         /* OGLIB_BEAMIN_FETCH_* bits that reported an error */
+    int64_t                 deadline_ms;
 } oglib_beamin_ctx_t;
 
 /**
  * Start the async beamin sequence.
- * Returns immediately; done_cb fires on the star_sync pump thread.
+ * Returns immediately; done_cb fires from oglib_beamin_poll on the main thread.
  * ctx must remain valid until done_cb fires.
  *
  * @param ctx       Pre-filled context (config, config_path, done_cb, done_user).
  * @param username  OASIS avatar username.
  * @param password  OASIS avatar password.
- * @return          1 if auth was queued, 0 on error (e.g. already beamed in).
+ * @return          1 if auth was queued, 0 on error (e.g. a beamin is already in flight).
  */
 int oglib_beamin_start(oglib_beamin_ctx_t* ctx,
                            const char* username, const char* password);
@@ -88,13 +134,58 @@ int oglib_beamin_start(oglib_beamin_ctx_t* ctx,
 /**
  * Restore a previously saved session (JWT) from config.
  * Calls ogengine_set_saved_session, ogengine_set_refresh_token, then
- * ogengine_restore_session (async). done_cb fires when the REST validation
- * (GET /avatar/current) completes.
+ * ogengine_restore_session (async) with every prefetch alongside.
+ * done_cb fires when the REST validation (GET /avatar/current) and the
+ * prefetches complete; on rejection the saved session is cleared.
  *
  * @param ctx  Context with config already populated from oglib_config_load.
+ * @return     1 if the restore was started, 0 if there is no saved JWT or it was rejected locally.
  */
 int oglib_beamin_restore_session(oglib_beamin_ctx_t* ctx);
 
+/**
+ * Enter the state machine for a beam-in the game drives itself.
+ *   OGLIB_BEAMIN_STATE_PREFETCHING — the game's own auth just succeeded.
+ *   OGLIB_BEAMIN_STATE_RESTORING   — call before the game's ogengine_restore_session;
+ *                                    a profile failure then means the JWT was rejected.
+ * Arms every OGLIB_BEAMIN_FETCH_* bit and the timeout; it sends nothing, so follow it
+ * with oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL) (or oglib_beamin_reset if the
+ * restore could not be started). done_cb fires from oglib_beamin_poll.
+ *
+ * @return 1 if armed, 0 if a beamin is already in flight or state is not one of the two above.
+ */
+int oglib_beamin_begin(oglib_beamin_ctx_t* ctx, oglib_beamin_state_t state, const char* username);
+
+/**
+ * Drop an in-flight beamin without firing done_cb (e.g. the player beamed out).
+ */
+void oglib_beamin_reset(oglib_beamin_ctx_t* ctx);
+
+/**
+ * Feed client operation completions into the state machine. Call from the game's
+ * ogengine_operation_callback_t (safe on the client thread; only updates atomics).
+ */
+void oglib_beamin_on_operation(oglib_beamin_ctx_t* ctx, ogengine_result_t result, int operation_type);
+
+/**
+ * Advance the state machine; fires done_cb. Call once per frame on the main thread,
+ * after ogengine_sync_pump. Returns the current state.
+ */
+oglib_beamin_state_t oglib_beamin_poll(oglib_beamin_ctx_t* ctx);
+
+/**
+ * Launch the selected OGLIB_BEAMIN_FETCH_* requests at once. Non-blocking; results
+ * arrive through the operation callback. Profile and stats share one GET
+ * (ogengine_refresh_avatar_profile), so asking for both sends it once.
+ */
+static inline void oglib_beamin_prefetch(int fetch_mask)
+{
+    if (fetch_mask & (OGLIB_BEAMIN_FETCH_PROFILE | OGLIB_BEAMIN_FETCH_STATS))
+        ogengine_refresh_avatar_profile();
+    if (fetch_mask & OGLIB_BEAMIN_FETCH_INVENTORY) ogengine_request_inventory_in_background();
+    if (fetch_mask & OGLIB_BEAMIN_FETCH_QUESTS)    ogengine_refresh_quest_cache_in_background();
+}
+
 /**
  * Perform the beamout sequence synchronously.
  * Clears in-memory session state; if the session expired, clears jwt_token
@@ -108,26 +199,75 @@ void oglib_beamout(star_config_t* cfg, const char* config_path,
 #ifdef OGLIB_BEAMIN_IMPL
 
 #include "oglib_str.h"
+#include "oglib_time.h"
+#include "oglib_trace.h"
 #include <string.h>
 #include <stdio.h>
 
-/* Internal: star_sync auth callback */
-static void oglib_beamin_auth_done(ogengine_result_t result,
-                                       const char* error_msg, void* user)
+static void oglib_beamin_finish(oglib_beamin_ctx_t* ctx, oglib_beamin_state_t state,
+                                oglib_beamin_result_t result)
 {
-    oglib_beamin_ctx_t* ctx = (oglib_beamin_ctx_t*)user;
-    if (!ctx) return;
+    ctx->state = state;
+    OGLIB_TRACE_INSTANT(state == OGLIB_BEAMIN_STATE_READY ? "oglib_beamin ready" : "oglib_beamin failed", "oglib");
+    if (ctx->done_cb)
+        ctx->done_cb(result, result == OGLIB_BEAMIN_OK && ctx->username[0] ? ctx->username : NULL,
+                     ctx->done_user);
+}
 
-    if (result != OGENGINE_SUCCESS) {
-        if (ctx->done_cb)
-            ctx->done_cb(OGLIB_BEAMIN_FAILED, NULL, ctx->done_user);
+static void oglib_beamin_arm(oglib_beamin_ctx_t* ctx, oglib_beamin_state_t state, int pending)
+{
+    ctx->state = state;
+    oglib_atomic32_exchange(&ctx->failed, 0);
+    oglib_atomic32_exchange(&ctx->pending, pending);
+    ctx->deadline_ms = oglib_time_now_ms() + (ctx->timeout_ms > 0 ? ctx->timeout_ms : OGLIB_BEAMIN_TIMEOUT_MS);
+}
+
+static int oglib_beamin_in_flight(const oglib_beamin_ctx_t* ctx)
+{
+    return ctx->state >= OGLIB_BEAMIN_STATE_AUTHENTICATING && ctx->state <= OGLIB_BEAMIN_STATE_PREFETCHING;
+}
+
+/* Clear bits from pending (and record them in failed) against concurrent on_operation calls. */
+static void oglib_beamin_land(oglib_beamin_ctx_t* ctx, int bits, int failed)
+{
+    if (failed)
+        for (;;) {
+            int32_t f = (int32_t)oglib_atomic32_load_acquire(&ctx->failed);
+            if (oglib_atomic32_cas(&ctx->failed, f, f | bits)) break;
+        }
+    for (;;) {
+        int32_t p = (int32_t)oglib_atomic32_load_acquire(&ctx->pending);
+        if (!(p & bits) || oglib_atomic32_cas(&ctx->pending, p, p & ~bits)) break;
+    }
+}
+
+/* Internal: star_sync auth callback (main thread, from ogengine_sync_pump) */
+static void oglib_beamin_auth_done(void* user)
+{
+    oglib_beamin_ctx_t* ctx = (oglib_beamin_ctx_t*)user;
+    int success = 0;
+    char username[256] = {0};
+    char avatar_id[64] = {0};
+    char error_msg[256] = {0};
+    if (!ctx || ctx->state != OGLIB_BEAMIN_STATE_AUTHENTICATING) return;
+    OGLIB_TRACE_INSTANT("oglib_beamin auth done", "oglib");
+
+    if (!ogengine_sync_auth_get_result(&success, username, sizeof(username),
+                                       avatar_id, sizeof(avatar_id),
+                                       error_msg, sizeof(error_msg)) || !success) {
+        oglib_beamin_finish(ctx, OGLIB_BEAMIN_STATE_FAILED, OGLIB_BEAMIN_FAILED);
         return;
     }
+    if (username[0])
+        oglib_str_copy(ctx->username, username, sizeof(ctx->username));
 
     /* Persist JWT + refresh token + username */
     if (ctx->config && ctx->config_path) {
-        ogengine_get_current_jwt(ctx->config->jwt_token,
-                                  sizeof(ctx->config->jwt_token));
+        ogengine_sync_auth_get_result_jwt(ctx->config->jwt_token,
+                                          sizeof(ctx->config->jwt_token));
+        if (!ctx->config->jwt_token[0])
+            ogengine_get_current_jwt(ctx->config->jwt_token,
+                                      sizeof(ctx->config->jwt_token));
         ogengine_get_current_refresh_token(ctx->config->refresh_token,
                                             sizeof(ctx->config->refresh_token));
         oglib_str_copy(ctx->config->username, ctx->username,
@@ -135,76 +275,135 @@ static void oglib_beamin_auth_done(ogengine_result_t result,
         oglib_config_save_session(ctx->config_path, ctx->config);
     }
 
-    /* Kick off background inventory fetch */
-    ogengine_request_inventory_in_background();
-
-    if (ctx->done_cb)
-        ctx->done_cb(OGLIB_BEAMIN_OK, ctx->username, ctx->done_user);
+    /* Profile, stats, inventory and quests in parallel */
+    oglib_beamin_arm(ctx, OGLIB_BEAMIN_STATE_PREFETCHING, OGLIB_BEAMIN_FETCH_ALL);
+    oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
 }
 
 int oglib_beamin_start(oglib_beamin_ctx_t* ctx,
                            const char* username, const char* password)
 {
     if (!ctx || !username || !password) return 0;
+    if (oglib_beamin_in_flight(ctx))
+        return 0;
+    OGLIB_TRACE_BEGIN("oglib_beamin_start", "oglib");
     oglib_str_copy(ctx->username, username, sizeof(ctx->username));
+    oglib_beamin_arm(ctx, OGLIB_BEAMIN_STATE_AUTHENTICATING, 0);
     ogengine_sync_auth_start(username, password, oglib_beamin_auth_done, ctx);
+    OGLIB_TRACE_END("oglib_beamin_start", "oglib");
     return 1;
 }
 
-/* Internal: session restore callback via star_sync pump */
-static void oglib_session_restore_done(ogengine_result_t result,
-                                           const char* error_msg, void* user)
+int oglib_beamin_restore_session(oglib_beamin_ctx_t* ctx)
 {
-    oglib_beamin_ctx_t* ctx = (oglib_beamin_ctx_t*)user;
-    if (!ctx) return;
+    if (!ctx || !ctx->config) return 0;
+    if (!ctx->config->jwt_token[0]) return 0;
+    if (oglib_beamin_in_flight(ctx))
+        return 0;
 
-    if (result != OGENGINE_SUCCESS) {
-        /* Expired / invalid — clear session from config so next launch is clean */
-        if (ctx->config && ctx->config_path) {
-            ctx->config->jwt_token[0]     = '\0';
-            ctx->config->refresh_token[0] = '\0';
-            ctx->config->username[0]      = '\0';
-            oglib_config_save_session(ctx->config_path, ctx->config);
-        }
-        if (ctx->done_cb)
-            ctx->done_cb(OGLIB_BEAMIN_FAILED, NULL, ctx->done_user);
-        return;
+    if (ogengine_set_saved_session(ctx->config->jwt_token) != OGENGINE_SUCCESS)
+        return 0;
+    if (ctx->config->refresh_token[0])
+        ogengine_set_refresh_token(ctx->config->refresh_token);
+    oglib_str_copy(ctx->username, ctx->config->username, sizeof(ctx->username));
+
+    /* Armed before the request so a fast OGENGINE_OP_PROFILE_LOADED cannot be lost. */
+    oglib_beamin_arm(ctx, OGLIB_BEAMIN_STATE_RESTORING, OGLIB_BEAMIN_FETCH_ALL);
+    if (ogengine_restore_session() != OGENGINE_SUCCESS) {
+        ctx->state = OGLIB_BEAMIN_STATE_IDLE;
+        return 0;
     }
+    oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+    return 1;
+}
 
-    /* Refresh username from API (may differ from stored) */
-    if (ctx->config)
-        ogengine_get_current_username(ctx->config->username,
-                                       sizeof(ctx->config->username));
+int oglib_beamin_begin(oglib_beamin_ctx_t* ctx, oglib_beamin_state_t state, const char* username)
+{
+    if (!ctx || oglib_beamin_in_flight(ctx)) return 0;
+    if (state != OGLIB_BEAMIN_STATE_PREFETCHING && state != OGLIB_BEAMIN_STATE_RESTORING) return 0;
+    oglib_str_copy(ctx->username, username ? username : "", sizeof(ctx->username));
+    oglib_beamin_arm(ctx, state, OGLIB_BEAMIN_FETCH_ALL);
+    OGLIB_TRACE_INSTANT(state == OGLIB_BEAMIN_STATE_RESTORING ? "oglib_beamin restoring" : "oglib_beamin prefetching", "oglib");
+    return 1;
+}
 
-    ogengine_request_inventory_in_background();
+void oglib_beamin_reset(oglib_beamin_ctx_t* ctx)
+{
+    if (!ctx) return;
+    ctx->state = OGLIB_BEAMIN_STATE_IDLE;
+    oglib_atomic32_exchange(&ctx->pending, 0);
+}
 
-    if (ctx->done_cb)
-        ctx->done_cb(OGLIB_BEAMIN_OK,
-                      ctx->config ? ctx->config->username : NULL,
-                      ctx->done_user);
+void oglib_beamin_on_operation(oglib_beamin_ctx_t* ctx, ogengine_result_t result, int operation_type)
+{
+    int bits;
+    if (!ctx) return;
+    switch (operation_type) {
+    case OGENGINE_OP_PROFILE_LOADED:
+        /* Stats come back on the same GET; poll clears them once XP is readable. */
+        bits = result == OGENGINE_SUCCESS ? OGLIB_BEAMIN_FETCH_PROFILE
+                                          : OGLIB_BEAMIN_FETCH_PROFILE | OGLIB_BEAMIN_FETCH_STATS;
+        break;
+    case OGENGINE_OP_GET_INVENTORY:          bits = OGLIB_BEAMIN_FETCH_INVENTORY; break;
+    case OGENGINE_OP_QUESTS_CACHE_REFRESHED: bits = OGLIB_BEAMIN_FETCH_QUESTS;    break;
+    default: return;
+    }
+    oglib_beamin_land(ctx, bits, result != OGENGINE_SUCCESS);
 }
 
-int oglib_beamin_restore_session(oglib_beamin_ctx_t* ctx)
+oglib_beamin_state_t oglib_beamin_poll(oglib_beamin_ctx_t* ctx)
 {
-    if (!ctx || !ctx->config) return 0;
-    if (!ctx->config->jwt_token[0]) return 0;
+    int32_t pending, failed;
+    if (!ctx) return OGLIB_BEAMIN_STATE_IDLE;
+    if (ctx->state < OGLIB_BEAMIN_STATE_AUTHENTICATING || ctx->state > OGLIB_BEAMIN_STATE_PREFETCHING)
+        return ctx->state;
+
+    pending = (int32_t)oglib_atomic32_load_acquire(&ctx->pending);
+    failed  = (int32_t)oglib_atomic32_load_acquire(&ctx->failed);
+
+    if ((pending & OGLIB_BEAMIN_FETCH_STATS) && !(pending & OGLIB_BEAMIN_FETCH_PROFILE)
+        && ogengine_get_avatar_xp(NULL)) {
+        oglib_beamin_land(ctx, OGLIB_BEAMIN_FETCH_STATS, 0);
+        pending &= ~OGLIB_BEAMIN_FETCH_STATS;
+    }
 
-    ogengine_set_saved_session(ctx->config->jwt_token);
-    if (ctx->config->refresh_token[0])
-        ogengine_set_refresh_token(ctx->config->refresh_token);
+    if (ctx->state == OGLIB_BEAMIN_STATE_RESTORING) {
+        if (failed & OGLIB_BEAMIN_FETCH_PROFILE) {
+            /* Expired / invalid — clear session from config so next launch is clean */
+            if (ctx->config && ctx->config_path) {
+                ctx->config->jwt_token[0]     = '\0';
+                ctx->config->refresh_token[0] = '\0';
+                ctx->config->username[0]      = '\0';
+                oglib_config_save_session(ctx->config_path, ctx->config);
+            }
+            oglib_beamin_finish(ctx, OGLIB_BEAMIN_STATE_FAILED, OGLIB_BEAMIN_FAILED);
+            return ctx->state;
+        }
+        if (!(pending & OGLIB_BEAMIN_FETCH_PROFILE)) {
+            /* Session valid; refresh username from API (may differ from stored) */
+            char username[256] = {0};
+            if (ogengine_get_current_username(username, sizeof(username)) > 0 && username[0]) {
+                oglib_str_copy(ctx->username, username, sizeof(ctx->username));
+                if (ctx->config)
+                    oglib_str_copy(ctx->config->username, username, sizeof(ctx->config->username));
+            }
+            ctx->state = OGLIB_BEAMIN_STATE_PREFETCHING;
+        }
+    }
 
-    /* ogengine_restore_session is async; completion fires via operation callback.
-     * We hook it through ogengine_sync_auth_start with an empty password so the
-     * pump delivers the result the same way. */
-    ogengine_restore_session();
+    if (ctx->state == OGLIB_BEAMIN_STATE_PREFETCHING && pending == 0) {
+        oglib_beamin_finish(ctx, OGLIB_BEAMIN_STATE_READY, OGLIB_BEAMIN_OK);
+        return ctx->state;
+    }
 
-    /* For now call done immediately with a "pending" indication.
-     * The caller should listen for the operation callback. */
-    if (ctx->done_cb)
-        ctx->done_cb(OGLIB_BEAMIN_OK,
-                      ctx->config->username[0] ? ctx->config->username : NULL,
-                      ctx->done_user);
-    return 1;
+    if (oglib_time_now_ms() >= ctx->deadline_ms) {
+        /* A late prefetch only delays HUD data; the session itself is good. */
+        if (ctx->state == OGLIB_BEAMIN_STATE_PREFETCHING)
+            oglib_beamin_finish(ctx, OGLIB_BEAMIN_STATE_READY, OGLIB_BEAMIN_OK);
+        else
+            oglib_beamin_finish(ctx, OGLIB_BEAMIN_STATE_FAILED, OGLIB_BEAMIN_TIMEOUT);
+    }
+    return ctx->state;
 }
 
 void oglib_beamout(star_config_t* cfg, const char* config_path,
@@ -113,6 +113,7 @@ int oglib_config_save_session(const char* path, const star_config_t* cfg);
 
 #include "oglib_json.h"
 #include "oglib_str.h"
+#include "oglib_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -133,8 +134,8 @@ static int oglib_read_int(const char* json, const char* key, int default_val)
 #define READ_BOOL(json, key, def) oglib_read_bool((json),(key),(def))
 #define READ_INT(json, key, def)  oglib_read_int((json),(key),(def))
 
-int oglib_config_load(const char* path, star_config_t* cfg,
-                          oglib_config_ext_fn ext, void* ext_user)
+static int oglib_config_load_file(const char* path, star_config_t* cfg,
+                                  oglib_config_ext_fn ext, void* ext_user)
 {
     if (!path || !cfg) return 0;
 
@@ -196,6 +197,16 @@ int oglib_config_load(const char* path, star_config_t* cfg,
     return 1;
 }
 
+int oglib_config_load(const char* path, star_config_t* cfg,
+                          oglib_config_ext_fn ext, void* ext_user)
+{
+    int ok;
+    OGLIB_TRACE_BEGIN("oglib_config_load", "oglib");
+    ok = oglib_config_load_file(path, cfg, ext, ext_user);
+    OGLIB_TRACE_END("oglib_config_load", "oglib");
+    return ok;
+}
+
 #define WRITE_STR_FIELD(f, key, val, comma) \
     fprintf((f), "    \"%s\": \"%s\"%s\n", (key), (val) ? (val) : "", (comma) ? "," : "")
 #define WRITE_BOOL_FIELD(f, key, val, comma) \
@@ -203,8 +214,8 @@ int oglib_config_load(const char* path, star_config_t* cfg,
 #define WRITE_INT_FIELD(f, key, val, comma) \
     fprintf((f), "    \"%s\": %d%s\n", (key), (val), (comma) ? "," : "")
 
-int oglib_config_save(const char* path, const star_config_t* cfg,
-                          oglib_config_ext_fn ext, void* ext_user)
+static int oglib_config_save_file(const char* path, const star_config_t* cfg,
+                                  oglib_config_ext_fn ext, void* ext_user)
 {
     if (!path || !cfg) return 0;
     FILE* f = fopen(path, "w");
@@ -250,6 +261,16 @@ int oglib_config_save(const char* path, const star_config_t* cfg,
     return 1;
 }
 
+int oglib_config_save(const char* path, const star_config_t* cfg,
+                          oglib_config_ext_fn ext, void* ext_user)
+{
+    int ok;
+    OGLIB_TRACE_BEGIN("oglib_config_save", "oglib");
+    ok = oglib_config_save_file(path, cfg, ext, ext_user);
+    OGLIB_TRACE_END("oglib_config_save", "oglib");
+    return ok;
+}
+
 int oglib_config_save_session(const char* path, const star_config_t* cfg)
 {
     if (!path || !cfg) return 0;
@@ -0,0 +1,211 @@
+/**
+ * oglib_events.h — OGLib batched cross-game event drain
+ *
+ * The client queues cross-game spawns and objective events (ShowNarration,
+ * PlayAudio, PlayVideo, OpenWebsite, UnlockPortal) for the game to poll.
+ * Spawns come one per ogengine_poll_spawn_event call and the rest as one JSON
+ * object per ogengine_poll_cross_game_event call. oglib_events_drain empties
+ * both queues into an array of typed events in one call, so a whole spawn wave
+ * lands in the same frame. Each event's JSON is scanned once, and every field
+ * the game needs is picked up in that one pass.
+ *
+ *   static oglib_event_t s_events[OGLIB_EVENTS_BATCH];
+ *   int n = oglib_events_drain(s_events, OGLIB_EVENTS_BATCH);
+ *   for (int i = 0; i < n; i++) {
+ *       const oglib_event_t* e = &s_events[i];
+ *       switch (e->kind) {
+ *       case OGLIB_EVENT_SPAWN:     SpawnAt(e->id, e->x, e->y, e->z); ogengine_confirm_spawn(e->id); break;
+ *       case OGLIB_EVENT_NARRATION: ShowToast(e->text); break;
+ *       ...
+ *       }
+ *   }
+ *
+ * Events that do not fit in max stay queued in the client for the next call.
+ * Unknown event types are dropped. Main thread only, like the polls.
+ *
+ * USAGE
+ * -----
+ * In exactly ONE .c/.cpp:
+ *
+ *   #define OGLIB_EVENTS_IMPL
+ *   #include "oglib_events.h"
+ *
+ * All other files just include it without the define.
+ */
+#ifndef OGLIB_EVENTS_H
+#define OGLIB_EVENTS_H
+
+#include "ogengine_exports.h"  /* ogengine_poll_spawn_event, ogengine_poll_cross_game_event */
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Suggested batch size for a game's static event array. */
+#define OGLIB_EVENTS_BATCH 32
+
+typedef enum {
+    OGLIB_EVENT_NONE = 0,
+    OGLIB_EVENT_SPAWN,          /* id = entity id, x/y/z = position (all 0: game picks) */
+    OGLIB_EVENT_NARRATION,      /* text */
+    OGLIB_EVENT_AUDIO,          /* url, title */
+    OGLIB_EVENT_VIDEO,          /* url, title */
+    OGLIB_EVENT_WEBSITE,        /* url */
+    OGLIB_EVENT_PORTAL_UNLOCK   /* id = portal id */
+} oglib_event_kind_t;
+
+typedef struct oglib_event_s {
+    oglib_event_kind_t kind;
+    float x, y, z;
+    char id[128];
+    char title[128];
+    char url[512];
+    char text[512];
+} oglib_event_t;
+
+/** Drain pending spawns, then pending cross-game events, into out[0..max). Returns how many were written. */
+int oglib_events_drain(oglib_event_t* out, int max);
+/** Parse one ogengine_poll_cross_game_event JSON object into *out. Returns 1 for a known event type, 0 otherwise. */
+int oglib_events_parse(const char* json, oglib_event_t* out);
+
+/* ── Implementation (compiled once, in the TU that defines OGLIB_EVENTS_IMPL) ── */
+
+#ifdef OGLIB_EVENTS_IMPL
+
+#include <string.h>
+
+/* Largest event JSON the client hands out; longer ones are truncated by the poll. */
+#ifndef OGLIB_EVENTS_JSON_MAX
+#define OGLIB_EVENTS_JSON_MAX 4096
+#endif
+
+static const struct { const char* name; oglib_event_kind_t kind; } g_oglib_event_types[] = {
+    { "ShowNarration", OGLIB_EVENT_NARRATION },
+    { "PlayAudio",     OGLIB_EVENT_AUDIO },
+    { "PlayVideo",     OGLIB_EVENT_VIDEO },
+    { "OpenWebsite",   OGLIB_EVENT_WEBSITE },
+    { "UnlockPortal",  OGLIB_EVENT_PORTAL_UNLOCK },
+};
+
+/* Keys copied into an event field; every other key is skipped. */
+static const struct { const char* key; size_t offset; size_t size; } g_oglib_event_fields[] = {
+    { "NarrationText", offsetof(oglib_event_t, text),  sizeof(((oglib_event_t*)0)->text) },
+    { "AudioUrl",      offsetof(oglib_event_t, url),   sizeof(((oglib_event_t*)0)->url) },
+    { "AudioTitle",    offsetof(oglib_event_t, title), sizeof(((oglib_event_t*)0)->title) },
+    { "VideoUrl",      offsetof(oglib_event_t, url),   sizeof(((oglib_event_t*)0)->url) },
+    { "VideoTitle",    offsetof(oglib_event_t, title), sizeof(((oglib_event_t*)0)->title) },
+    { "WebsiteUrl",    offsetof(oglib_event_t, url),   sizeof(((oglib_event_t*)0)->url) },
+    { "PortalId",      offsetof(oglib_event_t, id),    sizeof(((oglib_event_t*)0)->id) },
+};
+
+static const char* oglib_events_ws(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+/* p is just past an opening quote. Copies the string into out (NULL = skip), with the
+ * escapes oglib_json_extract handles, and returns the position past the closing quote. */
+static const char* oglib_events_string(const char* p, char* out, size_t size) {
+    size_t n = 0;
+    while (*p && *p != '"') {
+        char c = *p++;
+        if (c == '\\' && *p) {
+            c = *p++;
+            if (c == 'n') c = '\n';
+            else if (c == 't') c = '\t';
+            else if (c == 'r') c = '\r';
+        }
+        if (out && n + 1 < size) out[n++] = c;
+    }
+    if (out && size) out[n] = '\0';
+    return *p == '"' ? p + 1 : p;
+}
+
+/* Skip one value of any type (nested objects and arrays included). */
+static const char* oglib_events_skip_value(const char* p) {
+    int depth = 0;
+    while (*p) {
+        if (*p == '"') {
+            p = oglib_events_string(p + 1, NULL, 0);
+            if (depth == 0) return p;
+            continue;
+        }
+        if (*p == '{' || *p == '[') depth++;
+        else if (*p == '}' || *p == ']') { if (depth == 0) return p; if (--depth == 0) return p + 1; }
+        else if (*p == ',' && depth == 0) return p;
+        p++;
+    }
+    return p;
+}
+
+int oglib_events_parse(const char* json, oglib_event_t* out) {
+    char key[32], type[32];
+    const char* p;
+    size_t i;
+    if (!json || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    type[0] = '\0';
+    p = oglib_events_ws(json);
+    if (*p != '{') return 0;
+    p++;
+    for (;;) {
+        char* field = NULL;
+        size_t field_size = 0;
+        p = oglib_events_ws(p);
+        if (*p != '"') break;
+        p = oglib_events_string(p + 1, key, sizeof(key));
+        p = oglib_events_ws(p);
+        if (*p != ':') break;
+        p = oglib_events_ws(p + 1);
+        if (strcmp(key, "EventType") == 0) {
+            field = type;
+            field_size = sizeof(type);
+        } else {
+            for (i = 0; i < sizeof(g_oglib_event_fields) / sizeof(g_oglib_event_fields[0]); i++) {
+                if (strcmp(key, g_oglib_event_fields[i].key) == 0) {
+                    field = (char*)out + g_oglib_event_fields[i].offset;
+                    field_size = g_oglib_event_fields[i].size;
+                    break;
+                }
+            }
+        }
+        if (field && *p == '"') p = oglib_events_string(p + 1, field, field_size);
+        else p = oglib_events_skip_value(p);
+        p = oglib_events_ws(p);
+        if (*p != ',') break;
+        p++;
+    }
+    for (i = 0; i < sizeof(g_oglib_event_types) / sizeof(g_oglib_event_types[0]); i++) {
+        if (strcmp(type, g_oglib_event_types[i].name) == 0) {
+            out->kind = g_oglib_event_types[i].kind;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int oglib_events_drain(oglib_event_t* out, int max) {
+    static char s_json[OGLIB_EVENTS_JSON_MAX];
+    int n = 0;
+    if (!out) return 0;
+    while (n < max) {
+        oglib_event_t* e = &out[n];
+        if (!ogengine_poll_spawn_event(e->id, sizeof(e->id), &e->x, &e->y, &e->z)) break;
+        e->kind = OGLIB_EVENT_SPAWN;
+        e->title[0] = e->url[0] = e->text[0] = '\0';
+        n++;
+    }
+    while (n < max && ogengine_poll_cross_game_event(s_json, sizeof(s_json))) {
+        if (oglib_events_parse(s_json, &out[n])) n++;
+    }
+    return n;
+}
+
+#endif /* OGLIB_EVENTS_IMPL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGLIB_EVENTS_H */
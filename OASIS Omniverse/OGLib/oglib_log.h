@@ -8,12 +8,40 @@
  *
  * By default output goes to stderr. Override before including oglib.h:
  *   #define OGLIB_LOG_SINK(level, msg)  MyEngineLog(msg)
+ *
+ * ASYNC BACKEND
+ * -------------
+ * Define OGLIB_LOG_ASYNC (and OGLIB_LOG_IMPL in exactly ONE .c/.cpp) to route
+ * oglib_log() through a lock-free MPSC ring buffer. The calling thread only
+ * formats into a ring slot; a background flusher thread writes the lines to a
+ * rotating log file, stderr and/or a line callback (e.g. ogengine_log_to_file).
+ * Consecutive identical lines are collapsed into "repeated N times".
+ *
+ *   oglib_log_async_config_t cfg = { 0 };
+ *   cfg.file_path = "oasis_game.log";
+ *   oglib_log_async_start(&cfg);      // game init
+ *   ...
+ *   oglib_log_async_stop();           // game shutdown; drains the ring
+ *
+ * Lines that are already formatted can be queued with oglib_log_enqueue().
+ * When the ring is full the line is dropped (never blocks the game thread);
+ * see oglib_log_async_dropped(). OGLIB_LOG_SINK is not used in async mode
+ * because the flusher runs off the main thread.
+ *
+ * COMPILE-TIME ELISION
+ * --------------------
+ * OGLIB_LOGD/I/W/E(fmt, ...) compile to nothing (arguments not evaluated)
+ * below OGLIB_LOG_COMPILE_LEVEL, which must be a numeric literal 0-3.
+ * OGLIB_LOG_EVERY_MS(ms, level, fmt, ...) logs at most once per interval per
+ * call site, for hot paths such as per-pickup or per-kill logging.
  */
 #ifndef OGLIB_LOG_H
 #define OGLIB_LOG_H
 
 #include <stdio.h>
 #include <stdarg.h>
+#include "oglib_atomic.h"
+#include "oglib_time.h"
 
 typedef enum {
     OGLIB_LOG_DEBUG = 0,
@@ -28,10 +56,58 @@ static const char* const _oglib_level_str[] = { "DEBUG", "INFO", "WARN", "ERROR"
 #  define OGLIB_LOG_MIN_LEVEL OGLIB_LOG_INFO
 #endif
 
+/* Numeric (preprocessor-visible) floor for the OGLIB_LOGx macros. 0 = keep everything. */
+#ifndef OGLIB_LOG_COMPILE_LEVEL
+#  define OGLIB_LOG_COMPILE_LEVEL 0
+#endif
+
 #ifndef OGLIB_LOG_SINK
 #  define OGLIB_LOG_SINK(level, msg) fprintf(stderr, "[OASIS/%s] %s\n", _oglib_level_str[level], (msg))
 #endif
 
+#ifndef OGLIB_LOG_RING_SLOTS
+#  define OGLIB_LOG_RING_SLOTS 1024   /* must be a power of two */
+#endif
+#ifndef OGLIB_LOG_LINE_MAX
+#  define OGLIB_LOG_LINE_MAX   512
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Called on the flusher thread for every line written (after dedup). */
+typedef void (*oglib_log_line_fn)(oglib_log_level_t level, const char* msg, void* user);
+
+typedef struct {
+    const char*       file_path;          /* NULL = no file output */
+    long              max_file_bytes;     /* rotate when exceeded; 0 = 4 MB */
+    int               max_files;          /* rotated files kept (path.1 .. path.N); 0 = 3 */
+    int               flush_interval_ms;  /* flusher idle sleep; 0 = 10 ms */
+    int               echo_stderr;        /* 1 = also write lines to stderr (see oglib_log_async_set_echo_stderr) */
+    oglib_log_line_fn line_fn;            /* optional; e.g. forward to ogengine_log_to_file */
+    void*             line_user;
+} oglib_log_async_config_t;
+
+/** Start the flusher thread. Returns 1 on success, 0 if already running or the thread failed. Call from the main thread. */
+int  oglib_log_async_start(const oglib_log_async_config_t* cfg);
+/** Stop the flusher thread, write out everything still queued and close the file. */
+void oglib_log_async_stop(void);
+/** Non-zero while the flusher thread is running. */
+int  oglib_log_async_active(void);
+/** Queue an already-formatted line. Returns 1 if queued, 0 if async is not running or the ring is full. */
+int  oglib_log_enqueue(oglib_log_level_t level, const char* msg);
+/** Format into the next free ring slot. Same return value as oglib_log_enqueue. */
+int  oglib_log_enqueuev(oglib_log_level_t level, const char* fmt, va_list ap);
+/** Number of lines dropped because the ring was full since oglib_log_async_start. */
+long oglib_log_async_dropped(void);
+/** Turn the stderr echo on or off while running (e.g. with the game's debug-logging toggle). Any thread. */
+void oglib_log_async_set_echo_stderr(int on);
+
+#ifdef __cplusplus
+}
+#endif
+
 static void oglib_log(oglib_log_level_t level, const char* fmt, ...)
 #if defined(__GNUC__) || defined(__clang__)
     __attribute__((format(printf, 2, 3)))
@@ -43,10 +119,332 @@ static void oglib_log(oglib_log_level_t level, const char* fmt, ...)
     char _oglib_buf[1024];
     va_list ap;
     if (level < OGLIB_LOG_MIN_LEVEL) return;
+#ifdef OGLIB_LOG_ASYNC
+    if (oglib_log_async_active()) {
+        va_start(ap, fmt);
+        oglib_log_enqueuev(level, fmt, ap);
+        va_end(ap);
+        return;
+    }
+#endif
     va_start(ap, fmt);
     vsnprintf(_oglib_buf, sizeof(_oglib_buf), fmt, ap);
     va_end(ap);
     OGLIB_LOG_SINK(level, _oglib_buf);
 }
 
+#if OGLIB_LOG_COMPILE_LEVEL <= 0
+#  define OGLIB_LOGD(...) oglib_log(OGLIB_LOG_DEBUG, __VA_ARGS__)
+#else
+#  define OGLIB_LOGD(...) ((void)0)
+#endif
+#if OGLIB_LOG_COMPILE_LEVEL <= 1
+#  define OGLIB_LOGI(...) oglib_log(OGLIB_LOG_INFO, __VA_ARGS__)
+#else
+#  define OGLIB_LOGI(...) ((void)0)
+#endif
+#if OGLIB_LOG_COMPILE_LEVEL <= 2
+#  define OGLIB_LOGW(...) oglib_log(OGLIB_LOG_WARN, __VA_ARGS__)
+#else
+#  define OGLIB_LOGW(...) ((void)0)
+#endif
+#if OGLIB_LOG_COMPILE_LEVEL <= 3
+#  define OGLIB_LOGE(...) oglib_log(OGLIB_LOG_ERROR, __VA_ARGS__)
+#else
+#  define OGLIB_LOGE(...) ((void)0)
+#endif
+
+/* Per-call-site rate limit: the first caller past the deadline wins the CAS and logs. */
+#define OGLIB_LOG_EVERY_MS(interval_ms, level, ...) do { \
+    static oglib_atomic64_t _oglib_rl_next = 0; \
+    int64_t _oglib_rl_now = oglib_time_now_ms(); \
+    int64_t _oglib_rl_due = oglib_atomic64_load_relaxed(&_oglib_rl_next); \
+    if (_oglib_rl_now >= _oglib_rl_due && \
+        oglib_atomic64_cas(&_oglib_rl_next, _oglib_rl_due, _oglib_rl_now + (interval_ms))) \
+        oglib_log((level), __VA_ARGS__); \
+} while (0)
+
+/* ── Implementation (compiled once, in the TU that defines OGLIB_LOG_IMPL) ── */
+
+#ifdef OGLIB_LOG_IMPL
+
+#include <string.h>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+typedef struct {
+    oglib_atomic64_t seq;   /* slot ticket (Vyukov bounded queue) */
+    int              level;
+    char             text[OGLIB_LOG_LINE_MAX];
+} oglib_log_slot_t;
+
+static oglib_log_slot_t         g_oglib_log_ring[OGLIB_LOG_RING_SLOTS];
+static oglib_atomic64_t         g_oglib_log_head = 0;     /* next ticket for producers */
+static int64_t                  g_oglib_log_tail = 0;     /* flusher only */
+static oglib_atomic32_t         g_oglib_log_running = 0;
+static oglib_atomic32_t         g_oglib_log_dropped = 0;
+static oglib_atomic32_t         g_oglib_log_echo = 0;     /* cfg.echo_stderr, changeable at runtime */
+static oglib_log_async_config_t g_oglib_log_cfg;
+static FILE*                    g_oglib_log_file = NULL;
+static long                     g_oglib_log_file_bytes = 0;
+static char                     g_oglib_log_last[OGLIB_LOG_LINE_MAX];
+static int                      g_oglib_log_last_level = -1;
+static long                     g_oglib_log_repeats = 0;
+static int64_t                  g_oglib_log_last_write_ms = 0;
+#ifdef _WIN32
+static HANDLE                   g_oglib_log_thread = NULL;
+#else
+static pthread_t                g_oglib_log_thread;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int oglib_log_async_active(void)
+{
+    return oglib_atomic32_load_acquire(&g_oglib_log_running) != 0;
+}
+
+long oglib_log_async_dropped(void)
+{
+    return (long)oglib_atomic32_load_relaxed(&g_oglib_log_dropped);
+}
+
+void oglib_log_async_set_echo_stderr(int on)
+{
+    oglib_atomic32_store_release(&g_oglib_log_echo, on ? 1 : 0);
+}
+
+/* Claim a slot; returns NULL when the ring is full. */
+static oglib_log_slot_t* oglib_log_claim(int64_t* ticket_out)
+{
+    int64_t pos = oglib_atomic64_load_relaxed(&g_oglib_log_head);
+    for (;;) {
+        oglib_log_slot_t* slot = &g_oglib_log_ring[pos & (OGLIB_LOG_RING_SLOTS - 1)];
+        int64_t diff = oglib_atomic64_load_acquire(&slot->seq) - pos;
+        if (diff == 0) {
+            if (oglib_atomic64_cas(&g_oglib_log_head, pos, pos + 1)) {
+                *ticket_out = pos;
+                return slot;
+            }
+        } else if (diff < 0) {
+            oglib_atomic32_add(&g_oglib_log_dropped, 1);
+            return NULL;
+        }
+        pos = oglib_atomic64_load_relaxed(&g_oglib_log_head);
+    }
+}
+
+int oglib_log_enqueuev(oglib_log_level_t level, const char* fmt, va_list ap)
+{
+    int64_t ticket;
+    oglib_log_slot_t* slot;
+    if (!oglib_log_async_active() || !fmt) return 0;
+    slot = oglib_log_claim(&ticket);
+    if (!slot) return 0;
+    slot->level = (int)level;
+    vsnprintf(slot->text, sizeof(slot->text), fmt, ap);
+    oglib_atomic64_store_release(&slot->seq, ticket + 1);
+    return 1;
+}
+
+int oglib_log_enqueue(oglib_log_level_t level, const char* msg)
+{
+    int64_t ticket;
+    oglib_log_slot_t* slot;
+    size_t n;
+    if (!oglib_log_async_active() || !msg) return 0;
+    slot = oglib_log_claim(&ticket);
+    if (!slot) return 0;
+    slot->level = (int)level;
+    n = strlen(msg);
+    if (n >= sizeof(slot->text)) n = sizeof(slot->text) - 1;
+    memcpy(slot->text, msg, n);
+    slot->text[n] = '\0';
+    oglib_atomic64_store_release(&slot->seq, ticket + 1);
+    return 1;
+}
+
+/* ── Flusher side (single consumer) ── */
+
+static void oglib_log_rotate(void)
+{
+    char from[1024], to[1024];
+    int i;
+    const char* path = g_oglib_log_cfg.file_path;
+    if (g_oglib_log_file) { fclose(g_oglib_log_file); g_oglib_log_file = NULL; }
+    for (i = g_oglib_log_cfg.max_files - 1; i >= 1; i--) {
+        snprintf(from, sizeof(from), "%s.%d", path, i);
+        snprintf(to, sizeof(to), "%s.%d", path, i + 1);
+        remove(to);
+        rename(from, to);
+    }
+    snprintf(to, sizeof(to), "%s.1", path);
+    remove(to);
+    rename(path, to);
+    g_oglib_log_file = fopen(path, "w");
+    g_oglib_log_file_bytes = 0;
+}
+
+static void oglib_log_write_line(int level, const char* msg)
+{
+    const char* lvl = _oglib_level_str[(level >= 0 && level <= 3) ? level : 1];
+    if (g_oglib_log_file) {
+        int n = fprintf(g_oglib_log_file, "[OASIS/%s] %s\n", lvl, msg);
+        if (n > 0) g_oglib_log_file_bytes += n;
+        if (g_oglib_log_file_bytes >= g_oglib_log_cfg.max_file_bytes)
+            oglib_log_rotate();
+    }
+    if (oglib_atomic32_load_relaxed(&g_oglib_log_echo))
+        fprintf(stderr, "[OASIS/%s] %s\n", lvl, msg);
+    if (g_oglib_log_cfg.line_fn)
+        g_oglib_log_cfg.line_fn((oglib_log_level_t)level, msg, g_oglib_log_cfg.line_user);
+}
+
+static void oglib_log_flush_repeats(void)
+{
+    char note[64];
+    if (g_oglib_log_repeats <= 0) return;
+    snprintf(note, sizeof(note), "(last message repeated %ld times)", g_oglib_log_repeats);
+    g_oglib_log_repeats = 0;
+    oglib_log_write_line(g_oglib_log_last_level, note);
+}
+
+static void oglib_log_emit(int level, const char* msg)
+{
+    if (level == g_oglib_log_last_level && strcmp(msg, g_oglib_log_last) == 0) {
+        g_oglib_log_repeats++;
+        return;
+    }
+    oglib_log_flush_repeats();
+    strcpy(g_oglib_log_last, msg);
+    g_oglib_log_last_level = level;
+    oglib_log_write_line(level, msg);
+    g_oglib_log_last_write_ms = oglib_time_now_ms();
+}
+
+static int oglib_log_drain(void)
+{
+    int n = 0;
+    for (;;) {
+        oglib_log_slot_t* slot = &g_oglib_log_ring[g_oglib_log_tail & (OGLIB_LOG_RING_SLOTS - 1)];
+        if (oglib_atomic64_load_acquire(&slot->seq) != g_oglib_log_tail + 1) break;
+        oglib_log_emit(slot->level, slot->text);
+        oglib_atomic64_store_release(&slot->seq, g_oglib_log_tail + OGLIB_LOG_RING_SLOTS);
+        g_oglib_log_tail++;
+        n++;
+    }
+    if (n && g_oglib_log_file) fflush(g_oglib_log_file);
+    return n;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI oglib_log_thread_proc(LPVOID param) {
+#else
+static void* oglib_log_thread_proc(void* param) {
+#endif
+    (void)param;
+    while (oglib_log_async_active()) {
+        if (oglib_log_drain() == 0) {
+            /* Idle: report collapsed duplicates once the burst is over (1 s window). */
+            if (g_oglib_log_repeats > 0 && oglib_time_now_ms() - g_oglib_log_last_write_ms >= 1000) {
+                oglib_log_flush_repeats();
+                if (g_oglib_log_file) fflush(g_oglib_log_file);
+            }
+#ifdef _WIN32
+            Sleep((DWORD)g_oglib_log_cfg.flush_interval_ms);
+#else
+            usleep((useconds_t)g_oglib_log_cfg.flush_interval_ms * 1000);
+#endif
+        }
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+int oglib_log_async_start(const oglib_log_async_config_t* cfg)
+{
+    int i;
+    if (oglib_log_async_active()) return 0;
+    memset(&g_oglib_log_cfg, 0, sizeof(g_oglib_log_cfg));
+    if (cfg) g_oglib_log_cfg = *cfg;
+    if (g_oglib_log_cfg.max_file_bytes <= 0)    g_oglib_log_cfg.max_file_bytes = 4L * 1024 * 1024;
+    if (g_oglib_log_cfg.max_files <= 0)         g_oglib_log_cfg.max_files = 3;
+    if (g_oglib_log_cfg.flush_interval_ms <= 0) g_oglib_log_cfg.flush_interval_ms = 10;
+
+    for (i = 0; i < OGLIB_LOG_RING_SLOTS; i++)
+        g_oglib_log_ring[i].seq = i;
+    g_oglib_log_head = 0;
+    g_oglib_log_tail = 0;
+    g_oglib_log_dropped = 0;
+    g_oglib_log_echo = g_oglib_log_cfg.echo_stderr ? 1 : 0;
+    g_oglib_log_last[0] = '\0';
+    g_oglib_log_last_level = -1;
+    g_oglib_log_repeats = 0;
+
+    g_oglib_log_file = NULL;
+    g_oglib_log_file_bytes = 0;
+    if (g_oglib_log_cfg.file_path && g_oglib_log_cfg.file_path[0]) {
+        g_oglib_log_file = fopen(g_oglib_log_cfg.file_path, "a");
+        if (g_oglib_log_file) {
+            fseek(g_oglib_log_file, 0, SEEK_END);
+            g_oglib_log_file_bytes = ftell(g_oglib_log_file);
+        }
+    }
+
+    oglib_atomic32_store_release(&g_oglib_log_running, 1);
+#ifdef _WIN32
+    g_oglib_log_thread = CreateThread(NULL, 0, oglib_log_thread_proc, NULL, 0, NULL);
+    if (!g_oglib_log_thread) {
+#else
+    if (pthread_create(&g_oglib_log_thread, NULL, oglib_log_thread_proc, NULL) != 0) {
+#endif
+        oglib_atomic32_store_release(&g_oglib_log_running, 0);
+        if (g_oglib_log_file) { fclose(g_oglib_log_file); g_oglib_log_file = NULL; }
+        return 0;
+    }
+    return 1;
+}
+
+void oglib_log_async_stop(void)
+{
+    if (!oglib_log_async_active()) return;
+    oglib_atomic32_store_release(&g_oglib_log_running, 0);
+#ifdef _WIN32
+    WaitForSingleObject(g_oglib_log_thread, INFINITE);
+    CloseHandle(g_oglib_log_thread);
+    g_oglib_log_thread = NULL;
+#else
+    pthread_join(g_oglib_log_thread, NULL);
+#endif
+    oglib_log_drain();
+    oglib_log_flush_repeats();
+    if (oglib_atomic32_load_relaxed(&g_oglib_log_dropped) > 0) {
+        char note[64];
+        snprintf(note, sizeof(note), "(%ld log lines dropped: ring full)", oglib_log_async_dropped());
+        oglib_log_write_line(OGLIB_LOG_WARN, note);
+    }
+    if (g_oglib_log_file) { fclose(g_oglib_log_file); g_oglib_log_file = NULL; }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGLIB_LOG_IMPL */
+
 #endif /* OGLIB_LOG_H */
@@ -8,8 +8,10 @@
  * These session functions are declared in ogengine.h but the linker cannot always
  * resolve them at link time (e.g. when the game links ogengine.lib but the DLL is
  * loaded at runtime by the engine rather than the stub). This file provides a
- * runtime-forwarding shim layer that uses GetProcAddress (Win32) / dlsym (POSIX)
- * to resolve each symbol at first call.
+ * runtime-forwarding shim layer on top of a single vtable of every OGEngineClient
+ * export, resolved once (GetModuleHandle / one dlopen, then GetProcAddress / dlsym)
+ * under a thread-safe once-guard. After resolution each forwarder is one indirect
+ * call; exports the loaded client does not provide are reported in one warning.
  *
  * USAGE
  * -----
@@ -22,168 +24,207 @@
  *
  * The #define must appear in a .c/.cpp that is also including ogengine.h (or a
  * translation unit that links ogengine.lib), so the linker sees the definitions.
+ *
+ * Call oglib_session_init() once at game init to get the missing-export report at
+ * startup; otherwise it runs on the first forwarded call. The resolved table is
+ * available via oglib_session_vtable() (missing exports are NULL).
+ *
+ * Both the table and the declarations come from the OGENGINE_EXPORTS manifest in
+ * ogengine_exports.h. Games that link the client directly can define
+ * OGLIB_SESSION_STATIC next to OGLIB_SESSION_IMPL: the table is then a constant list
+ * of symbol addresses, no loader code or forwarders are compiled, and calls bind
+ * directly at link time.
  */
 #ifndef OGLIB_SESSION_H
 #define OGLIB_SESSION_H
 
-#include "ogengine.h"  /* ogengine_result_t, OGENGINE_ERROR_NOT_INITIALIZED */
-#include <stddef.h>    /* size_t */
+#include "ogengine_exports.h"  /* OGENGINE_EXPORTS manifest, ABI types and declarations */
+#include <stddef.h>             /* size_t */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* ── Forward declarations (available everywhere that includes this header) ── */
-
-ogengine_result_t ogengine_authenticate_with_jwt_out(const char* username,
-    const char* password, char* jwt_buf, size_t jwt_size);
+/* ── Export table ── */
 
-ogengine_result_t ogengine_set_saved_session(const char* jwt);
+#ifdef _WIN32
+#define OGLIB_SESSION_CALL __cdecl
+#else
+#define OGLIB_SESSION_CALL
+#endif
 
-ogengine_result_t ogengine_restore_session(void);
+typedef struct oglib_session_vtable_s {
+#define OGLIB_SESSION_VT_SLOT(ret, name, params) ret (OGLIB_SESSION_CALL *name) params;
+    OGENGINE_EXPORTS(OGLIB_SESSION_VT_SLOT)
+#undef OGLIB_SESSION_VT_SLOT
+} oglib_session_vtable_t;
 
-int  ogengine_get_current_username(char* buf, size_t buf_size);
-int  ogengine_get_current_jwt(char* buf, size_t buf_size);
-void ogengine_set_refresh_token(const char* refresh_token);
-int  ogengine_get_current_refresh_token(char* buf, size_t buf_size);
-int  ogengine_is_session_expired(void);
-void ogengine_request_inventory_in_background(void);
+/** Resolve all exports (first call only; thread-safe). Returns the number of missing exports, 0 when complete. */
+int oglib_session_init(void);
+/** Resolved export table; calls oglib_session_init() if needed. Missing exports are NULL. */
+const oglib_session_vtable_t* oglib_session_vtable(void);
+/** Comma-separated names of missing exports ("" when none). Valid after oglib_session_init(). */
+const char* oglib_session_missing_names(void);
 
 /* ── Implementation (compiled once, in the TU that defines OGLIB_SESSION_IMPL) ── */
 
 #ifdef OGLIB_SESSION_IMPL
 
+#ifdef OGLIB_SESSION_STATIC
+
+/* Static link: every export is resolved by the linker. */
+static const oglib_session_vtable_t g_oglib_session_vt = {
+#define OGLIB_SESSION_STATIC_SLOT(ret, name, params) &name,
+    OGENGINE_EXPORTS(OGLIB_SESSION_STATIC_SLOT)
+#undef OGLIB_SESSION_STATIC_SLOT
+};
+
+int oglib_session_init(void) { return 0; }
+const oglib_session_vtable_t* oglib_session_vtable(void) { return &g_oglib_session_vt; }
+const char* oglib_session_missing_names(void) { return ""; }
+
+#else /* dynamic */
+
+#include "oglib_log.h"
+#include <string.h>
+
 #ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
+#endif
 #include <windows.h>
+#else
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
 
-#define OGLIB_LOAD_FN(ret, name, ...) \
-    typedef ret (__cdecl *_ogame_##name##_t)(__VA_ARGS__); \
-    static _ogame_##name##_t _ogame_##name##_fn = NULL; \
-    if (!_ogame_##name##_fn) { \
-        HMODULE h = GetModuleHandleA("ogengine.dll"); \
-        if (h) _ogame_##name##_fn = (_ogame_##name##_t)(void*)GetProcAddress(h, #name); \
+/* Session exports the linker may not resolve; OGLib defines these symbols itself and
+ * forwards through the table. X(return keyword, return type, name, (params), (args), fallback)
+ * where fallback is returned when the export is missing. */
+#define OGLIB_SESSION_FORWARDERS(X) \
+    X(return, ogengine_result_t, ogengine_authenticate_with_jwt_out, (const char* u, const char* p, char* buf, size_t sz), (u, p, buf, sz), (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED) \
+    X(return, ogengine_result_t, ogengine_set_saved_session, (const char* jwt), (jwt), (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED) \
+    X(return, ogengine_result_t, ogengine_restore_session, (void), (), (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED) \
+    X(return, int, ogengine_get_current_username, (char* buf, size_t sz), (buf, sz), 0) \
+    X(return, int, ogengine_get_current_jwt, (char* buf, size_t sz), (buf, sz), 0) \
+    X(, void, ogengine_set_refresh_token, (const char* tok), (tok), ) \
+    X(return, int, ogengine_get_current_refresh_token, (char* buf, size_t sz), (buf, sz), 0) \
+    X(return, int, ogengine_is_session_expired, (void), (), 0) \
+    X(, void, ogengine_request_inventory_in_background, (void), (), )
+
+static oglib_session_vtable_t g_oglib_session_vt;
+static int  g_oglib_session_missing = 0;
+static char g_oglib_session_missing_names[1024];
+
+/* Forwarder slots start at a thunk that runs the once-guard. Resolution replaces each
+ * slot with the client's function; a missing export keeps its thunk, which then
+ * returns the fallback. */
+typedef struct oglib_session_fwd_s {
+#define OGLIB_SESSION_FWD_SLOT(kw, ret, name, params, args, fallback) ret (OGLIB_SESSION_CALL *name) params;
+    OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_FWD_SLOT)
+#undef OGLIB_SESSION_FWD_SLOT
+} oglib_session_fwd_t;
+
+#define OGLIB_SESSION_THUNK_DECL(kw, ret, name, params, args, fallback) \
+    static ret OGLIB_SESSION_CALL oglib_session_thunk_##name params;
+OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_THUNK_DECL)
+#undef OGLIB_SESSION_THUNK_DECL
+
+static oglib_session_fwd_t g_oglib_session_fwd = {
+#define OGLIB_SESSION_THUNK_REF(kw, ret, name, params, args, fallback) oglib_session_thunk_##name,
+    OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_THUNK_REF)
+#undef OGLIB_SESSION_THUNK_REF
+};
+
+#define OGLIB_SESSION_THUNK_DEF(kw, ret, name, params, args, fallback) \
+    static ret OGLIB_SESSION_CALL oglib_session_thunk_##name params { \
+        oglib_session_init(); \
+        if (g_oglib_session_fwd.name != oglib_session_thunk_##name) kw g_oglib_session_fwd.name args; \
+        kw fallback; \
     }
+OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_THUNK_DEF)
+#undef OGLIB_SESSION_THUNK_DEF
 
-ogengine_result_t ogengine_authenticate_with_jwt_out(const char* u, const char* p, char* buf, size_t sz) {
-    OGLIB_LOAD_FN(ogengine_result_t, ogengine_authenticate_with_jwt_out, const char*, const char*, char*, size_t)
-    return _ogame_ogengine_authenticate_with_jwt_out_fn
-        ? _ogame_ogengine_authenticate_with_jwt_out_fn(u, p, buf, sz)
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-ogengine_result_t ogengine_set_saved_session(const char* jwt) {
-    OGLIB_LOAD_FN(ogengine_result_t, ogengine_set_saved_session, const char*)
-    return _ogame_ogengine_set_saved_session_fn
-        ? _ogame_ogengine_set_saved_session_fn(jwt)
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-ogengine_result_t ogengine_restore_session(void) {
-    OGLIB_LOAD_FN(ogengine_result_t, ogengine_restore_session, void)
-    return _ogame_ogengine_restore_session_fn
-        ? _ogame_ogengine_restore_session_fn()
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-int ogengine_get_current_username(char* buf, size_t sz) {
-    OGLIB_LOAD_FN(int, ogengine_get_current_username, char*, size_t)
-    return _ogame_ogengine_get_current_username_fn
-        ? _ogame_ogengine_get_current_username_fn(buf, sz) : 0;
-}
-int ogengine_get_current_jwt(char* buf, size_t sz) {
-    OGLIB_LOAD_FN(int, ogengine_get_current_jwt, char*, size_t)
-    return _ogame_ogengine_get_current_jwt_fn
-        ? _ogame_ogengine_get_current_jwt_fn(buf, sz) : 0;
-}
-void ogengine_set_refresh_token(const char* tok) {
-    OGLIB_LOAD_FN(void, ogengine_set_refresh_token, const char*)
-    if (_ogame_ogengine_set_refresh_token_fn) _ogame_ogengine_set_refresh_token_fn(tok);
-}
-int ogengine_get_current_refresh_token(char* buf, size_t sz) {
-    OGLIB_LOAD_FN(int, ogengine_get_current_refresh_token, char*, size_t)
-    return _ogame_ogengine_get_current_refresh_token_fn
-        ? _ogame_ogengine_get_current_refresh_token_fn(buf, sz) : 0;
+static void oglib_session_note_missing(const char* name) {
+    size_t len = strlen(g_oglib_session_missing_names);
+    g_oglib_session_missing++;
+    if (len + strlen(name) + 3 >= sizeof(g_oglib_session_missing_names)) return;
+    if (len) { memcpy(g_oglib_session_missing_names + len, ", ", 2); len += 2; }
+    memcpy(g_oglib_session_missing_names + len, name, strlen(name) + 1);
 }
-int ogengine_is_session_expired(void) {
-    OGLIB_LOAD_FN(int, ogengine_is_session_expired, void)
-    return _ogame_ogengine_is_session_expired_fn
-        ? _ogame_ogengine_is_session_expired_fn() : 0;
-}
-void ogengine_request_inventory_in_background(void) {
-    OGLIB_LOAD_FN(void, ogengine_request_inventory_in_background, void)
-    if (_ogame_ogengine_request_inventory_in_background_fn)
-        _ogame_ogengine_request_inventory_in_background_fn();
-}
-
-#undef OGLIB_LOAD_FN
-
-#else /* POSIX */
-#include <dlfcn.h>
 
-/* Try RTLD_NOLOAD first (already loaded), fall back to dlopen(NULL) for in-process. */
-static void* oglib_session_handle(void) {
+static void oglib_session_resolve(void) {
+#ifdef _WIN32
+    HMODULE h = GetModuleHandleA("ogengine.dll");
+#define OGLIB_SESSION_SYM(name) (h ? (void*)GetProcAddress(h, name) : NULL)
+#else
+    /* One handle for the process lifetime: the client if already loaded, else the global scope. */
     void* h = dlopen("libOGEngineClient.so", RTLD_NOW | RTLD_NOLOAD);
     if (!h) h = dlopen(NULL, RTLD_NOW);
-    return h;
+#define OGLIB_SESSION_SYM(name) (h ? dlsym(h, name) : NULL)
+#endif
+    int total = 0;
+
+#define OGLIB_SESSION_RESOLVE(ret, name, params) \
+    g_oglib_session_vt.name = (ret (OGLIB_SESSION_CALL *) params)OGLIB_SESSION_SYM(#name); \
+    total++;
+    OGENGINE_EXPORTS(OGLIB_SESSION_RESOLVE)
+#undef OGLIB_SESSION_RESOLVE
+#undef OGLIB_SESSION_SYM
+
+    /* dlopen(NULL) can hand back OGLib's own forwarder; that would recurse, so treat it as missing. */
+#define OGLIB_SESSION_BIND(kw, ret, name, params, args, fallback) \
+    if ((void*)g_oglib_session_vt.name == (void*)&name) g_oglib_session_vt.name = NULL; \
+    if (g_oglib_session_vt.name) g_oglib_session_fwd.name = g_oglib_session_vt.name;
+    OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_BIND)
+#undef OGLIB_SESSION_BIND
+
+#define OGLIB_SESSION_CHECK(ret, name, params) \
+    if (!g_oglib_session_vt.name) oglib_session_note_missing(#name);
+    OGENGINE_EXPORTS(OGLIB_SESSION_CHECK)
+#undef OGLIB_SESSION_CHECK
+
+    if (!h)
+        oglib_log(OGLIB_LOG_WARN, "[OGLib] session: OGEngineClient not loaded; all %d exports unavailable", total);
+    else if (g_oglib_session_missing)
+        oglib_log(OGLIB_LOG_WARN, "[OGLib] session: %d of %d OGEngineClient exports missing: %s",
+                  g_oglib_session_missing, total, g_oglib_session_missing_names);
 }
 
-#define OGLIB_LOAD_FN_POSIX(ret, name, ...) \
-    typedef ret (*_ogame_##name##_t)(__VA_ARGS__); \
-    static _ogame_##name##_t _ogame_##name##_fn = NULL; \
-    if (!_ogame_##name##_fn) { \
-        void* h = oglib_session_handle(); \
-        if (h) _ogame_##name##_fn = (_ogame_##name##_t)dlsym(h, #name); \
-    }
-
-ogengine_result_t ogengine_authenticate_with_jwt_out(const char* u, const char* p, char* buf, size_t sz) {
-    OGLIB_LOAD_FN_POSIX(ogengine_result_t, ogengine_authenticate_with_jwt_out, const char*, const char*, char*, size_t)
-    return _ogame_ogengine_authenticate_with_jwt_out_fn
-        ? _ogame_ogengine_authenticate_with_jwt_out_fn(u, p, buf, sz)
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-ogengine_result_t ogengine_set_saved_session(const char* jwt) {
-    OGLIB_LOAD_FN_POSIX(ogengine_result_t, ogengine_set_saved_session, const char*)
-    return _ogame_ogengine_set_saved_session_fn
-        ? _ogame_ogengine_set_saved_session_fn(jwt)
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-ogengine_result_t ogengine_restore_session(void) {
-    OGLIB_LOAD_FN_POSIX(ogengine_result_t, ogengine_restore_session, void)
-    return _ogame_ogengine_restore_session_fn
-        ? _ogame_ogengine_restore_session_fn()
-        : (ogengine_result_t)OGENGINE_ERROR_NOT_INITIALIZED;
-}
-int ogengine_get_current_username(char* buf, size_t sz) {
-    OGLIB_LOAD_FN_POSIX(int, ogengine_get_current_username, char*, size_t)
-    return _ogame_ogengine_get_current_username_fn
-        ? _ogame_ogengine_get_current_username_fn(buf, sz) : 0;
-}
-int ogengine_get_current_jwt(char* buf, size_t sz) {
-    OGLIB_LOAD_FN_POSIX(int, ogengine_get_current_jwt, char*, size_t)
-    return _ogame_ogengine_get_current_jwt_fn
-        ? _ogame_ogengine_get_current_jwt_fn(buf, sz) : 0;
-}
-void ogengine_set_refresh_token(const char* tok) {
-    OGLIB_LOAD_FN_POSIX(void, ogengine_set_refresh_token, const char*)
-    if (_ogame_ogengine_set_refresh_token_fn) _ogame_ogengine_set_refresh_token_fn(tok);
-}
-int ogengine_get_current_refresh_token(char* buf, size_t sz) {
-    OGLIB_LOAD_FN_POSIX(int, ogengine_get_current_refresh_token, char*, size_t)
-    return _ogame_ogengine_get_current_refresh_token_fn
-        ? _ogame_ogengine_get_current_refresh_token_fn(buf, sz) : 0;
+#ifdef _WIN32
+static INIT_ONCE g_oglib_session_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK oglib_session_once_fn(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once; (void)param; (void)ctx;
+    oglib_session_resolve();
+    return TRUE;
+}
+int oglib_session_init(void) {
+    InitOnceExecuteOnce(&g_oglib_session_once, oglib_session_once_fn, NULL, NULL);
+    return g_oglib_session_missing;
+}
+#else
+static pthread_once_t g_oglib_session_once = PTHREAD_ONCE_INIT;
+int oglib_session_init(void) {
+    pthread_once(&g_oglib_session_once, oglib_session_resolve);
+    return g_oglib_session_missing;
 }
-int ogengine_is_session_expired(void) {
-    OGLIB_LOAD_FN_POSIX(int, ogengine_is_session_expired, void)
-    return _ogame_ogengine_is_session_expired_fn
-        ? _ogame_ogengine_is_session_expired_fn() : 0;
+#endif
+
+const oglib_session_vtable_t* oglib_session_vtable(void) {
+    oglib_session_init();
+    return &g_oglib_session_vt;
 }
-void ogengine_request_inventory_in_background(void) {
-    OGLIB_LOAD_FN_POSIX(void, ogengine_request_inventory_in_background, void)
-    if (_ogame_ogengine_request_inventory_in_background_fn)
-        _ogame_ogengine_request_inventory_in_background_fn();
+
+const char* oglib_session_missing_names(void) {
+    return g_oglib_session_missing_names;
 }
 
-#undef OGLIB_LOAD_FN_POSIX
+#define OGLIB_SESSION_FORWARD(kw, ret, name, params, args, fallback) \
+    ret name params { kw g_oglib_session_fwd.name args; }
+OGLIB_SESSION_FORWARDERS(OGLIB_SESSION_FORWARD)
+#undef OGLIB_SESSION_FORWARD
 
-#endif /* _WIN32 / POSIX */
+#endif /* OGLIB_SESSION_STATIC */
 #endif /* OGLIB_SESSION_IMPL */
 
 #ifdef __cplusplus
@@ -0,0 +1,77 @@
+/**
+ * oglib_time.h — OGLib monotonic clock
+ *
+ * oglib_time_now_us() returns a monotonic timestamp in microseconds
+ * (QueryPerformanceCounter on Win32, CLOCK_MONOTONIC on POSIX). Only
+ * differences between two readings are meaningful.
+ *
+ * The clock is compiled once, in the TU that defines OGLIB_TIME_IMPL
+ * (implied by OGLIB_LOG_IMPL), so <windows.h> stays out of the other TUs.
+ */
+#ifndef OGLIB_TIME_H
+#define OGLIB_TIME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t oglib_time_now_us(void);
+
+static inline int64_t oglib_time_now_ms(void)
+{
+    return oglib_time_now_us() / 1000;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/* ── Implementation (compiled once, in the TU that defines OGLIB_TIME_IMPL) ── */
+
+#if defined(OGLIB_LOG_IMPL) && !defined(OGLIB_TIME_IMPL)
+#  define OGLIB_TIME_IMPL   /* the log TU also hosts the clock */
+#endif
+
+#ifdef OGLIB_TIME_IMPL
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t oglib_time_now_us(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (int64_t)((now.QuadPart / freq.QuadPart) * 1000000
+                   + (now.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGLIB_TIME_IMPL */
+
+#endif /* OGLIB_TIME_H */
@@ -0,0 +1,336 @@
+/**
+ * oglib_trace.h — OGLib event tracing (Chrome trace-event / Perfetto export)
+ *
+ * Records begin/end spans, instant events and counters into per-thread ring
+ * buffers and exports them as Chrome trace-event JSON, which loads directly
+ * in ui.perfetto.dev or chrome://tracing. Use it to see which frames the
+ * OASIS layer costs (sync pump, STAR callbacks, pickup hooks, config I/O).
+ *
+ * Recording is off until oglib_trace_enable(1); while off every macro costs
+ * one relaxed atomic load, and a thread's buffer is only allocated when it
+ * records its first event. Each thread writes only to its own buffer (no
+ * locks); when a buffer is full the oldest events are overwritten, so the
+ * export always holds the most recent OGLIB_TRACE_EVENTS_PER_THREAD events
+ * per thread.
+ *
+ * Event names and categories are stored by pointer: pass string literals
+ * (or other strings that outlive the trace).
+ *
+ * USAGE
+ * -----
+ * Tracing is compiled in only where OGLIB_TRACE_ENABLE is defined (otherwise
+ * every macro expands to nothing and no symbols are referenced). Define it for
+ * each TU that should record, and OGLIB_TRACE_IMPL in exactly ONE of them:
+ *
+ *   #define OGLIB_TRACE_ENABLE
+ *   #define OGLIB_TRACE_IMPL
+ *   #include "oglib_trace.h"
+ *
+ *   oglib_trace_enable(1);
+ *   OGLIB_TRACE_BEGIN("MyGame_Frame", "game");
+ *   ...
+ *   OGLIB_TRACE_END("MyGame_Frame", "game");
+ *   OGLIB_TRACE_INSTANT("beam-in requested", "oasis");
+ *   oglib_trace_export_json("oasis_trace.json");
+ *
+ * C++ callers can use OGLIB_TRACE_SCOPE("name", "cat") for an RAII span.
+ */
+#ifndef OGLIB_TRACE_H
+#define OGLIB_TRACE_H
+
+#include <stdint.h>
+#include "oglib_atomic.h"
+#include "oglib_time.h"
+
+#ifndef OGLIB_TRACE_EVENTS_PER_THREAD
+#  define OGLIB_TRACE_EVENTS_PER_THREAD 16384   /* must be a power of two */
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Chrome trace-event phases recorded by OGLib. */
+#define OGLIB_TRACE_PH_BEGIN   'B'
+#define OGLIB_TRACE_PH_END     'E'
+#define OGLIB_TRACE_PH_INSTANT 'i'
+#define OGLIB_TRACE_PH_COUNTER 'C'
+
+/** Global on/off switch (recording state, not compiled state). Read with a relaxed load on every event. */
+extern oglib_atomic32_t g_oglib_trace_enabled;
+
+/** Start (1) or stop (0) recording. Buffers are kept; use oglib_trace_reset() to clear them. */
+void oglib_trace_enable(int enabled);
+/** Record one event for the calling thread. phase is one of OGLIB_TRACE_PH_*; value is used by counters only. */
+void oglib_trace_event(const char* name, const char* category, char phase, int64_t value);
+/** Name the calling thread in the exported trace (e.g. "main", "ogengine_sync worker"). Does not allocate the thread's buffer. */
+void oglib_trace_set_thread_name(const char* name);
+/** Write all thread buffers as Chrome trace-event JSON. Recording is paused while writing (events in flight finish first). Returns 1 on success. */
+int  oglib_trace_export_json(const char* path);
+/** Drop all recorded events (buffers stay allocated). Pauses recording like export while the counts are cleared. */
+void oglib_trace_reset(void);
+
+/**
+ * Adapter with the ogengine_sync trace callback signature, so the C sync layer can
+ * report pump/worker spans without depending on OGLib. phase is an OGLIB_TRACE_PH_*
+ * code, or 'M' to name the calling thread:
+ *
+ *   #ifdef OGENGINE_SYNC_HAS_TRACE_CB
+ *   ogengine_sync_set_trace_cb(oglib_trace_sync_hook, NULL);
+ *   #endif
+ */
+void oglib_trace_sync_hook(const char* name, int phase, void* user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifndef OGLIB_TRACE_ENABLE
+#  define OGLIB_TRACE_ON()                      0
+#  define OGLIB_TRACE_BEGIN(name, cat)          ((void)0)
+#  define OGLIB_TRACE_END(name, cat)            ((void)0)
+#  define OGLIB_TRACE_INSTANT(name, cat)        ((void)0)
+#  define OGLIB_TRACE_COUNTER(name, cat, value) ((void)0)
+#else
+#  define OGLIB_TRACE_ON() (oglib_atomic32_load_relaxed(&g_oglib_trace_enabled) != 0)
+#  define OGLIB_TRACE_BEGIN(name, cat) \
+    do { if (OGLIB_TRACE_ON()) oglib_trace_event((name), (cat), OGLIB_TRACE_PH_BEGIN, 0); } while (0)
+#  define OGLIB_TRACE_END(name, cat) \
+    do { if (OGLIB_TRACE_ON()) oglib_trace_event((name), (cat), OGLIB_TRACE_PH_END, 0); } while (0)
+#  define OGLIB_TRACE_INSTANT(name, cat) \
+    do { if (OGLIB_TRACE_ON()) oglib_trace_event((name), (cat), OGLIB_TRACE_PH_INSTANT, 0); } while (0)
+#  define OGLIB_TRACE_COUNTER(name, cat, value) \
+    do { if (OGLIB_TRACE_ON()) oglib_trace_event((name), (cat), OGLIB_TRACE_PH_COUNTER, (int64_t)(value)); } while (0)
+#endif
+
+#if defined(__cplusplus) && defined(OGLIB_TRACE_ENABLE)
+/** RAII span for C++ integrations. Records the end event even if tracing was switched off mid-span. */
+struct oglib_trace_scope {
+    const char* name;
+    const char* cat;
+    bool        active;
+    oglib_trace_scope(const char* n, const char* c) : name(n), cat(c), active(false) {
+        if (OGLIB_TRACE_ON()) { active = true; oglib_trace_event(name, cat, OGLIB_TRACE_PH_BEGIN, 0); }
+    }
+    ~oglib_trace_scope() {
+        if (active) oglib_trace_event(name, cat, OGLIB_TRACE_PH_END, 0);
+    }
+};
+#define OGLIB_TRACE_CONCAT2(a, b) a##b
+#define OGLIB_TRACE_CONCAT(a, b)  OGLIB_TRACE_CONCAT2(a, b)
+#define OGLIB_TRACE_SCOPE(name, cat) oglib_trace_scope OGLIB_TRACE_CONCAT(_oglib_trace_scope_, __LINE__)((name), (cat))
+#else
+#define OGLIB_TRACE_SCOPE(name, cat) ((void)0)
+#endif
+
+/* ── Implementation (compiled once, in the TU that defines OGLIB_TRACE_IMPL) ── */
+
+#ifdef OGLIB_TRACE_IMPL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#  define OGLIB_TRACE_TLS __declspec(thread)
+#else
+#  define OGLIB_TRACE_TLS __thread
+#endif
+
+typedef struct {
+    int64_t     ts_us;
+    const char* name;
+    const char* cat;
+    int64_t     value;
+    char        phase;
+} oglib_trace_event_t;
+
+typedef struct oglib_trace_buffer {
+    struct oglib_trace_buffer* next;     /* global registry (push-only list) */
+    int                        tid;
+    char                       thread_name[64];
+    oglib_atomic64_t           count;    /* total events written; index = count & mask */
+    oglib_atomic32_t           writing;  /* 1 while the owning thread is inside oglib_trace_event */
+    oglib_trace_event_t        events[OGLIB_TRACE_EVENTS_PER_THREAD];
+} oglib_trace_buffer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+oglib_atomic32_t g_oglib_trace_enabled = 0;
+
+static oglib_trace_buffer_t* volatile    g_oglib_trace_buffers = NULL;
+static oglib_atomic32_t                  g_oglib_trace_next_tid = 0;
+static oglib_atomic32_t                  g_oglib_trace_paused = 0;  /* >0 while export/reset reads or clears buffers */
+static int64_t                           g_oglib_trace_epoch_us = 0;
+static OGLIB_TRACE_TLS oglib_trace_buffer_t* t_oglib_trace_buf = NULL;
+static OGLIB_TRACE_TLS char                  t_oglib_trace_thread_name[64];
+
+/* Lock-free push onto the registry; buffers are never freed (threads may still hold them). */
+static void oglib_trace_register(oglib_trace_buffer_t* b)
+{
+    for (;;) {
+        oglib_trace_buffer_t* head = g_oglib_trace_buffers;
+        b->next = head;
+#if defined(_MSC_VER) && !defined(__clang__)
+        if (_InterlockedCompareExchangePointer((void* volatile*)&g_oglib_trace_buffers, b, head) == head) return;
+#else
+        if (__atomic_compare_exchange_n(&g_oglib_trace_buffers, &head, b, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) return;
+#endif
+    }
+}
+
+/* Allocated on the thread's first recorded event, so threads that only run while recording is off cost nothing. */
+static oglib_trace_buffer_t* oglib_trace_thread_buffer(void)
+{
+    oglib_trace_buffer_t* b = t_oglib_trace_buf;
+    if (b) return b;
+    b = (oglib_trace_buffer_t*)calloc(1, sizeof(*b));
+    if (!b) return NULL;
+    b->tid = (int)oglib_atomic32_add(&g_oglib_trace_next_tid, 1);
+    memcpy(b->thread_name, t_oglib_trace_thread_name, sizeof(b->thread_name));
+    oglib_trace_register(b);
+    t_oglib_trace_buf = b;
+    return b;
+}
+
+void oglib_trace_enable(int enabled)
+{
+    if (enabled && !g_oglib_trace_epoch_us)
+        g_oglib_trace_epoch_us = oglib_time_now_us();
+    oglib_atomic32_store_release(&g_oglib_trace_enabled, enabled ? 1 : 0);
+}
+
+void oglib_trace_event(const char* name, const char* category, char phase, int64_t value)
+{
+    oglib_trace_buffer_t* b;
+    oglib_trace_event_t* e;
+    int64_t n;
+    if (!name) return;
+    b = oglib_trace_thread_buffer();
+    if (!b) return;
+    /* Announce the write, then check the pause flag; oglib_trace_pause does the mirror image, so one side always sees the other. */
+    oglib_atomic32_exchange(&b->writing, 1);
+    if (oglib_atomic32_add(&g_oglib_trace_paused, 0)) {
+        oglib_atomic32_store_release(&b->writing, 0);
+        return;
+    }
+    n = oglib_atomic64_load_relaxed(&b->count);
+    e = &b->events[n & (OGLIB_TRACE_EVENTS_PER_THREAD - 1)];
+    e->ts_us = oglib_time_now_us();
+    e->name  = name;
+    e->cat   = category ? category : "oasis";
+    e->value = value;
+    e->phase = phase;
+    oglib_atomic64_store_release(&b->count, n + 1);
+    oglib_atomic32_store_release(&b->writing, 0);
+}
+
+/* Stop new events and wait for threads already inside oglib_trace_event to finish theirs. */
+static void oglib_trace_pause(void)
+{
+    oglib_trace_buffer_t* b;
+    oglib_atomic32_add(&g_oglib_trace_paused, 1);
+    for (b = g_oglib_trace_buffers; b; b = b->next)
+        while (oglib_atomic32_add(&b->writing, 0)) { }
+}
+
+static void oglib_trace_resume(void)
+{
+    oglib_atomic32_add(&g_oglib_trace_paused, -1);
+}
+
+void oglib_trace_set_thread_name(const char* name)
+{
+    oglib_trace_buffer_t* b = t_oglib_trace_buf;
+    size_t i = 0;
+    if (!name) return;
+    while (name[i] && i + 1 < sizeof(t_oglib_trace_thread_name)) { t_oglib_trace_thread_name[i] = name[i]; i++; }
+    t_oglib_trace_thread_name[i] = '\0';
+    if (b) memcpy(b->thread_name, t_oglib_trace_thread_name, sizeof(b->thread_name));
+}
+
+void oglib_trace_sync_hook(const char* name, int phase, void* user)
+{
+    (void)user;
+    if (phase == 'M') { oglib_trace_set_thread_name(name); return; }
+    if (!oglib_atomic32_load_relaxed(&g_oglib_trace_enabled)) return;
+    oglib_trace_event(name, "ogengine_sync", (char)phase, 0);
+}
+
+void oglib_trace_reset(void)
+{
+    oglib_trace_buffer_t* b;
+    oglib_trace_pause();
+    for (b = g_oglib_trace_buffers; b; b = b->next)
+        oglib_atomic64_store_release(&b->count, 0);
+    g_oglib_trace_epoch_us = oglib_time_now_us();
+    oglib_trace_resume();
+}
+
+static void oglib_trace_write_json_str(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+int oglib_trace_export_json(const char* path)
+{
+    FILE* f;
+    oglib_trace_buffer_t* b;
+    int first = 1;
+    if (!path || !path[0]) return 0;
+    f = fopen(path, "w");
+    if (!f) return 0;
+
+    oglib_trace_pause();
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (b = g_oglib_trace_buffers; b; b = b->next) {
+        int64_t count = oglib_atomic64_load_acquire(&b->count);
+        int64_t start = count > OGLIB_TRACE_EVENTS_PER_THREAD ? count - OGLIB_TRACE_EVENTS_PER_THREAD : 0;
+        int64_t i;
+        if (b->thread_name[0]) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", b->tid);
+            oglib_trace_write_json_str(f, b->thread_name);
+            fprintf(f, "}}");
+            first = 0;
+        }
+        for (i = start; i < count; i++) {
+            const oglib_trace_event_t* e = &b->events[i & (OGLIB_TRACE_EVENTS_PER_THREAD - 1)];
+            fprintf(f, "%s{\"name\":", first ? "" : ",\n");
+            oglib_trace_write_json_str(f, e->name);
+            fprintf(f, ",\"cat\":");
+            oglib_trace_write_json_str(f, e->cat);
+            fprintf(f, ",\"ph\":\"%c\",\"ts\":%lld,\"pid\":1,\"tid\":%d",
+                    e->phase, (long long)(e->ts_us - g_oglib_trace_epoch_us), b->tid);
+            if (e->phase == OGLIB_TRACE_PH_INSTANT)
+                fprintf(f, ",\"s\":\"t\"");
+            else if (e->phase == OGLIB_TRACE_PH_COUNTER)
+                fprintf(f, ",\"args\":{\"value\":%lld}", (long long)e->value);
+            fputc('}', f);
+            first = 0;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    oglib_trace_resume();
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGLIB_TRACE_IMPL */
+
+#endif /* OGLIB_TRACE_H */
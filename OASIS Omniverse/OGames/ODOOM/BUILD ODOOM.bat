@@ -49,8 +49,8 @@ powershell -NoProfile -ExecutionPolicy Bypass -Command "$v=$env:VERSION_DISPLAY;
 set "DO_FULL_CLEAN=0"
 set "DO_SPRITE_REGEN=1"
 set "SKIP_SPRITE_PROMPT=0"
-REM Default: use star_sync from ogengine.dll (C#). Set to 0 to compile ogengine_sync.c (C) instead. See ogengine_sync.h / OASIS Omniverse\Docs\STAR_INTEGRATION_AUDIT.md.
-if not defined OASIS_STAR_SYNC_IN_CLIENT set "OASIS_STAR_SYNC_IN_CLIENT=1"
+REM Default: compile ogengine_sync.c (C: worker pool, op queues, jobs, stats). Set to 1 to use star_sync from ogengine.dll (C#) instead. See ogengine_sync.h / OASIS Omniverse\Docs\STAR_INTEGRATION_AUDIT.md.
+if not defined OASIS_STAR_SYNC_IN_CLIENT set "OASIS_STAR_SYNC_IN_CLIENT=0"
 set "OQ_MONSTER_PAD=0"
 set "OQ_ITEM_PAD=0"
 REM Set to 1 to always build and deploy OGEngineClient before building (script skips build if client unchanged).
@@ -128,6 +128,7 @@ set "OGENGINECLIENT=%HERE%..\..\OGEngineClient"
 if exist "%OGENGINECLIENT%\ogengine_sync.c" (
     copy /Y "%OGENGINECLIENT%\ogengine_sync.c" "%ODOOM_INTEGRATION%\" >nul
     copy /Y "%OGENGINECLIENT%\ogengine_sync.h" "%ODOOM_INTEGRATION%\" >nul
+    copy /Y "%OGENGINECLIENT%\ogengine_sync_coro.h" "%ODOOM_INTEGRATION%\" >nul
 )
 echo.
 echo [ODOOM][STEP] Installing integration files...
@@ -137,6 +138,7 @@ copy /Y "%ODOOM_INTEGRATION%uzdoom_ogengine_integration.h" "%UZDOOM_SRC%\src\uzd
 copy /Y "%OGENGINECLIENT%\ogengine.h" "%UZDOOM_SRC%\src\ogengine.h" >nul
 if exist "%ODOOM_INTEGRATION%ogengine_sync.c" copy /Y "%ODOOM_INTEGRATION%ogengine_sync.c" "%UZDOOM_SRC%\src\ogengine_sync.c" >nul
 if exist "%ODOOM_INTEGRATION%ogengine_sync.h" copy /Y "%ODOOM_INTEGRATION%ogengine_sync.h" "%UZDOOM_SRC%\src\ogengine_sync.h" >nul
+if exist "%ODOOM_INTEGRATION%ogengine_sync_coro.h" copy /Y "%ODOOM_INTEGRATION%ogengine_sync_coro.h" "%UZDOOM_SRC%\src\ogengine_sync_coro.h" >nul
 copy /Y "%ODOOM_INTEGRATION%odoom_branding.h" "%UZDOOM_SRC%\src\odoom_branding.h" >nul
 copy /Y "%ODOOM_INTEGRATION%odoom_oquake_keys.zs" "%UZDOOM_SRC%\wadsrc\static\zscript\actors\doom\odoom_oquake_keys.zs" >nul
 copy /Y "%ODOOM_INTEGRATION%odoom_oquake_items.zs" "%UZDOOM_SRC%\wadsrc\static\zscript\actors\doom\odoom_oquake_items.zs" >nul
@@ -330,7 +332,7 @@ if not defined PYTHON3_EXE_CMAKE set "PYTHON3_EXE_CMAKE=%PYTHON3_EXE%"
 echo [ODOOM][INFO] CMake OGENGINE_DIR="%OGENGINE_DIR_CMAKE%"
 echo [ODOOM][INFO] CMake OGENGINE_LIB_DIR="%OGENGINE_LIB_DIR_CMAKE%"
 echo [ODOOM][INFO] CMake Python3_EXECUTABLE="%PYTHON3_EXE_CMAKE%"
-if "%OASIS_STAR_SYNC_IN_CLIENT%"=="0" (set "CMAKE_STAR_SYNC=-DOASIS_STAR_SYNC_IN_CLIENT=OFF" & echo [ODOOM][INFO] Compiling ogengine_sync.c - C implementation) else (set "CMAKE_STAR_SYNC=-DOASIS_STAR_SYNC_IN_CLIENT=ON" & echo [ODOOM][INFO] Using star_sync from ogengine.dll - default)
+if "%OASIS_STAR_SYNC_IN_CLIENT%"=="1" (set "CMAKE_STAR_SYNC=-DOASIS_STAR_SYNC_IN_CLIENT=ON" & echo [ODOOM][INFO] Using star_sync from ogengine.dll - C# exports) else (set "CMAKE_STAR_SYNC=-DOASIS_STAR_SYNC_IN_CLIENT=OFF" & echo [ODOOM][INFO] Compiling ogengine_sync.c - C implementation, default)
 cmake .. -G "Visual Studio 18 2026" -A x64 -DOASIS_STAR_API=ON -DOGENGINE_DIR:PATH="%OGENGINE_DIR_CMAKE%" -DOGENGINE_LIB_DIR:PATH="%OGENGINE_LIB_DIR_CMAKE%" -DPython3_EXECUTABLE:FILEPATH="%PYTHON3_EXE_CMAKE%" %CMAKE_STAR_SYNC%
 if errorlevel 1 (echo "[ODOOM][ERROR] CMake failed." & pause & exit /b 1)
 
@@ -53,8 +53,8 @@ RUN_AFTER_BUILD=0
 BATCH_MODE=0
 OQ_MONSTER_PAD="${OQ_MONSTER_PAD:-0}"
 OQ_ITEM_PAD="${OQ_ITEM_PAD:-0}"
-# Default: use star_sync from star_api (C#). Set OASIS_STAR_SYNC_IN_CLIENT=0 to compile ogengine_sync.c (C) instead.
-OASIS_STAR_SYNC_IN_CLIENT="${OASIS_STAR_SYNC_IN_CLIENT:-1}"
+# Default: compile ogengine_sync.c (C: worker pool, op queues, jobs, stats). Set OASIS_STAR_SYNC_IN_CLIENT=1 to use the star_sync exports from star_api (C#) instead.
+OASIS_STAR_SYNC_IN_CLIENT="${OASIS_STAR_SYNC_IN_CLIENT:-0}"
 BUILD_STAR_CLIENT=0
 # OASIS sprite source: UDB Build or Assets, or ODOOM build/Editor copy. Override with OASIS_SPRITES_SRC.
 ULTIMATE_DOOM_BUILDER_BUILD="${ULTIMATE_DOOM_BUILDER_BUILD:-$HOME/Source/UltimateDoomBuilder/Build}"
@@ -182,6 +182,7 @@ fi
 if [[ -f "$OGENGINECLIENT/ogengine_sync.c" ]]; then
   cp -f "$OGENGINECLIENT/ogengine_sync.c" "$ODOOM_INTEGRATION/"
   cp -f "$OGENGINECLIENT/ogengine_sync.h" "$ODOOM_INTEGRATION/"
+  cp -f "$OGENGINECLIENT/ogengine_sync_coro.h" "$ODOOM_INTEGRATION/"
 fi
 
 echo ""
@@ -191,6 +192,7 @@ cp -f "$ODOOM_INTEGRATION/uzdoom_ogengine_integration.h" "$UZDOOM_SRC/src/"
 cp -f "$OGENGINECLIENT/ogengine.h" "$UZDOOM_SRC/src/"
 [[ -f "$ODOOM_INTEGRATION/ogengine_sync.c" ]] && cp -f "$ODOOM_INTEGRATION/ogengine_sync.c" "$UZDOOM_SRC/src/"
 [[ -f "$ODOOM_INTEGRATION/ogengine_sync.h" ]] && cp -f "$ODOOM_INTEGRATION/ogengine_sync.h" "$UZDOOM_SRC/src/"
+[[ -f "$ODOOM_INTEGRATION/ogengine_sync_coro.h" ]] && cp -f "$ODOOM_INTEGRATION/ogengine_sync_coro.h" "$UZDOOM_SRC/src/"
 cp -f "$ODOOM_INTEGRATION/odoom_branding.h" "$UZDOOM_SRC/src/"
 mkdir -p "$UZDOOM_SRC/wadsrc/static/zscript/actors/doom"
 cp -f "$ODOOM_INTEGRATION/odoom_oquake_keys.zs" "$UZDOOM_SRC/wadsrc/static/zscript/actors/doom/"
@@ -364,13 +366,13 @@ mkdir -p "$UZDOOM_SRC/build/src"
 for destdir in "$UZDOOM_SRC/build" "$UZDOOM_SRC/build/src"; do
   cp -f "$STAR_LIB_SRC" "$destdir/$STAR_LIB_NAME"
 done
-# OASIS_STAR_SYNC_IN_CLIENT: 1 = use star_sync from star_api (C#); 0 = compile ogengine_sync.c (C). See ogengine_sync.h / OASIS Omniverse/Docs/STAR_INTEGRATION_AUDIT.md.
-if [[ "${OASIS_STAR_SYNC_IN_CLIENT:-1}" == "0" ]]; then
-  CMAKE_STAR_SYNC="-DOASIS_STAR_SYNC_IN_CLIENT=OFF"
-  echo "[ODOOM][INFO] Compiling ogengine_sync.c - C implementation"
-else
+# OASIS_STAR_SYNC_IN_CLIENT: 0 = compile ogengine_sync.c (C, default); 1 = use star_sync from star_api (C#). See ogengine_sync.h / OASIS Omniverse/Docs/STAR_INTEGRATION_AUDIT.md.
+if [[ "${OASIS_STAR_SYNC_IN_CLIENT:-0}" == "1" ]]; then
   CMAKE_STAR_SYNC="-DOASIS_STAR_SYNC_IN_CLIENT=ON"
-  echo "[ODOOM][INFO] Using star_sync from star_api - default"
+  echo "[ODOOM][INFO] Using star_sync from star_api - C# exports"
+else
+  CMAKE_STAR_SYNC="-DOASIS_STAR_SYNC_IN_CLIENT=OFF"
+  echo "[ODOOM][INFO] Compiling ogengine_sync.c - C implementation (default)"
 fi
 # Add both ODOOM folder and build/src to link path so -lstar_api resolves
 CMAKE_LINK_FLAGS="-L\"$UZDOOM_SRC/build/src\" -L\"$OGENGINE_LIB_DIR\""
@@ -164,7 +164,7 @@ if (Test-Path $dMainCpp) {
             $changes += "d_main (inventory capture)"
         }
     }
-    # 3a1b. d_main.cpp: call ODOOM_PostTic after TryRunTics so STAR health/armor apply runs after the tic (HUD then shows correct value)
+    # 3a1b. d_main.cpp: call ODOOM_PostTic after TryRunTics so the STAR overlay refreshes once a health/armor apply has landed
     $dContent = Get-Content $dMainCpp -Raw
     if ($dContent -notmatch 'ODOOM_PostTic') {
         if ($dContent -match 'TryRunTics\s*\(\s*\)\s*;[^\r\n]*\r?\n') {
@@ -175,7 +175,7 @@ if (Test-Path $dMainCpp) {
     }
 }
 
-# 3a1c. d_net.cpp: call ODOOM_PostOneTic after every game tic so STAR health/armor re-apply overwrites whatever reverts it during the tic
+# 3a1c. d_net.cpp: call ODOOM_PostOneTic after every game tic; STAR health/armor is written there once, before P_PredictPlayer
 $dNetCpp = "$src\src\d_net.cpp"
 if (Test-Path $dNetCpp) {
     $dnContent = Get-Content $dNetCpp -Raw
@@ -190,7 +190,7 @@ if (Test-Path $dNetCpp) {
     }
     if ($dnChanged) {
         Set-Content $dNetCpp $dnContent -NoNewline
-        $changes += "d_net (post-one-tic health re-apply)"
+        $changes += "d_net (post-one-tic health/armor apply)"
     }
 }
 
@@ -726,7 +726,7 @@ if (Test-Path $aboutPath) {
     }
 }
 
-# 4a. CMake: ensure OASIS_STAR_API and ODOOM_OGENGINE_SESSION_IMPL are passed when -DOASIS_STAR_API=ON. Add option OASIS_STAR_SYNC_IN_CLIENT (use star_sync from DLL; when ON, do not compile star_sync.c). Only patch the existing if(OASIS_STAR_API) block at top of root CMake; do NOT insert before add_subdirectory (that caused hundreds of duplicate blocks).
+# 4a. CMake: ensure OASIS_STAR_API and ODOOM_OGENGINE_SESSION_IMPL are passed when -DOASIS_STAR_API=ON. Add option OASIS_STAR_SYNC_IN_CLIENT (use star_sync from DLL; when ON, do not compile ogengine_sync.c). Only patch the existing if(OASIS_STAR_API) block at top of root CMake; do NOT insert before add_subdirectory (that caused hundreds of duplicate blocks).
 $cmakeRoot = "$src\CMakeLists.txt"
 if (Test-Path $cmakeRoot) {
     $cmakeContent = Get-Content $cmakeRoot -Raw
@@ -743,7 +743,7 @@ if (Test-Path $cmakeRoot) {
         $changes += "cmake(ODOOM_OGENGINE_SESSION_IMPL define)"
     }
     if ($cmakeContent -match 'if\s*\(\s*OASIS_STAR_API\s*\)' -and $cmakeContent -notmatch 'option\s*\(\s*OASIS_STAR_SYNC_IN_CLIENT') {
-        $cmakeContent = $cmakeContent -replace '(if\s*\(\s*OASIS_STAR_API\s*\)\s*\r?\n)(\s*)(add_compile_definitions|set\s*\(\s*OGENGINE_DIR)', "`$1`$2option(OASIS_STAR_SYNC_IN_CLIENT `"Use star_sync from ogengine.dll (C#) instead of compiling star_sync.c`" OFF)`r`n`$2`$3"
+        $cmakeContent = $cmakeContent -replace '(if\s*\(\s*OASIS_STAR_API\s*\)\s*\r?\n)(\s*)(add_compile_definitions|set\s*\(\s*OGENGINE_DIR)', "`$1`$2option(OASIS_STAR_SYNC_IN_CLIENT `"Use star_sync from ogengine.dll (C#) instead of compiling ogengine_sync.c`" OFF)`r`n`$2`$3"
         $cmakeChanged = $true
         $changes += "cmake(option OASIS_STAR_SYNC_IN_CLIENT)"
     }
@@ -754,13 +754,14 @@ if (Test-Path $cmakeRoot) {
     }
     if ($cmakeChanged) { Set-Content -Path $cmakeRoot -Value $cmakeContent -NoNewline }
 }
-# 4b. CMake: add star_sync.c to build when OASIS_STAR_API is used and OASIS_STAR_SYNC_IN_CLIENT is OFF (otherwise use star_sync from ogengine.dll). Use STAR_SYNC_SRC so it is conditional.
+# 4b. CMake: add ogengine_sync.c to build when OASIS_STAR_API is used and OASIS_STAR_SYNC_IN_CLIENT is OFF (the default; ON uses star_sync from ogengine.dll). Use STAR_SYNC_SRC so it is conditional.
+#     Trees patched before the rename still name star_sync.c, which the build scripts no longer copy; point them at ogengine_sync.c.
 $cmakeFiles = @()
 if (Test-Path "$src\CMakeLists.txt") { $cmakeFiles += "$src\CMakeLists.txt" }
 if (Test-Path "$src\src\CMakeLists.txt") { $cmakeFiles += "$src\src\CMakeLists.txt" }
 $starSyncSrcBlock = @"
 if(NOT OASIS_STAR_SYNC_IN_CLIENT)
-  set(STAR_SYNC_SRC star_sync.c)
+  set(STAR_SYNC_SRC ogengine_sync.c)
 else()
   set(STAR_SYNC_SRC "")
 endif()
@@ -769,6 +770,10 @@ foreach ($cmakePath in $cmakeFiles) {
     if (-not (Test-Path $cmakePath)) { continue }
     $cmakeContent = Get-Content $cmakePath -Raw
     $cmakeChanged = $false
+    if ($cmakeContent -match 'set\s*\(\s*STAR_SYNC_SRC\s+star_sync\.c\s*\)') {
+        $cmakeContent = $cmakeContent -replace 'set\s*\(\s*STAR_SYNC_SRC\s+star_sync\.c\s*\)', 'set(STAR_SYNC_SRC ogengine_sync.c)'
+        $cmakeChanged = $true
+    }
     if ($cmakeContent -match 'uzdoom_ogengine_integration\.cpp' -and $cmakeContent -notmatch 'STAR_SYNC_SRC') {
         if ($cmakeContent -match '\r?\n\s*project\s*\([^)]*\)\s*\r?\n') {
             $cmakeContent = $cmakeContent -replace '(\r?\n\s*project\s*\([^)]*\)\s*\r?\n)', "`$1`$starSyncSrcBlock`r`n"
@@ -777,7 +782,7 @@ foreach ($cmakePath in $cmakeFiles) {
             $cmakeContent = $starSyncSrcBlock + "`r`n" + $cmakeContent
             $cmakeChanged = $true
         }
-        if ($cmakeContent -match 'uzdoom_ogengine_integration\.cpp' -and $cmakeContent -notmatch 'star_sync\.c|\$\{STAR_SYNC_SRC\}') {
+        if ($cmakeContent -match 'uzdoom_ogengine_integration\.cpp' -and $cmakeContent -notmatch 'star_sync\.c|ogengine_sync\.c\s*\r?\n|\$\{STAR_SYNC_SRC\}') {
             $cmakeContent = $cmakeContent -replace '(\buzdoom_ogengine_integration\.cpp\b)', "`$1`r`n    `$`{STAR_SYNC_SRC`}"
             $cmakeChanged = $true
         } elseif ($cmakeContent -match 'uzdoom_ogengine_integration\.cpp\s*\r?\n\s*star_sync\.c') {
@@ -786,7 +791,7 @@ foreach ($cmakePath in $cmakeFiles) {
         }
         if ($cmakeChanged) {
             Set-Content -Path $cmakePath -Value $cmakeContent -NoNewline
-            $changes += "cmake(star_sync.c conditional on OASIS_STAR_SYNC_IN_CLIENT)"
+            $changes += "cmake(ogengine_sync.c conditional on OASIS_STAR_SYNC_IN_CLIENT)"
         }
     }
 }
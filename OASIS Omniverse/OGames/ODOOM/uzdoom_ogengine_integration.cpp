@@ -33,6 +33,9 @@ int ogengine_consume_last_mint_result(char* item_name_out, size_t item_name_size
 }
 #endif
 #include "ogengine_sync.h"
+#if __has_include("ogengine_sync_coro.h")
+#include "ogengine_sync_coro.h"
+#endif
 /* C linkage for deliver_result (from star_sync; ensure visible when header is from alternate path). */
 extern "C" void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* list, ogengine_result_t result, const char* error_msg);
 #include "odoom_branding.h"
@@ -46,8 +49,12 @@ extern "C" void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* lis
 #include <algorithm>
 #include <cctype>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 // Windows / MSVC portability
 #ifdef _MSC_VER
@@ -131,10 +138,26 @@ extern "C" void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* lis
 /* Forward declaration so code before the definition (e.g. ODOOM_SaveJsonConfig) can call StarLogInfo. */
 static void StarLogInfo(const char* fmt, ...);
 
-/* OGLib: runtime session forwarders, config, beamin, cross-game utilities. */
+/* OGLib: runtime session forwarders, config, beamin, cross-game utilities.
+ * OGLIB_LOG_ASYNC: oglib_log and star_api.log lines go through the OGLib ring buffer; a flusher thread does the file I/O.
+ * OGLIB_LOG_MIN_LEVEL: keep DEBUG; hot-path OGLIB_LOGD lines are gated on star debug at the call site and compile out with -DOGLIB_LOG_COMPILE_LEVEL=1.
+ * OGLIB_TRACE_ENABLE: spans/instants for "star trace" (recording stays off until "star trace on"). */
+#ifndef OGLIB_LOG_MIN_LEVEL
+#define OGLIB_LOG_MIN_LEVEL OGLIB_LOG_DEBUG
+#endif
 #define OGLIB_SESSION_IMPL
+#define OGLIB_CONFIG_IMPL
+#define OGLIB_BEAMIN_IMPL
+#define OGLIB_LOG_IMPL
+#define OGLIB_LOG_ASYNC
+#define OGLIB_TRACE_IMPL
+#define OGLIB_TRACE_ENABLE
+#define OGLIB_EVENTS_IMPL
 #include "../../OGLib/oglib.h"
 
+/** Per-frame cap on STAR completion callbacks when the C sync provides ogengine_sync_pump_budget; the rest run next frame. */
+#define ODOOM_SYNC_PUMP_BUDGET_US 2000
+
 static ogengine_config_t g_star_config;
 /** 0 = merge quest progress into local STAR client cache (no GET). 1 = full GET all quests after each progress. From oasisstar.json quest_progress_refresh. */
 static int g_odoom_quest_progress_cache_refresh = 0;
@@ -152,6 +175,10 @@ static bool g_star_logged_missing_auth_config = false;
 static bool g_odoom_pending_loading_tracker = false;
 /** Set true when STAR API invokes operation callback with ProfileLoaded success; frame pump then fills tracker from cache (audit: single source of truth for "profile loaded"). */
 static bool g_odoom_profile_loaded_pending = false;
+/** Set when beam-in launched profile, inventory and quests together (oglib_beamin_prefetch); the ProfileLoaded handler then skips re-requesting them. */
+static bool g_odoom_beamin_prefetched = false;
+/** Beam-in state machine (OGLib): armed on auth success / session restore, fed from the operation callback, polled after the sync pump. done_cb is ODOOM_OnBeaminDone. */
+static oglib_beamin_ctx_t g_odoom_beamin = {};
 /** Set true when operation_callback(OGENGINE_OP_GET_INVENTORY) fires; frame pump then applies cache to CVars. */
 static bool g_odoom_inventory_refresh_pending = false;
 /** Set true when an objective was just completed (keycard/console); frame pump refreshes tracker on next frame. */
@@ -187,19 +214,32 @@ static const int g_star_generic_debounce_ticks = 18;  /* ~0.5s at 35 tics/sec */
 /** Player stats before touch: only add to STAR when engine would leave item on floor (did not apply to player). */
 static int g_star_pre_touch_health = -1;
 static int g_star_pre_touch_armor = -1;
-/** When user presses E on a STAR item in inventory, we store name/type/description for the use-item callback to apply Health/Armor. */
-static std::string g_star_use_pending_name;
-static std::string g_star_use_pending_type;
-static std::string g_star_use_pending_description;
-/** Deferred apply: set when use-item succeeds; applied at start of next frame. Re-apply for several frames so HUD/status bar sees the update. */
-static std::string g_star_deferred_apply_name;
-static std::string g_star_deferred_apply_type;
-static std::string g_star_deferred_apply_description;
-static int g_star_deferred_apply_frames = 0;  /* number of frames left to re-apply (e.g. 3) */
-static int g_star_deferred_health_value = -1; /* target health to re-assign on next frames (avoids engine overwrite) */
-static int g_star_deferred_armor_value = -1;
-static bool g_star_deferred_apply_health = false;
-static bool g_star_deferred_apply_armor = false;
+/** When user uses a STAR item from inventory, name/type/description ride along as the use-item op's user_data so the callback can apply Health/Armor. */
+struct ODOOM_PendingUse {
+	std::string name;
+	std::string type;
+	std::string description;
+	bool in_use = false;   /* optimistic use: slot held until the server answers */
+	bool apply_pending = false;  /* optimistic use: health/armor not applied yet (PostOneTic) */
+	int health_gain = 0;   /* optimistic use: what the deferred apply added, undone on rollback */
+	int armor_gain = 0;
+};
+/** Deferred apply: every use-item that succeeded (or was applied optimistically) is applied by ODOOM_PostOneTic inside
+ *  the next game tic, each once, however many arrive before it runs (double press, paused game).
+ *  Writes made between tics land on the predicted player and are undone by P_UnPredictPlayer, so the tic owns them. */
+static int g_star_deferred_apply_count = 0;  /* uses waiting for PostOneTic */
+static bool g_star_deferred_apply_landed = false;  /* applied during the last TryRunTics; PostTic refreshes the overlay */
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+/** Optimistic uses the server has not answered or not yet applied; apply claims a slot, commit/rollback and the
+ *  deferred apply release it. Each slot carries its own pending apply. */
+static ODOOM_PendingUse g_odoom_optimistic_uses[OGENGINE_SYNC_MAX_PENDING_USES];
+/** Health/armor to take back from rejected optimistic uses; PostOneTic removes it in the next tic. */
+static int g_star_deferred_rollback_health = 0;
+static int g_star_deferred_rollback_armor = 0;
+#else
+/** Successful uses waiting for PostOneTic, in completion order. */
+static std::vector<ODOOM_PendingUse> g_star_deferred_applies;
+#endif
 static bool g_star_face_suppressed_for_session = false;
 /** Single source of truth for status bar face; only set by star face on/off and beam-in/out. */
 static bool g_star_show_anorak_face = false;
@@ -220,6 +260,10 @@ static bool g_star_async_auth_pending = false;
 static int g_star_async_auth_pending_frames = 0;
 /** True after we showed timeout once this pending attempt; reset when starting a new async auth. */
 static bool g_star_beamin_timeout_was_shown = false;
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+/** Handle of the async auth; it carries the config timeout, so a hung SSO fails through ODOOM_OnAuthDone and can be retried. */
+static ogengine_sync_op_t g_star_auth_op = OGENGINE_SYNC_OP_NONE;
+#endif
 static bool StarInitialized(void);
 CVAR(Bool, oasis_star_anorak_face, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 CVAR(Bool, oasis_star_beam_face, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
@@ -272,6 +316,480 @@ CVAR(Int, odoom_star_use_health_on_pickup, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 CVAR(Int, odoom_star_use_armor_on_pickup, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 CVAR(Int, odoom_star_use_powerup_on_pickup, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 
+static int ODOOM_ConfigMaxHealth(void) { const int v = odoom_star_max_health; return v > 0 ? v : 200; }
+static int ODOOM_ConfigMaxArmor(void) { const int v = odoom_star_max_armor; return v > 0 ? v : 200; }
+
+/* CVars the ZScript overlay declares in odoom_cvarinfo.txt (the engine creates them at load, so they have no
+ * C++ symbol). Resolved once into typed handles by ODOOM_BindCVars() instead of FindCVar on every use.
+ * X(Int|String, name) */
+#define ODOOM_CVARINFO_CVARS(X) \
+	X(Int, odoom_inventory_open) \
+	X(Int, odoom_key_up) \
+	X(Int, odoom_key_down) \
+	X(Int, odoom_key_left) \
+	X(Int, odoom_key_right) \
+	X(Int, odoom_key_pgup) \
+	X(Int, odoom_key_pgdown) \
+	X(Int, odoom_key_home) \
+	X(Int, odoom_key_end) \
+	X(Int, odoom_key_b) \
+	X(Int, odoom_key_n) \
+	X(Int, odoom_key_m) \
+	X(Int, odoom_key_v) \
+	X(Int, odoom_key_d) \
+	X(Int, odoom_key_use) \
+	X(Int, odoom_key_a) \
+	X(Int, odoom_key_c) \
+	X(Int, odoom_key_z) \
+	X(Int, odoom_key_x) \
+	X(Int, odoom_key_i) \
+	X(Int, odoom_key_o) \
+	X(Int, odoom_key_p) \
+	X(Int, odoom_key_s) \
+	X(Int, odoom_key_q) \
+	X(Int, odoom_key_enter) \
+	X(Int, odoom_key_backspace) \
+	X(Int, odoom_key_k) \
+	X(Int, odoom_key_t) \
+	X(Int, odoom_send_popup_open) \
+	X(String, odoom_send_input_line) \
+	X(Int, odoom_send_do_it) \
+	X(String, odoom_send_target) \
+	X(String, odoom_send_item_class) \
+	X(Int, odoom_send_quantity) \
+	X(Int, odoom_send_to_clan) \
+	X(String, odoom_send_status) \
+	X(Int, odoom_send_last_char) \
+	X(Int, odoom_star_inventory_count) \
+	X(Int, odoom_star_inventory_scroll_offset) \
+	X(Int, odoom_star_inventory_tab) \
+	X(Int, odoom_star_beamed_in) \
+	X(Int, odoom_star_has_gold_key) \
+	X(Int, odoom_star_has_silver_key) \
+	X(Int, odoom_star_avatar_xp) \
+	X(Int, odoom_star_avatar_karma) \
+	X(String, odoom_star_use_item_name) \
+	X(String, odoom_star_use_item_type) \
+	X(String, odoom_star_use_item_description) \
+	X(Int, odoom_star_use_do_it) \
+	X(String, odoom_star_toast_message) \
+	X(Int, odoom_star_toast_frames) \
+	X(Int, odoom_star_pickup_toast_frames) \
+	X(String, odoom_quest_tracker_title) \
+	X(String, odoom_quest_tracker_objective) \
+	X(String, odoom_quest_tracker_objectives) \
+	X(Int, odoom_quest_tracker_active_index) \
+	X(String, odoom_quest_tracker_active_objective_id) \
+	X(Int, odoom_quest_persist_active_now) \
+	X(Int, odoom_quest_popup_open) \
+	X(Int, odoom_quest_count) \
+	X(String, odoom_quest_scroll_to_id) \
+	X(Int, odoom_quest_pending_select_filtered_index) \
+	X(String, odoom_quest_set_active_id) \
+	X(Int, odoom_quest_set_active_do_it) \
+	X(Int, odoom_quest_start_then_track_do_it) \
+	X(String, odoom_quest_selected_id) \
+	X(String, odoom_quest_tracker_quest_id) \
+	X(Int, odoom_quest_filter_not_started) \
+	X(Int, odoom_quest_filter_in_progress) \
+	X(Int, odoom_quest_filter_completed) \
+	X(Int, odoom_quest_scroll_offset) \
+	X(String, odoom_quest_detail_quest_id) \
+	X(String, odoom_quest_detail_prereqs) \
+	X(String, odoom_quest_detail_objectives) \
+	X(String, odoom_quest_detail_subquests) \
+	X(String, odoom_quest_detail_selected_objective_id) \
+	X(String, odoom_quest_detail_requirements)
+
+struct ODOOM_CVarBindings {
+#define ODOOM_CVAR_HANDLE(type, name) F##type##CVar* name;
+	ODOOM_CVARINFO_CVARS(ODOOM_CVAR_HANDLE)
+#undef ODOOM_CVAR_HANDLE
+};
+/** Cached handles; nullptr when odoom_cvarinfo.txt did not define the CVar (every use tolerates that). */
+static ODOOM_CVarBindings g_odoom_cv = {};
+/** True once the missing CVars have been retried on the first frame and reported. */
+static bool g_odoom_cv_final = false;
+
+/** Resolve every handle still unbound (wrong type counts as missing). Returns how many are missing; names go to *missing_names. */
+static int ODOOM_BindCVars(std::string* missing_names) {
+	int missing = 0;
+#define ODOOM_CVAR_BIND(type, name) \
+	if (!g_odoom_cv.name) { \
+		FBaseCVar* cv = FindCVar(#name, nullptr); \
+		if (cv && cv->GetRealType() == CVAR_##type) g_odoom_cv.name = static_cast<F##type##CVar*>(cv); \
+		else { missing++; if (missing_names) *missing_names += missing_names->empty() ? #name : ", " #name; } \
+	}
+	ODOOM_CVARINFO_CVARS(ODOOM_CVAR_BIND)
+#undef ODOOM_CVAR_BIND
+	return missing;
+}
+
+static inline int ODOOM_GetCVar(FIntCVar* cv, int fallback = 0) { return cv ? **cv : fallback; }
+static inline const char* ODOOM_GetCVar(FStringCVar* cv) { return cv ? **cv : ""; }
+/** Write only when the value changed: every SetGenericRep runs the CVar callback and a string write copies. */
+static inline void ODOOM_SetCVar(FIntCVar* cv, int value) {
+	if (cv && **cv != value) *cv = value;
+}
+static inline void ODOOM_SetCVar(FStringCVar* cv, const char* value) {
+	if (!value) value = "";
+	if (cv && std::strcmp(**cv, value) != 0) *cv = value;
+}
+
+/** Top-center toast for the given frames (35 = 1 s); ZScript draws it while odoom_star_toast_frames > 0. */
+static void ODOOM_ShowToast(const char* msg, int frames) {
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_toast_message, msg);
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_toast_frames, frames);
+}
+
+/** Boss NFT mint: ogengine_create_monster_nft is a blockchain round trip that can take seconds, so it runs on an
+ * ogengine_sync pool worker (a detached thread when the pool is unavailable) and ODOOM_PumpBossNftMints reports the
+ * result from the frame pump, next to ogengine_consume_last_mint_result. Every mint is counted until its worker returns;
+ * UZDoom_STAR_Cleanup waits for them (ODOOM_WaitBossNftMints) before the client is torn down. */
+#define ODOOM_BOSS_NFT_SHUTDOWN_GRACE_MS 3000
+struct ODOOM_BossNftMint {
+	std::string bossName, desc, provider;
+	ogengine_result_t result = OGENGINE_ERROR_NETWORK;
+	char nftId[128] = {};
+};
+struct ODOOM_BossNftQueue {
+	std::mutex mutex;
+	std::condition_variable idle;           /* signalled when outstanding drops to 0 */
+	std::vector<ODOOM_BossNftMint*> done;
+	int outstanding = 0;                    /* submitted, worker not yet returned */
+	bool closed = false;                    /* cleanup gave up waiting: late workers drop their result */
+};
+/* Never freed: a mint still running after cleanup gives up waiting may finish during static destruction. */
+static ODOOM_BossNftQueue& g_odoom_boss_nft = *new ODOOM_BossNftQueue();
+static std::atomic<int> g_odoom_boss_nft_done_count{0};
+
+/** Error text for a mint result. The worker cannot use ogengine_get_last_error: it is client-global and the main
+ * thread's own calls overwrite it while the mint is in flight. */
+static const char* ODOOM_BossNftResultText(ogengine_result_t r) {
+	switch (r) {
+	case OGENGINE_ERROR_INIT_FAILED: return "client init failed";
+	case OGENGINE_ERROR_NOT_INITIALIZED: return "client not initialized";
+	case OGENGINE_ERROR_NETWORK: return "network error";
+	case OGENGINE_ERROR_INVALID_PARAM: return "invalid parameter";
+	case OGENGINE_ERROR_API_ERROR: return "API error (see star_api.log)";
+	default: return "unknown error";
+	}
+}
+
+static void ODOOM_BossNftMintRun(void* arg) {
+	ODOOM_BossNftMint* mint = static_cast<ODOOM_BossNftMint*>(arg);
+	mint->result = ogengine_create_monster_nft(mint->bossName.c_str(), mint->desc.c_str(), "ODOOM", "{}",
+		mint->provider.empty() ? nullptr : mint->provider.c_str(), mint->nftId);
+	std::lock_guard<std::mutex> lock(g_odoom_boss_nft.mutex);
+	if (g_odoom_boss_nft.closed) {
+		delete mint;
+	} else {
+		g_odoom_boss_nft.done.push_back(mint);
+		g_odoom_boss_nft_done_count.fetch_add(1, std::memory_order_release);
+	}
+	if (--g_odoom_boss_nft.outstanding == 0)
+		g_odoom_boss_nft.idle.notify_all();
+}
+
+static void ODOOM_StartBossNftMint(const char* boss_name, const char* desc) {
+	ODOOM_BossNftMint* mint = new ODOOM_BossNftMint();
+	mint->bossName = boss_name;
+	mint->desc = desc ? desc : "";
+	const char* prov = (const char*)odoom_star_nft_provider;
+	mint->provider = prov ? prov : "";
+	{
+		std::lock_guard<std::mutex> lock(g_odoom_boss_nft.mutex);
+		g_odoom_boss_nft.outstanding++;
+		g_odoom_boss_nft.closed = false;
+	}
+#ifdef OGENGINE_SYNC_HAS_JOBS
+	if (ogengine_sync_job_submit(&ODOOM_BossNftMintRun, mint)) return;
+#endif
+	std::thread(ODOOM_BossNftMintRun, mint).detach();
+}
+
+/** Cleanup: wait up to grace_ms for in-flight mints, then drop unreported results. Returns false when a mint is still
+ * inside the client (its result is dropped when it returns), so the caller must not tear the client down. */
+static bool ODOOM_WaitBossNftMints(int grace_ms) {
+	std::vector<ODOOM_BossNftMint*> dropped;
+	bool idle;
+	{
+		std::unique_lock<std::mutex> lock(g_odoom_boss_nft.mutex);
+		idle = g_odoom_boss_nft.idle.wait_for(lock, std::chrono::milliseconds(grace_ms),
+			[] { return g_odoom_boss_nft.outstanding == 0; });
+		if (!idle) g_odoom_boss_nft.closed = true;
+		dropped.swap(g_odoom_boss_nft.done);
+		g_odoom_boss_nft_done_count.store(0, std::memory_order_relaxed);
+	}
+	for (ODOOM_BossNftMint* mint : dropped) delete mint;
+	return idle;
+}
+
+/** Main thread: print and toast finished boss mints. Takes no lock while nothing has finished. */
+static void ODOOM_PumpBossNftMints(void) {
+	if (g_odoom_boss_nft_done_count.load(std::memory_order_acquire) == 0) return;
+	std::vector<ODOOM_BossNftMint*> done;
+	{
+		std::lock_guard<std::mutex> lock(g_odoom_boss_nft.mutex);
+		done.swap(g_odoom_boss_nft.done);
+		g_odoom_boss_nft_done_count.store(0, std::memory_order_relaxed);
+	}
+	char toast[192];
+	for (ODOOM_BossNftMint* mint : done) {
+		if (mint->result == OGENGINE_SUCCESS) {
+			Printf(PRINT_HIGH, "WEB4 OASIS API: Boss NFT created for \"%s\". ID: %s\n", mint->bossName.c_str(), mint->nftId[0] ? mint->nftId : "(none)");
+			std::snprintf(toast, sizeof(toast), "Boss NFT minted: %s", mint->bossName.c_str());
+		} else {
+			Printf(PRINT_HIGH, "WEB4 OASIS API: Boss NFT failed for \"%s\": %s\n", mint->bossName.c_str(), ODOOM_BossNftResultText(mint->result));
+			std::snprintf(toast, sizeof(toast), "Boss NFT failed: %s", mint->bossName.c_str());
+		}
+		ODOOM_ShowToast(toast, 175);  /* ~5 s at 35 fps */
+		delete mint;
+	}
+}
+
+/** STAR console scripting ("star batch <file>", "star async <subcommand>"): each command runs on an ogengine_sync pool
+ * worker (a detached thread when the pool is unavailable), so seeding or validating thousands of items does not freeze
+ * the game. Commands run one at a time and read the client's last error, so a failure is reported against the command
+ * that caused it. Lookups (has) never reach a worker: the first one fetches the inventory once and every lookup until
+ * the next mutating command is answered from that snapshot on the main thread. Uses go through the sync use-item
+ * family, serialized with the game's own uses. ODOOM_PumpStarBatch feeds the workers and reports from the frame pump. */
+#define ODOOM_STAR_BATCH_FAILURES_SHOWN 20
+enum ODOOM_StarBatchOp {
+	ODOOM_STAR_BATCH_HAS,         /* answered on the main thread from the inventory snapshot */
+	ODOOM_STAR_BATCH_ADD,         /* only queued in the client (main thread); one flush job once all are queued */
+	ODOOM_STAR_BATCH_USE,
+	ODOOM_STAR_BATCH_QUEST_START,
+	ODOOM_STAR_BATCH_QUEST_OBJECTIVE,
+	ODOOM_STAR_BATCH_QUEST_COMPLETE,
+	ODOOM_STAR_BATCH_DEPLOY_NFT,
+	ODOOM_STAR_BATCH_FLUSH_ADDS,
+	ODOOM_STAR_BATCH_FETCH_INVENTORY  /* internal: snapshot for the lookups; not counted as a command */
+};
+struct ODOOM_StarBatchCmd {
+	ODOOM_StarBatchOp op = ODOOM_STAR_BATCH_HAS;
+	std::string arg[3];
+	int line = 0;
+	bool ok = false;
+	std::string error;
+	ogengine_item_list_t* inventory = nullptr;  /* FETCH_INVENTORY result; freed by the main thread */
+};
+/** The running batch. Main thread only; workers only touch their own command and the done list. */
+struct ODOOM_StarBatch {
+	std::vector<ODOOM_StarBatchCmd> cmds;
+	ODOOM_StarBatchCmd fetch;
+	std::string source;
+	size_t next = 0, done = 0, failed = 0;
+	int inFlight = 0;
+	bool active = false, cancelled = false, verbose = false;
+	bool haveFetched = false;               /* have/haveError hold a snapshot taken since the last mutating command */
+	std::unordered_set<std::string> have;  /* lowercased item names (has_item matches case-insensitively) */
+	std::string haveError;                  /* non-empty: the snapshot fetch failed and lookups report this */
+	int64_t startMs = 0, lastReportMs = 0;
+};
+static ODOOM_StarBatch g_odoom_star_batch;
+static std::mutex g_odoom_star_batch_mutex;
+static std::vector<ODOOM_StarBatchCmd*> g_odoom_star_batch_done;
+static std::atomic<int> g_odoom_star_batch_done_count{0};
+
+static const char* ODOOM_StarBatchOpName(ODOOM_StarBatchOp op) {
+	switch (op) {
+		case ODOOM_STAR_BATCH_HAS: return "has";
+		case ODOOM_STAR_BATCH_ADD: return "add";
+		case ODOOM_STAR_BATCH_USE: return "use";
+		case ODOOM_STAR_BATCH_QUEST_START: return "quest start";
+		case ODOOM_STAR_BATCH_QUEST_OBJECTIVE: return "quest objective";
+		case ODOOM_STAR_BATCH_QUEST_COMPLETE: return "quest complete";
+		case ODOOM_STAR_BATCH_DEPLOY_NFT: return "deploynft";
+		case ODOOM_STAR_BATCH_FLUSH_ADDS: return "flush adds";
+		case ODOOM_STAR_BATCH_FETCH_INVENTORY: return "inventory";
+	}
+	return "?";
+}
+
+static void ODOOM_StarBatchFinished(ODOOM_StarBatchCmd* cmd) {
+	std::lock_guard<std::mutex> lock(g_odoom_star_batch_mutex);
+	g_odoom_star_batch_done.push_back(cmd);
+	g_odoom_star_batch_done_count.fetch_add(1, std::memory_order_release);
+}
+
+static void ODOOM_StarBatchRun(void* arg) {
+	ODOOM_StarBatchCmd* cmd = static_cast<ODOOM_StarBatchCmd*>(arg);
+	ogengine_result_t r = OGENGINE_SUCCESS;
+	const char* a0 = cmd->arg[0].c_str();
+	const char* a1 = cmd->arg[1].c_str();
+	switch (cmd->op) {
+		case ODOOM_STAR_BATCH_FETCH_INVENTORY:
+			r = ogengine_get_inventory(&cmd->inventory);
+			if (r == OGENGINE_SUCCESS && !cmd->inventory) r = OGENGINE_ERROR_API_ERROR;
+			break;
+		case ODOOM_STAR_BATCH_QUEST_START: r = ogengine_start_quest(a0); break;
+		case ODOOM_STAR_BATCH_QUEST_OBJECTIVE: r = ogengine_complete_quest_objective(a0, a1, "ODOOM"); break;
+		case ODOOM_STAR_BATCH_QUEST_COMPLETE: r = ogengine_complete_quest(a0); break;
+		case ODOOM_STAR_BATCH_DEPLOY_NFT: r = ogengine_deploy_boss_nft(a0, a1, cmd->arg[2].c_str()); break;
+		case ODOOM_STAR_BATCH_FLUSH_ADDS: r = ogengine_flush_add_item_jobs(); break;
+		case ODOOM_STAR_BATCH_HAS:  /* main thread: inventory snapshot */
+		case ODOOM_STAR_BATCH_ADD:
+		case ODOOM_STAR_BATCH_USE:  /* main thread: ogengine_sync_use_item_start */
+			break;
+	}
+	cmd->ok = (r == OGENGINE_SUCCESS);
+	if (!cmd->ok) {
+		const char* err = ogengine_get_last_error();
+		cmd->error = err && err[0] ? err : "unknown";
+	}
+	ODOOM_StarBatchFinished(cmd);
+}
+
+static void ODOOM_StarBatchUseDone(void* user_data) {
+	ODOOM_StarBatchCmd* cmd = static_cast<ODOOM_StarBatchCmd*>(user_data);
+	int success = 0;
+	char err_buf[384] = {};
+	ogengine_sync_use_item_get_result(&success, err_buf, sizeof(err_buf));
+	cmd->ok = success != 0;
+	if (!cmd->ok) cmd->error = err_buf[0] ? err_buf : "unknown";
+	ODOOM_StarBatchFinished(cmd);
+}
+
+static void ODOOM_SubmitStarBatchCmd(ODOOM_StarBatchCmd* cmd) {
+	g_odoom_star_batch.inFlight++;
+	if (cmd->op == ODOOM_STAR_BATCH_USE) {
+		/* One queue + flush at a time for the whole game: the sync use-item family owns it. */
+		ogengine_sync_use_item_start(cmd->arg[0].c_str(), cmd->arg[1].c_str(), &ODOOM_StarBatchUseDone, cmd);
+		return;
+	}
+#ifdef OGENGINE_SYNC_HAS_JOBS
+	if (ogengine_sync_job_submit(&ODOOM_StarBatchRun, cmd)) return;
+#endif
+	std::thread(ODOOM_StarBatchRun, cmd).detach();
+}
+
+/** Start running cmds (false if a batch is still running). verbose: print every result (star async). */
+static bool ODOOM_StartStarBatch(std::vector<ODOOM_StarBatchCmd>&& cmds, const char* source, bool verbose) {
+	ODOOM_StarBatch& b = g_odoom_star_batch;
+	if (b.active) return false;
+	bool anyAdd = false;
+	for (const ODOOM_StarBatchCmd& cmd : cmds) anyAdd |= (cmd.op == ODOOM_STAR_BATCH_ADD);
+	b.cmds = std::move(cmds);
+	if (anyAdd) {
+		ODOOM_StarBatchCmd flush;
+		flush.op = ODOOM_STAR_BATCH_FLUSH_ADDS;
+		b.cmds.push_back(flush);  /* after every add has been queued: commands start in order */
+	}
+	b.source = source;
+	b.next = b.done = b.failed = 0;
+	b.inFlight = 0;
+	b.haveFetched = false;
+	b.have.clear();
+	b.haveError.clear();
+	b.active = true;
+	b.cancelled = false;
+	b.verbose = verbose;
+	b.startMs = b.lastReportMs = oglib_time_now_ms();
+	return true;
+}
+
+static void ODOOM_StarBatchReport(ODOOM_StarBatch& b, const ODOOM_StarBatchCmd* cmd) {
+	b.done++;
+	if (!cmd->ok) b.failed++;
+	if (b.verbose)
+		Printf("star %s %s: %s\n", ODOOM_StarBatchOpName(cmd->op), cmd->arg[0].c_str(), cmd->ok ? "ok" : cmd->error.c_str());
+	else if (!cmd->ok && b.failed <= ODOOM_STAR_BATCH_FAILURES_SHOWN)
+		Printf("star batch: line %d: %s %s failed: %s\n", cmd->line, ODOOM_StarBatchOpName(cmd->op), cmd->arg[0].c_str(), cmd->error.c_str());
+}
+
+/** Main thread: turn a finished FETCH_INVENTORY into the lookup snapshot. */
+static void ODOOM_StarBatchTakeInventory(ODOOM_StarBatch& b, ODOOM_StarBatchCmd* fetch) {
+	b.have.clear();
+	b.haveError.clear();
+	if (fetch->ok && fetch->inventory) {
+		for (size_t i = 0; i < fetch->inventory->count; i++) {
+			std::string name = fetch->inventory->items[i].name;
+			for (auto& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			if (!name.empty()) b.have.insert(std::move(name));
+		}
+	} else {
+		b.haveError = "inventory fetch failed: " + fetch->error;
+	}
+	if (fetch->inventory) ogengine_free_item_list(fetch->inventory);
+	fetch->inventory = nullptr;
+	b.haveFetched = true;
+}
+
+/** Main thread: collect the finished command, answer lookups from the inventory snapshot, start the next command,
+ * report progress once a second. */
+static void ODOOM_PumpStarBatch(void) {
+	ODOOM_StarBatch& b = g_odoom_star_batch;
+	if (!b.active) return;
+	if (g_odoom_star_batch_done_count.load(std::memory_order_acquire) != 0) {
+		std::vector<ODOOM_StarBatchCmd*> done;
+		{
+			std::lock_guard<std::mutex> lock(g_odoom_star_batch_mutex);
+			done.swap(g_odoom_star_batch_done);
+			g_odoom_star_batch_done_count.store(0, std::memory_order_relaxed);
+		}
+		for (ODOOM_StarBatchCmd* cmd : done) {
+			b.inFlight--;
+			if (cmd->op == ODOOM_STAR_BATCH_FETCH_INVENTORY) ODOOM_StarBatchTakeInventory(b, cmd);
+			else ODOOM_StarBatchReport(b, cmd);
+		}
+	}
+	while (!b.cancelled && b.next < b.cmds.size() && b.inFlight == 0) {
+		ODOOM_StarBatchCmd* cmd = &b.cmds[b.next];
+		if (cmd->op == ODOOM_STAR_BATCH_ADD) {
+			ogengine_queue_add_item(cmd->arg[0].c_str(), cmd->arg[1].c_str(), "ODOOM", cmd->arg[2].c_str(), nullptr, 1, 1);
+			cmd->ok = true;
+			b.done++;
+			b.next++;
+			continue;
+		}
+		if (cmd->op == ODOOM_STAR_BATCH_HAS) {
+			if (!b.haveFetched) {
+				b.fetch = ODOOM_StarBatchCmd();
+				b.fetch.op = ODOOM_STAR_BATCH_FETCH_INVENTORY;
+				ODOOM_SubmitStarBatchCmd(&b.fetch);
+				break;
+			}
+			std::string name = cmd->arg[0];
+			for (auto& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			cmd->ok = b.haveError.empty() && b.have.count(name) != 0;
+			if (!cmd->ok) cmd->error = b.haveError.empty() ? "not in inventory" : b.haveError;
+			ODOOM_StarBatchReport(b, cmd);
+			b.next++;
+			continue;
+		}
+#ifndef OGENGINE_SYNC_HAS_OP_QUEUES
+		if (cmd->op == ODOOM_STAR_BATCH_USE && ogengine_sync_use_item_in_progress()) break;  /* one use slot: a start now would be dropped */
+#endif
+		b.next++;
+		b.haveFetched = false;  /* it may change the inventory: the next lookup refetches */
+		ODOOM_SubmitStarBatchCmd(cmd);
+	}
+	const int64_t now = oglib_time_now_ms();
+	char msg[192];
+	if (b.inFlight > 0 || (!b.cancelled && b.next < b.cmds.size())) {
+		if (!b.verbose && now - b.lastReportMs >= 1000) {
+			b.lastReportMs = now;
+			std::snprintf(msg, sizeof(msg), "STAR batch: %zu/%zu done, %zu failed", b.done, b.cmds.size(), b.failed);
+			Printf("%s\n", msg);
+			ODOOM_ShowToast(msg, 50);
+		}
+		return;
+	}
+	if (!b.verbose) {
+		const double secs = (double)(now - b.startMs) / 1000.0;
+		std::snprintf(msg, sizeof(msg), "STAR batch %s: %zu/%zu done, %zu failed", b.cancelled ? "cancelled" : "finished",
+			b.done, b.cmds.size(), b.failed);
+		Printf("%s (%s, %.1f s, %.0f/s)\n", msg, b.source.c_str(), secs, secs > 0.0 ? (double)b.done / secs : 0.0);
+		if (b.failed > ODOOM_STAR_BATCH_FAILURES_SHOWN)
+			Printf("  (%zu more failures not shown)\n", b.failed - ODOOM_STAR_BATCH_FAILURES_SHOWN);
+		ODOOM_ShowToast(msg, 175);  /* ~5 s at 35 fps */
+	}
+	b.active = false;
+	b.cmds.clear();
+	b.have.clear();
+}
+
 /** Per-monster mint flag: 1 = mint NFT when killed, 0 = off. Keys = normalized config key (e.g. odoom_zombieman, oquake_ogre). */
 static std::map<std::string, int> g_odoom_mint_monster_flags;
 struct ODOOM_MonsterEntry { const char* engineName; const char* configKey; const char* displayName; int xp; int isBoss; };
@@ -579,6 +1097,7 @@ static bool ODOOM_TryApplyCrossGameBeamInTransfers(void) {
 }
 
 static bool ODOOM_LoadJsonConfig(const char* json_path) {
+	OGLIB_TRACE_SCOPE("ODOOM_LoadJsonConfig", "odoom");
 	FILE* f = fopen(json_path, "r");
 	if (!f) return false;
 	char json[4096] = {0};
@@ -725,28 +1244,19 @@ static bool ODOOM_LoadJsonConfig(const char* json_path) {
 	}
 	if (loaded) {
 		/* Apply mint and nft_provider to engine cvars so they persist (ini may have loaded 0 before this). */
-		UCVarValue u;
-		FBaseCVar* v = nullptr;
-		u.Int = odoom_star_mint_weapons ? 1 : 0; v = FindCVar("odoom_star_mint_weapons", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_mint_armor ? 1 : 0; v = FindCVar("odoom_star_mint_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_mint_powerups ? 1 : 0; v = FindCVar("odoom_star_mint_powerups", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_mint_keys ? 1 : 0; v = FindCVar("odoom_star_mint_keys", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		v = FindCVar("odoom_star_nft_provider", nullptr);
-		if (v && v->GetRealType() == CVAR_String) {
-			UCVarValue vs; vs.String = (char*)(const char*)odoom_star_nft_provider;
-			v->SetGenericRep(vs, CVAR_String);
-		}
-		v = FindCVar("odoom_star_send_to_address_after_minting", nullptr);
-		if (v && v->GetRealType() == CVAR_String) {
-			UCVarValue vs; vs.String = (char*)(const char*)odoom_star_send_to_address_after_minting;
-			v->SetGenericRep(vs, CVAR_String);
-		}
-		u.Int = odoom_star_always_add_items_to_inventory ? 1 : 0; v = FindCVar("odoom_star_always_add_items_to_inventory", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_max_health; v = FindCVar("odoom_star_max_health", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_max_armor; v = FindCVar("odoom_star_max_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_use_health_on_pickup ? 1 : 0; v = FindCVar("odoom_star_use_health_on_pickup", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_use_armor_on_pickup ? 1 : 0; v = FindCVar("odoom_star_use_armor_on_pickup", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
-		u.Int = odoom_star_use_powerup_on_pickup ? 1 : 0; v = FindCVar("odoom_star_use_powerup_on_pickup", nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(u, CVAR_Int);
+		UCVarValue vs;
+		odoom_star_mint_weapons = odoom_star_mint_weapons ? 1 : 0;
+		odoom_star_mint_armor = odoom_star_mint_armor ? 1 : 0;
+		odoom_star_mint_powerups = odoom_star_mint_powerups ? 1 : 0;
+		odoom_star_mint_keys = odoom_star_mint_keys ? 1 : 0;
+		vs.String = (char*)(const char*)odoom_star_nft_provider;
+		odoom_star_nft_provider.SetGenericRep(vs, CVAR_String);
+		vs.String = (char*)(const char*)odoom_star_send_to_address_after_minting;
+		odoom_star_send_to_address_after_minting.SetGenericRep(vs, CVAR_String);
+		odoom_star_always_add_items_to_inventory = odoom_star_always_add_items_to_inventory ? 1 : 0;
+		odoom_star_use_health_on_pickup = odoom_star_use_health_on_pickup ? 1 : 0;
+		odoom_star_use_armor_on_pickup = odoom_star_use_armor_on_pickup ? 1 : 0;
+		odoom_star_use_powerup_on_pickup = odoom_star_use_powerup_on_pickup ? 1 : 0;
 	}
 	if (g_star_client_ready)
 		ogengine_set_quest_progress_cache_refresh(g_odoom_quest_progress_cache_refresh);
@@ -755,6 +1265,7 @@ static bool ODOOM_LoadJsonConfig(const char* json_path) {
 }
 
 static bool ODOOM_SaveJsonConfig(const char* json_path) {
+	OGLIB_TRACE_SCOPE("ODOOM_SaveJsonConfig", "odoom");
 	FILE* f = fopen(json_path, "w");
 	if (!f) return false;
 	const char* star_url = (const char*)odoom_ogengine_url;
@@ -805,17 +1316,8 @@ static bool ODOOM_SaveJsonConfig(const char* json_path) {
 		fprintf(f, "\",\n");
 	}
 	{
-		int ap = 1, aa = 0, mh = 200, ma = 200;
-		FBaseCVar* v = FindCVar("odoom_star_always_allow_pickup_if_max", nullptr);
-		if (v && v->GetRealType() == CVAR_Int) ap = v->GetGenericRep(CVAR_Int).Int ? 1 : 0;
-		v = FindCVar("odoom_star_always_add_items_to_inventory", nullptr);
-		if (v && v->GetRealType() == CVAR_Int) aa = v->GetGenericRep(CVAR_Int).Int ? 1 : 0;
-		v = FindCVar("odoom_star_max_health", nullptr);
-		if (v && v->GetRealType() == CVAR_Int) mh = v->GetGenericRep(CVAR_Int).Int;
-		v = FindCVar("odoom_star_max_armor", nullptr);
-		if (v && v->GetRealType() == CVAR_Int) ma = v->GetGenericRep(CVAR_Int).Int;
-		if (mh <= 0) mh = 200;
-		if (ma <= 0) ma = 200;
+		const int ap = odoom_star_always_allow_pickup_if_max ? 1 : 0, aa = odoom_star_always_add_items_to_inventory ? 1 : 0;
+		const int mh = ODOOM_ConfigMaxHealth(), ma = ODOOM_ConfigMaxArmor();
 		fprintf(f, "  \"always_allow_pickup_if_max\": %d,\n", ap);
 		fprintf(f, "  \"always_add_items_to_inventory\": %d,\n", aa);
 		fprintf(f, "  \"max_health\": %d,\n", mh);
@@ -1052,16 +1554,9 @@ static int ODOOM_GetRawKeyDown(int vk_or_ascii)
 #endif
 }
 
-/** Max bytes to pass to the inventory list CVar. Engine string CVars can have a small fixed buffer; exceeding it causes "attempted to write past end of stream". Use 1K to stay under typical limits. */
-static const size_t ODOOM_INVENTORY_CVAR_MAX_BYTES = 1024;
-/** Max UTF-8 bytes safe to assign to any ZScript-facing CVAR_String (matches ODOOM_INVENTORY_CVAR_MAX_BYTES-1; longer values hang / error in UZDoom). */
-static const size_t ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8 =
-	(ODOOM_INVENTORY_CVAR_MAX_BYTES > 1) ? (ODOOM_INVENTORY_CVAR_MAX_BYTES - 1) : 1u;
-/** Quest list window: pack compact Q-only lines under SetGenericRep cap (full O/P blocks are too large for ~6 rows). */
-static const size_t ODOOM_QUEST_LIST_CVAR_WINDOW_BUDGET = ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8;
-/** Hard max UTF-8 bytes per compact Q line (~6 lines must fit in ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8). */
-static const size_t ODOOM_QUEST_COMPACT_Q_LINE_MAX_UTF8 = 168;
-/** Max bytes from ogengine_get_top_level_quests_string (full serialized cache before windowing). Large so many quests fit; list CVar is windowed separately. */
+/** Max UTF-8 bytes safe to assign to any ZScript-facing CVAR_String. Engine string CVars can have a small fixed buffer; exceeding it causes "attempted to write past end of stream" or hangs in UZDoom. */
+static const size_t ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8 = 1023;
+/** Max bytes from ogengine_get_top_level_quests_string (full serialized cache before windowing). Large so many quests fit; OdoomStarData only exposes the scroll window. */
 static const size_t ODOOM_QUEST_LIST_MAX_BYTES = 256 * 1024;
 /** Max UTF-8 bytes for odoom_quest_tracker_objectives (must stay within ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8). */
 static const size_t ODOOM_QUEST_TRACKER_OBJECTIVES_CVAR_MAX = ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8;
@@ -1123,11 +1618,84 @@ static bool ODOOM_ItemNameIsCanonicalPhase1Powerup(const char* name) {
 }
 } // namespace
 
-/** Max items in one window so we stay under the byte limit; ZScript scrolls by requesting different scroll_offset. */
+/** Max items in one inventory window; ZScript scrolls by requesting different scroll_offset. */
 static const size_t ODOOM_INVENTORY_WINDOW_ITEMS = 24;
 
 /** Tab indices matching ZScript TAB_KEYS etc. Used to filter items per tab. Items=5, Monsters=6 (last). */
 static const int ODOOM_TAB_KEYS = 0, ODOOM_TAB_POWERUPS = 1, ODOOM_TAB_WEAPONS = 2, ODOOM_TAB_AMMO = 3, ODOOM_TAB_ARMOR = 4, ODOOM_TAB_ITEMS = 5, ODOOM_TAB_MONSTERS = 6;
+static const int ODOOM_TAB_COUNT = ODOOM_TAB_MONSTERS + 1;
+
+/** Rows the ZScript overlay reads through the OdoomStarData natives. Inventory rows hold every item of the last list,
+ * filled on the main thread by ODOOM_PushInventoryToCVars and reused across refreshes so steady-state updates do not
+ * allocate; each tab keeps the indices of its rows, so the published window is a slice of one tab's index vector.
+ * Quest rows are a view into the cached quest model (ODOOM_RefreshQuestCVars). */
+struct ODOOM_StarInventoryRow {
+	std::string name, desc, type, game;
+	int quantity = 1;
+};
+struct ODOOM_StarQuestRow {
+	std::string id, name, desc, status;
+	int percent = 0;
+};
+static std::vector<ODOOM_StarInventoryRow> g_odoom_star_inventory_rows;
+static size_t g_odoom_star_inventory_item_count = 0;  /* rows in use: the whole list, every tab */
+static std::vector<uint32_t> g_odoom_star_inventory_tab_rows[ODOOM_TAB_COUNT];
+/* Published window: g_odoom_star_inventory_row_count rows of the tab from window_offset. */
+static int g_odoom_star_inventory_window_tab = ODOOM_TAB_KEYS;
+static size_t g_odoom_star_inventory_window_offset = 0;
+static size_t g_odoom_star_inventory_row_count = 0;
+static int ODOOM_StarQuestRowCount(void);
+static const ODOOM_StarQuestRow* ODOOM_StarQuestRowAt(int i);
+
+template <class Row>
+static Row& ODOOM_NextStarRow(std::vector<Row>& rows, size_t& count) {
+	if (count == rows.size()) rows.emplace_back();
+	return rows[count++];
+}
+
+/* ZScript: struct OdoomStarData (odoom_inventory_popup.zs). Index i is relative to the current window; out of range reads return ""/0. */
+static const ODOOM_StarInventoryRow* ODOOM_StarInventoryRowAt(int i) {
+	if (i < 0 || (size_t)i >= g_odoom_star_inventory_row_count) return nullptr;
+	const uint32_t row = g_odoom_star_inventory_tab_rows[g_odoom_star_inventory_window_tab][g_odoom_star_inventory_window_offset + (size_t)i];
+	return &g_odoom_star_inventory_rows[row];
+}
+#define ODOOM_STAR_DATA_STRING_GETTER(func, rowAt, field) \
+	DEFINE_ACTION_FUNCTION(_OdoomStarData, func) { \
+		PARAM_PROLOGUE; \
+		PARAM_INT(i); \
+		auto* row = rowAt(i); \
+		ACTION_RETURN_STRING(row ? row->field.c_str() : ""); \
+	}
+#define ODOOM_STAR_DATA_INT_GETTER(func, rowAt, field) \
+	DEFINE_ACTION_FUNCTION(_OdoomStarData, func) { \
+		PARAM_PROLOGUE; \
+		PARAM_INT(i); \
+		auto* row = rowAt(i); \
+		ACTION_RETURN_INT(row ? row->field : 0); \
+	}
+
+DEFINE_ACTION_FUNCTION(_OdoomStarData, InventoryRowCount) {
+	PARAM_PROLOGUE;
+	ACTION_RETURN_INT((int)g_odoom_star_inventory_row_count);
+}
+ODOOM_STAR_DATA_STRING_GETTER(InventoryName, ODOOM_StarInventoryRowAt, name)
+ODOOM_STAR_DATA_STRING_GETTER(InventoryDesc, ODOOM_StarInventoryRowAt, desc)
+ODOOM_STAR_DATA_STRING_GETTER(InventoryType, ODOOM_StarInventoryRowAt, type)
+ODOOM_STAR_DATA_STRING_GETTER(InventoryGame, ODOOM_StarInventoryRowAt, game)
+ODOOM_STAR_DATA_INT_GETTER(InventoryQuantity, ODOOM_StarInventoryRowAt, quantity)
+
+DEFINE_ACTION_FUNCTION(_OdoomStarData, QuestRowCount) {
+	PARAM_PROLOGUE;
+	ACTION_RETURN_INT(ODOOM_StarQuestRowCount());
+}
+ODOOM_STAR_DATA_STRING_GETTER(QuestId, ODOOM_StarQuestRowAt, id)
+ODOOM_STAR_DATA_STRING_GETTER(QuestName, ODOOM_StarQuestRowAt, name)
+ODOOM_STAR_DATA_STRING_GETTER(QuestDesc, ODOOM_StarQuestRowAt, desc)
+ODOOM_STAR_DATA_STRING_GETTER(QuestStatus, ODOOM_StarQuestRowAt, status)
+ODOOM_STAR_DATA_INT_GETTER(QuestPercent, ODOOM_StarQuestRowAt, percent)
+
+#undef ODOOM_STAR_DATA_INT_GETTER
+#undef ODOOM_STAR_DATA_STRING_GETTER
 
 /** Return true if item matches the given tab (same logic as ZScript IsStarItemInTab). */
 static bool ODOOM_ItemMatchesTab(const char* item_type, const char* name, int tab) {
@@ -1164,149 +1732,141 @@ static int GetHealthOrArmorAmount(const char* className);
 /** Hardcoded Doom ammo amount for (+X) description. Returns 0 to use default 1. Implemented later in file. */
 static int GetHardcodedAmmoAmount(const char* className);
 
-/** Push inventory list to CVars for ZScript overlay. list may be null (clears overlay). Caller keeps ownership.
- * Filters by current tab (odoom_star_inventory_tab), then sends total filtered count and a window [scroll_offset, scroll_offset+N)
- * so all items in that tab are reachable by scrolling. ZScript sets scroll_offset and tab each frame. */
-static void ODOOM_PushInventoryToCVars(const ogengine_item_list_t* list) {
-	static char listBuf[ODOOM_INVENTORY_CVAR_MAX_BYTES];
-	FBaseCVar* countVar = FindCVar("odoom_star_inventory_count", nullptr);
-	FBaseCVar* listVar = FindCVar("odoom_star_inventory_list", nullptr);
-	FBaseCVar* scrollVar = FindCVar("odoom_star_inventory_scroll_offset", nullptr);
-	FBaseCVar* tabVar = FindCVar("odoom_star_inventory_tab", nullptr);
-	if (!countVar || !listVar) return;
-
-	if (!list || !list->items || list->count == 0) {
-		UCVarValue u; u.Int = 0;
-		countVar->SetGenericRep(u, CVAR_Int);
-		UCVarValue v; v.String = (char*)("");
-		listVar->SetGenericRep(v, CVAR_String);
-		return;
-	}
-
-	int scrollOffset = 0;
-	int tab = ODOOM_TAB_KEYS;
-	if (scrollVar && scrollVar->GetRealType() == CVAR_Int)
-		scrollOffset = scrollVar->GetGenericRep(CVAR_Int).Int;
-	if (tabVar && tabVar->GetRealType() == CVAR_Int)
-		tab = tabVar->GetGenericRep(CVAR_Int).Int;
+/** Publish the current tab's window to the ZScript overlay: the tab's total in odoom_star_inventory_count and rows
+ * [scroll_offset, scroll_offset+N) through OdoomStarData. ZScript sets scroll_offset and tab each frame; this only slices
+ * the tab's index vector, so it runs every frame the popup is open and scrolling or switching tab shows at once. */
+static void ODOOM_PushInventoryWindowToCVars(void) {
+	g_odoom_star_inventory_row_count = 0;
+	if (!g_odoom_cv.odoom_star_inventory_count) return;
+	int scrollOffset = ODOOM_GetCVar(g_odoom_cv.odoom_star_inventory_scroll_offset, 0);
+	int tab = ODOOM_GetCVar(g_odoom_cv.odoom_star_inventory_tab, ODOOM_TAB_KEYS);
 	if (scrollOffset < 0) scrollOffset = 0;
-	if (tab < 0 || tab > ODOOM_TAB_MONSTERS) tab = ODOOM_TAB_KEYS;
-
-	size_t n = list->count;
-	size_t filteredCount = 0;
-	for (size_t i = 0; i < n; i++) {
-		const ogengine_item_t* it = &list->items[i];
-		if (ODOOM_ItemMatchesTab(it->item_type, it->name, tab))
-			filteredCount++;
-	}
-
-	UCVarValue u; u.Int = (int)filteredCount;
-	countVar->SetGenericRep(u, CVAR_Int);
-
-	size_t off = 0;
-	size_t maxOff = sizeof(listBuf) - 320;
-	if (maxOff > ODOOM_INVENTORY_CVAR_MAX_BYTES - 1)
-		maxOff = ODOOM_INVENTORY_CVAR_MAX_BYTES - 1;
+	if (tab < 0 || tab >= ODOOM_TAB_COUNT) tab = ODOOM_TAB_KEYS;
+
+	const size_t total = g_odoom_star_inventory_tab_rows[tab].size();
+	const size_t offset = std::min((size_t)scrollOffset, total);
+	g_odoom_star_inventory_window_tab = tab;
+	g_odoom_star_inventory_window_offset = offset;
+	g_odoom_star_inventory_row_count = std::min(total - offset, ODOOM_INVENTORY_WINDOW_ITEMS);
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_inventory_count, (int)total);
+}
 
-	auto copySafe = [](char* dst, const char* src, int maxLen) {
-		int j = 0;
-		while (src[j] && j < maxLen - 1) {
-			char c = src[j];
-			if (c == '\t' || c == '\n' || c == '\r') c = ' ';
-			dst[j++] = c;
-		}
-		dst[j] = '\0';
-	};
+/** Publish inventory to the ZScript overlay. list may be null (clears overlay). Caller keeps ownership.
+ * Copies every item into the row model and classifies it into the per-tab index vectors once per list, then publishes
+ * the current window (ODOOM_PushInventoryWindowToCVars). */
+static void ODOOM_PushInventoryToCVars(const ogengine_item_list_t* list) {
+	g_odoom_star_inventory_row_count = 0;
+	g_odoom_star_inventory_item_count = 0;
+	for (std::vector<uint32_t>& rows : g_odoom_star_inventory_tab_rows)
+		rows.clear();
 
-	size_t filteredIndex = 0;
-	for (size_t i = 0; i < n && off < maxOff; i++) {
+	const size_t n = (list && list->items) ? list->count : 0;
+	for (size_t i = 0; i < n; i++) {
 		const ogengine_item_t* it = &list->items[i];
-		if (!ODOOM_ItemMatchesTab(it->item_type, it->name, tab)) continue;
-		if (filteredIndex < (size_t)scrollOffset) {
-			filteredIndex++;
-			continue;
-		}
-		if ((filteredIndex - (size_t)scrollOffset) >= ODOOM_INVENTORY_WINDOW_ITEMS) break;
-
-		char name[320], desc[256], type[64], game[64];
-		bool isNft = (it->nft_id[0] != '\0');
-		if (isNft) {
-			snprintf(name, sizeof(name), "[NFT] %s", it->name);
-			copySafe(name, name, 320);
+		const uint32_t index = (uint32_t)g_odoom_star_inventory_item_count;
+		ODOOM_StarInventoryRow& row = ODOOM_NextStarRow(g_odoom_star_inventory_rows, g_odoom_star_inventory_item_count);
+		if (it->nft_id[0] != '\0') {
+			row.name.assign("[NFT] ");
+			row.name += it->name;
 		} else {
-			copySafe(name, it->name, 256);
+			row.name.assign(it->name);
 		}
-		copySafe(desc, it->description, 256);
+		row.desc.assign(it->description);
 		/* OQUAKE-style: ensure health/armor/ammo show (+X) in description when missing */
 		if (it->item_type[0] && (!it->description[0] || !strstr(it->description, "(+"))) {
 			int amt = GetHealthOrArmorAmount(it->name);
 			if (amt <= 0 && (strstr(it->item_type, "Ammo") || strstr(it->item_type, "ammo")))
 				amt = GetHardcodedAmmoAmount(it->name);
 			if (amt > 0) {
-				const char* label = it->name[0] ? it->name : "Item";
-				/* Cap name length so "%s (+%d)" fits in desc[256] (name at most 240 + " (+%d)" ~12) */
-				(void)snprintf(desc, sizeof(desc), "%.240s (+%d)", label, amt);
-				copySafe(desc, desc, 256);
+				row.desc.assign(it->name[0] ? it->name : "Item");
+				row.desc += " (+";
+				row.desc += std::to_string(amt);
+				row.desc += ")";
 			}
 		}
-		copySafe(type, it->item_type, 64);
-		copySafe(game, it->game_source, 64);
-		int qty = (it->quantity > 0) ? it->quantity : 1;
-		int wr = snprintf(listBuf + off, (size_t)(sizeof(listBuf) - off), "%s\t%s\t%s\t%s\t%d\n", name, desc, type, game, qty);
-		if (wr > 0 && (size_t)wr < sizeof(listBuf) - off)
-			off += (size_t)wr;
-		else
-			break;
-		filteredIndex++;
+		row.type.assign(it->item_type);
+		row.game.assign(it->game_source);
+		row.quantity = (it->quantity > 0) ? it->quantity : 1;
+		for (int tab = 0; tab < ODOOM_TAB_COUNT; tab++)
+			if (ODOOM_ItemMatchesTab(it->item_type, it->name, tab))
+				g_odoom_star_inventory_tab_rows[tab].push_back(index);
+	}
+
+	ODOOM_PushInventoryWindowToCVars();
+}
+
+/** Cross-game keys held in STAR inventory: Doom red/blue/yellow/skull plus OQuake (and Wolf3D) gold/silver.
+ *  Rebuilt from each fetched inventory list, so door checks and the key HUD are bit tests. The matched item name
+ *  is kept per key because use_item consumes by exact API name. */
+enum {
+	ODOOM_STAR_KEY_RED,
+	ODOOM_STAR_KEY_BLUE,
+	ODOOM_STAR_KEY_YELLOW,
+	ODOOM_STAR_KEY_SKULL,
+	ODOOM_STAR_KEY_GOLD,
+	ODOOM_STAR_KEY_SILVER,
+	ODOOM_STAR_KEY_COUNT
+};
+static unsigned g_odoom_star_keys = 0;
+static int g_odoom_star_key_quantity[ODOOM_STAR_KEY_COUNT];
+static char g_odoom_star_key_name[ODOOM_STAR_KEY_COUNT][128];
+
+/** Key bits an inventory item name stands for (any spelling: "Red Keycard", "red_keycard", "Red Key"...). */
+static unsigned ODOOM_StarKeyBitsForItemName(const char* name) {
+	static const char* const kColour[ODOOM_STAR_KEY_COUNT] = { "red", "blue", "yellow", "skull", "gold", "silver" };
+	if (!name || !name[0] || !oglib_str_contains_nocase(name, "key")) return 0;
+	unsigned bits = 0;
+	for (int k = 0; k < ODOOM_STAR_KEY_COUNT; k++)
+		if (oglib_str_contains_nocase(name, kColour[k])) bits |= 1u << k;
+	return bits;
+}
+
+/** Door lock number to key bit: Doom 1-4 and ZDoom extended locks 129-131; -1 for locks STAR does not hold. */
+static int ODOOM_StarKeyForLock(int keynum) {
+	switch (keynum) {
+		case 1: case 129: return ODOOM_STAR_KEY_RED;
+		case 2: case 130: return ODOOM_STAR_KEY_BLUE;
+		case 3: case 131: return ODOOM_STAR_KEY_YELLOW;
+		case 4: return ODOOM_STAR_KEY_SKULL;
+		default: return -1;
+	}
+}
+
+static void ODOOM_RebuildStarKeys(const ogengine_item_list_t* list) {
+	g_odoom_star_keys = 0;
+	if (!list || !list->items) return;
+	for (size_t i = 0; i < list->count; i++) {
+		const ogengine_item_t* it = &list->items[i];
+		const unsigned bits = ODOOM_StarKeyBitsForItemName(it->name) & ~g_odoom_star_keys;
+		if (!bits) continue;
+		for (int k = 0; k < ODOOM_STAR_KEY_COUNT; k++) {
+			if (!(bits & (1u << k))) continue;
+			g_odoom_star_key_quantity[k] = (it->quantity > 0) ? it->quantity : 1;
+			oglib_str_copy(g_odoom_star_key_name[k], it->name, sizeof(g_odoom_star_key_name[k]));
+		}
+		g_odoom_star_keys |= bits;
 	}
-	listBuf[off] = '\0';
-	UCVarValue v; v.String = listBuf;
-	listVar->SetGenericRep(v, CVAR_String);
 }
 
-/** Set odoom_star_has_gold_key / odoom_star_has_silver_key from inventory list so ZScript can give OQ keys for HUD. When !initialized or list==null, clear to 0. Also updates odoom_star_avatar_xp from ogengine_get_avatar_xp. */
+/** Rebuild the STAR key bits from inventory list and set odoom_star_has_gold_key / odoom_star_has_silver_key so ZScript can give OQ keys for HUD. When !initialized or list==null, clear to 0. Also updates odoom_star_avatar_xp from ogengine_get_avatar_xp. */
 static void ODOOM_UpdateStarKeyHudCVars(const ogengine_item_list_t* list) {
 	if (!g_star_initialized || !list) {
-		FBaseCVar* g = FindCVar("odoom_star_has_gold_key", nullptr);
-		FBaseCVar* s = FindCVar("odoom_star_has_silver_key", nullptr);
-		FBaseCVar* xpVar    = FindCVar("odoom_star_avatar_xp", nullptr);
-		FBaseCVar* karmaVar = FindCVar("odoom_star_avatar_karma", nullptr);
-		if (g && g->GetRealType() == CVAR_Int)       { UCVarValue u; u.Int = 0; g->SetGenericRep(u, CVAR_Int); }
-		if (s && s->GetRealType() == CVAR_Int)       { UCVarValue u; u.Int = 0; s->SetGenericRep(u, CVAR_Int); }
-		if (xpVar && xpVar->GetRealType() == CVAR_Int)       { UCVarValue u; u.Int = 0; xpVar->SetGenericRep(u, CVAR_Int); }
-		if (karmaVar && karmaVar->GetRealType() == CVAR_Int)  { UCVarValue u; u.Int = 0; karmaVar->SetGenericRep(u, CVAR_Int); }
+		g_odoom_star_keys = 0;
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_has_gold_key, 0);
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_has_silver_key, 0);
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_avatar_xp, 0);
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_avatar_karma, 0);
 		return;
 	}
-	int hasGold = 0, hasSilver = 0;
-	if (list->items) {
-		for (size_t i = 0; i < list->count; i++) {
-			const char* n = list->items[i].name;
-			if (!n) continue;
-			std::string lower;
-			for (const char* p = n; *p; ++p)
-				lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(*p == '_' ? ' ' : *p))));
-			if (lower.find("gold") != std::string::npos && (lower.find("key") != std::string::npos || lower.find("keycard") != std::string::npos))
-				hasGold = 1;
-			if (lower.find("silver") != std::string::npos && (lower.find("key") != std::string::npos || lower.find("keycard") != std::string::npos))
-				hasSilver = 1;
-		}
-	}
-	FBaseCVar* g = FindCVar("odoom_star_has_gold_key", nullptr);
-	FBaseCVar* s = FindCVar("odoom_star_has_silver_key", nullptr);
-	if (g && g->GetRealType() == CVAR_Int) { UCVarValue u; u.Int = hasGold; g->SetGenericRep(u, CVAR_Int); }
-	if (s && s->GetRealType() == CVAR_Int) { UCVarValue u; u.Int = hasSilver; s->SetGenericRep(u, CVAR_Int); }
+	ODOOM_RebuildStarKeys(list);
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_has_gold_key, (g_odoom_star_keys >> ODOOM_STAR_KEY_GOLD) & 1);
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_has_silver_key, (g_odoom_star_keys >> ODOOM_STAR_KEY_SILVER) & 1);
 	int xp = 0;
 	if (ogengine_get_avatar_xp(&xp))
-	{
-		FBaseCVar* xpVar = FindCVar("odoom_star_avatar_xp", nullptr);
-		if (xpVar && xpVar->GetRealType() == CVAR_Int) { UCVarValue u; u.Int = xp; xpVar->SetGenericRep(u, CVAR_Int); }
-	}
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_avatar_xp, xp);
 	long karma = 0;
 	if (ogengine_get_avatar_karma(&karma))
-	{
-		FBaseCVar* karmaVar = FindCVar("odoom_star_avatar_karma", nullptr);
-		if (karmaVar && karmaVar->GetRealType() == CVAR_Int) { UCVarValue u; u.Int = (int)karma; karmaVar->SetGenericRep(u, CVAR_Int); }
-	}
+		ODOOM_SetCVar(g_odoom_cv.odoom_star_avatar_karma, (int)karma);
 }
 
 /** Refresh overlay from client (get_inventory returns API + pending merged in C#). When not beamed in, push empty so no phantom inventory/keys. */
@@ -1321,6 +1881,9 @@ static void ODOOM_RefreshOverlayFromClient(void) {
 		g_odoom_inventory_refresh_pending = false;
 		ogengine_item_list_t* list = nullptr;
 		if (ogengine_get_inventory(&list) == OGENGINE_SUCCESS && list) {
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+			ogengine_sync_use_item_adjust_list(list);  /* uses the server has not answered yet */
+#endif
 			ODOOM_UpdateStarKeyHudCVars(list);
 			ODOOM_PushInventoryToCVars(list);
 			ogengine_free_item_list(list);
@@ -1333,14 +1896,11 @@ static void ODOOM_RefreshOverlayFromClient(void) {
 static void StarLogInfo(const char* fmt, ...);
 static void StarLogQuestListPayloadChunks(const char* buf, int len);
 
-/** GUID / id compare (API may return mixed case; CVars may differ). */
-static bool ODOOM_QuestIdEqInsensitive(const std::string& a, const std::string& b) {
-	if (a.size() != b.size()) return false;
-	for (size_t i = 0; i < a.size(); ++i) {
-		unsigned char ca = (unsigned char)a[i], cb = (unsigned char)b[i];
-		if (ca != cb && tolower(ca) != tolower(cb)) return false;
-	}
-	return true;
+/** Quest model key for an id: GUIDs compare case-insensitively (API may return mixed case; CVars may differ). */
+static void ODOOM_QuestIdKey(const char* id, std::string& outKey) {
+	outKey.assign(id ? id : "");
+	for (char& c : outKey)
+		c = (char)tolower((unsigned char)c);
 }
 
 static bool ODOOM_StreqI(const char* a, const char* b) {
@@ -1352,43 +1912,17 @@ static bool ODOOM_StreqI(const char* a, const char* b) {
 #endif
 }
 
-/** 4th tab-separated field after Q\t = status (id, name, desc, status, ...). */
-static bool ODOOM_ParseStatusFromQuestQLine(const char* line, size_t lineLen, std::string& outStatus) {
-	if (lineLen < 4 || line[0] != 'Q' || line[1] != '\t') return false;
-	const char* p = line + 2;
-	const char* end = line + lineLen;
-	int field = 0;
-	const char* fs = p;
-	for (const char* q = p; q <= end; ++q) {
-		if (q == end || *q == '\t') {
-			if (field == 3) {
-				outStatus.assign(fs, static_cast<size_t>(q - fs));
-				return true;
-			}
-			field++;
-			fs = q + 1;
-		}
-	}
-	return false;
-}
+/** Status bits for the quest popup filter CVars (B / N / M toggles). */
+static const int ODOOM_QUEST_FILTER_NOT_STARTED = 1, ODOOM_QUEST_FILTER_IN_PROGRESS = 2, ODOOM_QUEST_FILTER_COMPLETED = 4;
 
-static bool ODOOM_QuestStatusPassesPopupFilter(const std::string& st, int fn, int fi, int fc) {
-	if (st.empty()) return fi != 0;
+/** Filter bit for a Q-line status; rows without a status count as in progress, unknown statuses match no filter. */
+static int ODOOM_QuestStatusFilterBit(const std::string& st) {
+	if (st.empty()) return ODOOM_QUEST_FILTER_IN_PROGRESS;
 	const char* s = st.c_str();
-	const bool ns = ODOOM_StreqI(s, "NotStarted") || ODOOM_StreqI(s, "Not Started");
-	const bool ip = ODOOM_StreqI(s, "InProgress") || ODOOM_StreqI(s, "In Progress");
-	const bool done = ODOOM_StreqI(s, "Completed");
-	return (ns && fn != 0) || (ip && fi != 0) || (done && fc != 0);
-}
-
-static bool ODOOM_ParseQuestIdFromQLine(const char* line, size_t lineLen, std::string& outId) {
-	if (lineLen < 4 || line[0] != 'Q' || line[1] != '\t') return false;
-	const char* p = line + 2;
-	const char* end = line + lineLen;
-	const char* t0 = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
-	if (!t0 || t0 == p) return false;
-	outId.assign(p, static_cast<size_t>(t0 - p));
-	return true;
+	if (ODOOM_StreqI(s, "NotStarted") || ODOOM_StreqI(s, "Not Started")) return ODOOM_QUEST_FILTER_NOT_STARTED;
+	if (ODOOM_StreqI(s, "InProgress") || ODOOM_StreqI(s, "In Progress")) return ODOOM_QUEST_FILTER_IN_PROGRESS;
+	if (ODOOM_StreqI(s, "Completed")) return ODOOM_QUEST_FILTER_COMPLETED;
+	return 0;
 }
 
 /** Each range [first, second) is one top-level quest block (from its Q line through the byte before the next Q line). */
@@ -1419,60 +1953,24 @@ static void ODOOM_CollectQuestBlockRanges(const char* buf, int n, std::vector<st
 	}
 }
 
-/** One compact Q line for odoom_quest_list (main list uses Q rows only). Shrinks name/desc caps until the line fits ODOOM_QUEST_COMPACT_Q_LINE_MAX_UTF8 (keeps tab structure; avoids whole-line chop when possible). */
-static void ODOOM_FormatCompactQuestQLineForCVarShrink(const char* line, size_t lineLen, size_t maxNameUtf8, size_t maxDescUtf8, std::string& out) {
-	out.clear();
-	if (lineLen < 4 || !line || line[0] != 'Q' || line[1] != '\t') return;
+/** Fill an OdoomStarData quest row from a Q line (Q, id, name, desc, status[, pct]). Returns false when the line is malformed. */
+static bool ODOOM_ParseQuestQLineRow(const char* line, size_t lineLen, ODOOM_StarQuestRow& row) {
+	if (lineLen < 4 || !line || line[0] != 'Q' || line[1] != '\t') return false;
 	const char* end = line + lineLen;
 	const char* p = line + 2;
-	const char* t1 = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
-	if (!t1 || t1 == p) return;
-	std::string id(p, static_cast<size_t>(t1 - p));
-	p = t1 + 1;
-	const char* t2 = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
-	if (!t2) return;
-	std::string name(p, static_cast<size_t>(t2 - p));
-	p = t2 + 1;
-	const char* t3 = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
-	if (!t3) return;
-	std::string desc(p, static_cast<size_t>(t3 - p));
-	p = t3 + 1;
-	const char* t4 = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
-	if (!t4) return;
-	std::string status(p, static_cast<size_t>(t4 - p));
-	p = t4 + 1;
-	std::string pct(p, static_cast<size_t>(end - p));
-
-	size_t maxName = maxNameUtf8;
-	size_t maxDesc = maxDescUtf8;
-	for (int iter = 0; iter < 32; ++iter) {
-		std::string nameC = name;
-		std::string descC = desc;
-		ODOOM_TruncateUtf8ForZScriptCVar(nameC, maxName);
-		ODOOM_TruncateUtf8ForZScriptCVar(descC, maxDesc);
-		out.clear();
-		out.push_back('Q');
-		out.push_back('\t');
-		out += id;
-		out.push_back('\t');
-		out += nameC;
-		out.push_back('\t');
-		out += descC;
-		out.push_back('\t');
-		out += status;
-		out.push_back('\t');
-		out += pct;
-		out.push_back('\n');
-		if (out.size() <= ODOOM_QUEST_COMPACT_Q_LINE_MAX_UTF8)
-			return;
-		if (maxDesc > 16)
-			maxDesc -= 8;
-		else if (maxName > 12)
-			maxName -= 6;
-		else
-			break;
-	}
-	ODOOM_TruncateUtf8ForZScriptCVar(out, ODOOM_QUEST_COMPACT_Q_LINE_MAX_UTF8);
+	std::string* fields[4] = { &row.id, &row.name, &row.desc, &row.status };
+	for (std::string* field : fields) {
+		const char* tab = (const char*)memchr(p, '\t', static_cast<size_t>(end - p));
+		if (!tab && field != &row.status) return false;
+		const char* fieldEnd = tab ? tab : end;
+		field->assign(p, static_cast<size_t>(fieldEnd - p));
+		p = tab ? tab + 1 : end;
+	}
+	if (row.id.empty()) return false;
+	row.percent = 0;
+	for (; p < end && std::isdigit(static_cast<unsigned char>(*p)); ++p)
+		row.percent = row.percent * 10 + (*p - '0');
+	return true;
 }
 
 /** Q line: Q, id, name, desc, status, pct — append " (pct%)" to tracker title from last tab field when present (matches list progress). */
@@ -1545,8 +2043,6 @@ static void ODOOM_ParseOlineTrackerProgress(const char* line, size_t lineLen, st
 /** Update tracker progress lines + active index from STAR cache (no full quest list parse). Call every frame while tracker is visible so Need and Progress dictionary merges show immediately after kills/pickups. */
 static void ODOOM_PushTrackerProgressCvars(const char* wantIdCStr) {
 	if (!wantIdCStr || !wantIdCStr[0] || std::strcmp(wantIdCStr, "...") == 0) return;
-	FBaseCVar* trackerObjLinesVar = FindCVar("odoom_quest_tracker_objectives", nullptr);
-	FBaseCVar* trackerActiveVar = FindCVar("odoom_quest_tracker_active_index", nullptr);
 	static char trackerObjBuf[4096];
 	int nObj = ogengine_get_quest_tracker_objectives_string(wantIdCStr, trackerObjBuf, sizeof(trackerObjBuf));
 	if (nObj < 0) nObj = 0;
@@ -1555,148 +2051,150 @@ static void ODOOM_PushTrackerProgressCvars(const char* wantIdCStr) {
 	static std::string s_tracker_objectives;
 	s_tracker_objectives.assign(trackerObjBuf, (size_t)nObj);
 	ODOOM_TruncateUtf8ForZScriptCVar(s_tracker_objectives, ODOOM_QUEST_TRACKER_OBJECTIVES_CVAR_MAX);
-	if (trackerObjLinesVar && trackerObjLinesVar->GetRealType() == CVAR_String) {
-		UCVarValue vo; vo.String = (char*)s_tracker_objectives.c_str();
-		trackerObjLinesVar->SetGenericRep(vo, CVAR_String);
-	}
-	if (trackerActiveVar && trackerActiveVar->GetRealType() == CVAR_Int) {
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_objectives, s_tracker_objectives.c_str());
+	if (g_odoom_cv.odoom_quest_tracker_active_index) {
 		int activeIdx = ogengine_get_quest_tracker_active_objective_index(wantIdCStr);
-		if (activeIdx >= 0) {
-			UCVarValue va; va.Int = activeIdx;
-			trackerActiveVar->SetGenericRep(va, CVAR_Int);
+		if (activeIdx >= 0)
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_active_index, activeIdx);
+	}
+}
+
+/** One top-level quest from the serialized list, with everything the popup and tracker read from it pre-parsed. */
+struct ODOOM_QuestEntry {
+	ODOOM_StarQuestRow row;
+	int statusBit = 0;            /* ODOOM_QUEST_FILTER_* */
+	std::string trackerTitle;     /* name + " (pct%)", truncated for the HUD */
+	std::string trackerObjective; /* first incomplete objective (ODOOM_ParseOlineTrackerProgress) */
+};
+
+/** Parsed top-level quest list keyed by id, rebuilt only when ogengine_get_top_level_quests_string returns different bytes.
+ * filtered[mask] lists quest indices (ascending) passing each combination of the three status filters, so a refresh only
+ * touches the visible window. */
+struct ODOOM_QuestModel {
+	std::string payload;
+	std::vector<ODOOM_QuestEntry> quests;
+	std::map<std::string, size_t> byId;
+	std::vector<size_t> filtered[8];
+};
+static ODOOM_QuestModel g_odoom_quest_model;
+/** OdoomStarData quest window: g_odoom_quest_model.filtered[mask] from the scroll offset. */
+static const std::vector<size_t>* g_odoom_quest_window = nullptr;
+static size_t g_odoom_quest_window_start = 0;
+
+static int ODOOM_StarQuestRowCount(void) {
+	if (!g_odoom_quest_window || g_odoom_quest_window_start >= g_odoom_quest_window->size()) return 0;
+	return (int)(g_odoom_quest_window->size() - g_odoom_quest_window_start);
+}
+
+static const ODOOM_StarQuestRow* ODOOM_StarQuestRowAt(int i) {
+	if (i < 0 || i >= ODOOM_StarQuestRowCount()) return nullptr;
+	return &g_odoom_quest_model.quests[(*g_odoom_quest_window)[g_odoom_quest_window_start + (size_t)i]].row;
+}
+
+/** Look up a quest by id (case-insensitive). Returns the index into g_odoom_quest_model.quests, or -1. */
+static int ODOOM_FindQuestInModel(const char* id) {
+	static std::string s_key;
+	ODOOM_QuestIdKey(id, s_key);
+	auto it = g_odoom_quest_model.byId.find(s_key);
+	return it != g_odoom_quest_model.byId.end() ? (int)it->second : -1;
+}
+
+static void ODOOM_RebuildQuestModel(const char* buf, int n) {
+	ODOOM_QuestModel& m = g_odoom_quest_model;
+	m.payload.assign(buf, (size_t)n);
+	m.quests.clear();
+	m.byId.clear();
+	for (std::vector<size_t>& f : m.filtered) f.clear();
+
+	std::vector<std::pair<size_t, size_t>> ranges;
+	ODOOM_CollectQuestBlockRanges(buf, n, ranges);
+	m.quests.reserve(ranges.size());
+	std::string key;
+	for (const auto& rg : ranges) {
+		const char* block = buf + rg.first;
+		const char* blockEnd = buf + rg.second;
+		const char* nl = (const char*)memchr(block, '\n', rg.second - rg.first);
+		size_t qll = nl ? static_cast<size_t>(nl - block) : (rg.second - rg.first);
+		m.quests.emplace_back();
+		ODOOM_QuestEntry& q = m.quests.back();
+		if (!ODOOM_ParseQuestQLineRow(block, qll, q.row)) {
+			m.quests.pop_back();
+			continue;
+		}
+		q.statusBit = ODOOM_QuestStatusFilterBit(q.row.status);
+		q.trackerTitle = q.row.name;
+		ODOOM_AppendQuestPctFromQLine(block, qll, q.trackerTitle);
+		ODOOM_TruncateUtf8ForZScriptCVar(q.trackerTitle, ODOOM_QUEST_TRACKER_TITLE_MAX_UTF8);
+		for (const char* p = nl ? nl + 1 : blockEnd; p < blockEnd && q.trackerObjective.empty();) {
+			const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(blockEnd - p));
+			size_t lineLen = lineEnd ? (size_t)(lineEnd - p) : (size_t)(blockEnd - p);
+			if (lineLen >= 3 && p[0] == '-' && p[1] == '-' && p[2] == '-') break;
+			ODOOM_ParseOlineTrackerProgress(p, lineLen, q.trackerObjective);
+			p = lineEnd ? lineEnd + 1 : blockEnd;
+		}
+		const size_t qi = m.quests.size() - 1;
+		ODOOM_QuestIdKey(q.row.id.c_str(), key);
+		m.byId.emplace(key, qi);
+		for (int mask = 1; mask < 8; ++mask) {
+			if (q.statusBit & mask)
+				m.filtered[mask].push_back(qi);
 		}
 	}
 }
 
-/** Fetch quests from API and push to CVars. Sets odoom_quest_list, odoom_quest_count. Uses top-level quests only (like Quake) so main list shows parents; sub-quests appear in detail panel. Tracker shows quest only when odoom_quest_tracker_quest_id is set. */
+/** Fetch quests from API and publish them to the overlay: odoom_quest_count plus the OdoomStarData quest window. Uses top-level quests only (like Quake) so main list shows parents; sub-quests appear in detail panel. Tracker shows quest only when odoom_quest_tracker_quest_id is set.
+ * The client exposes no version for the top-level list, so the fetched bytes are compared with the cached payload; the model is re-parsed only when they differ. */
 static void ODOOM_RefreshQuestCVars(void) {
-	FBaseCVar* listVar = FindCVar("odoom_quest_list", nullptr);
-	FBaseCVar* countVar = FindCVar("odoom_quest_count", nullptr);
-	FBaseCVar* trackerTitleVar = FindCVar("odoom_quest_tracker_title", nullptr);
-	FBaseCVar* trackerObjVar = FindCVar("odoom_quest_tracker_objective", nullptr);
-	FBaseCVar* trackerIdVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-	if (!listVar || !countVar) return;
+	g_odoom_quest_window = nullptr;
+	if (!g_odoom_cv.odoom_quest_count) return;
 
 	static char questBuf[ODOOM_QUEST_LIST_MAX_BYTES];
 	int n = ogengine_get_top_level_quests_string(questBuf, sizeof(questBuf));
 	if (n < 0 || !g_star_initialized) {
-		UCVarValue v; v.String = (char*)"";
-		listVar->SetGenericRep(v, CVAR_String);
-		UCVarValue c; c.Int = 0;
-		countVar->SetGenericRep(c, CVAR_Int);
-		if (trackerTitleVar && trackerTitleVar->GetRealType() == CVAR_String) { UCVarValue t; t.String = (char*)""; trackerTitleVar->SetGenericRep(t, CVAR_String); }
-		if (trackerObjVar && trackerObjVar->GetRealType() == CVAR_String) { UCVarValue o; o.String = (char*)""; trackerObjVar->SetGenericRep(o, CVAR_String); }
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_count, 0);
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "");
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_objective, "");
 		return;
 	}
 	if (n >= (int)sizeof(questBuf))
 		n = (int)sizeof(questBuf) - 1;
 	questBuf[n] = '\0';
 
-	std::vector<std::pair<size_t, size_t>> questRanges;
-	ODOOM_CollectQuestBlockRanges(questBuf, n, questRanges);
-	const int totalTopLevelBlocks = (int)questRanges.size();
+	ODOOM_QuestModel& model = g_odoom_quest_model;
+	if (model.payload.size() != (size_t)n || memcmp(model.payload.data(), questBuf, (size_t)n) != 0)
+		ODOOM_RebuildQuestModel(questBuf, n);
+	const int totalTopLevelBlocks = (int)model.quests.size();
 
-	int fn = 1, fi = 1, fc = 1;
-	{
-		FBaseCVar* fnV = FindCVar("odoom_quest_filter_not_started", nullptr);
-		FBaseCVar* fiV = FindCVar("odoom_quest_filter_in_progress", nullptr);
-		FBaseCVar* fcV = FindCVar("odoom_quest_filter_completed", nullptr);
-		if (fnV && fnV->GetRealType() == CVAR_Int) fn = fnV->GetGenericRep(CVAR_Int).Int != 0 ? 1 : 0;
-		if (fiV && fiV->GetRealType() == CVAR_Int) fi = fiV->GetGenericRep(CVAR_Int).Int != 0 ? 1 : 0;
-		if (fcV && fcV->GetRealType() == CVAR_Int) fc = fcV->GetGenericRep(CVAR_Int).Int != 0 ? 1 : 0;
-	}
-
-	std::vector<size_t> filteredIdx;
-	filteredIdx.reserve(questRanges.size());
-	for (size_t ri = 0; ri < questRanges.size(); ++ri) {
-		const auto& rg = questRanges[ri];
-		const char* firstLine = questBuf + rg.first;
-		const char* nl = (const char*)memchr(firstLine, '\n', rg.second - rg.first);
-		size_t ll = nl ? static_cast<size_t>(nl - firstLine) : (rg.second - rg.first);
-		std::string st;
-		if (!ODOOM_ParseStatusFromQuestQLine(firstLine, ll, st)) continue;
-		if (ODOOM_QuestStatusPassesPopupFilter(st, fn, fi, fc))
-			filteredIdx.push_back(ri);
-	}
+	const int filterMask =
+		(ODOOM_GetCVar(g_odoom_cv.odoom_quest_filter_not_started, 1) != 0 ? ODOOM_QUEST_FILTER_NOT_STARTED : 0)
+		| (ODOOM_GetCVar(g_odoom_cv.odoom_quest_filter_in_progress, 1) != 0 ? ODOOM_QUEST_FILTER_IN_PROGRESS : 0)
+		| (ODOOM_GetCVar(g_odoom_cv.odoom_quest_filter_completed, 1) != 0 ? ODOOM_QUEST_FILTER_COMPLETED : 0);
+	const std::vector<size_t>& filteredIdx = model.filtered[filterMask];
 	const int totalFiltered = (int)filteredIdx.size();
 
-	FBaseCVar* scrollVar = FindCVar("odoom_quest_scroll_offset", nullptr);
-	FBaseCVar* scrollToIdVar = FindCVar("odoom_quest_scroll_to_id", nullptr);
-	FBaseCVar* pendSelVar = FindCVar("odoom_quest_pending_select_filtered_index", nullptr);
-	if (scrollToIdVar && scrollToIdVar->GetRealType() == CVAR_String) {
-		const char* gid = scrollToIdVar->GetGenericRep(CVAR_String).String;
-		if (gid && gid[0]) {
-			std::string wantG(gid);
-			for (int fiq = 0; fiq < totalFiltered; ++fiq) {
-				size_t ri = filteredIdx[static_cast<size_t>(fiq)];
-				const auto& rg = questRanges[ri];
-				const char* fl = questBuf + rg.first;
-				const char* nl2 = (const char*)memchr(fl, '\n', rg.second - rg.first);
-				size_t ll2 = nl2 ? static_cast<size_t>(nl2 - fl) : (rg.second - rg.first);
-				std::string qid;
-				if (ODOOM_ParseQuestIdFromQLine(fl, ll2, qid) && ODOOM_QuestIdEqInsensitive(qid, wantG)) {
-					if (scrollVar && scrollVar->GetRealType() == CVAR_Int) {
-						UCVarValue sv;
-						sv.Int = fiq;
-						scrollVar->SetGenericRep(sv, CVAR_Int);
-					}
-					if (pendSelVar && pendSelVar->GetRealType() == CVAR_Int) {
-						UCVarValue pv;
-						pv.Int = fiq;
-						pendSelVar->SetGenericRep(pv, CVAR_Int);
-					}
-					break;
+	{
+		const char* gid = ODOOM_GetCVar(g_odoom_cv.odoom_quest_scroll_to_id);
+		if (gid[0]) {
+			int qi = ODOOM_FindQuestInModel(gid);
+			if (qi >= 0) {
+				auto pos = std::lower_bound(filteredIdx.begin(), filteredIdx.end(), (size_t)qi);
+				if (pos != filteredIdx.end() && *pos == (size_t)qi) {
+					int fiq = (int)(pos - filteredIdx.begin());
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_scroll_offset, fiq);
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_pending_select_filtered_index, fiq);
 				}
 			}
-			UCVarValue es;
-			es.String = (char*)"";
-			scrollToIdVar->SetGenericRep(es, CVAR_String);
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_scroll_to_id, "");
 		}
 	}
 
-	int scrollIdx = 0;
-	if (scrollVar && scrollVar->GetRealType() == CVAR_Int)
-		scrollIdx = scrollVar->GetGenericRep(CVAR_Int).Int;
+	int scrollIdx = ODOOM_GetCVar(g_odoom_cv.odoom_quest_scroll_offset, 0);
 	if (scrollIdx < 0) scrollIdx = 0;
 	if (totalFiltered > 0 && scrollIdx >= totalFiltered) scrollIdx = totalFiltered - 1;
 
-	static std::string s_questListValue;
-	const size_t cvarBudget = ODOOM_QUEST_LIST_CVAR_WINDOW_BUDGET;
-	const int remainingFiltered = std::max(0, totalFiltered - scrollIdx);
-	const int needMinWindow = std::min(6, remainingFiltered);
-	size_t nameCap = 80;
-	size_t descCap = 96;
-	int windowQuestCount = 0;
-	for (int shrinkRound = 0; shrinkRound < 16; ++shrinkRound) {
-		s_questListValue.clear();
-		windowQuestCount = 0;
-		for (int i = scrollIdx; i < totalFiltered; ++i) {
-			size_t ri = filteredIdx[static_cast<size_t>(i)];
-			const auto& rg = questRanges[ri];
-			if (rg.second <= rg.first) continue;
-			const char* block = questBuf + rg.first;
-			size_t blockLen = rg.second - rg.first;
-			const char* nl = (const char*)memchr(block, '\n', blockLen);
-			size_t qll = nl ? static_cast<size_t>(nl - block) : blockLen;
-			if (qll < 4) continue;
-			std::string one;
-			ODOOM_FormatCompactQuestQLineForCVarShrink(block, qll, nameCap, descCap, one);
-			if (one.empty()) continue;
-			if (s_questListValue.size() + one.size() > cvarBudget)
-				break;
-			s_questListValue += one;
-			windowQuestCount++;
-		}
-		if (needMinWindow <= 0 || windowQuestCount >= needMinWindow)
-			break;
-		if (descCap > 20)
-			descCap -= 12;
-		else if (nameCap > 16)
-			nameCap -= 8;
-		else
-			break;
-	}
-	const size_t assignLen = s_questListValue.size();
+	g_odoom_quest_window = &filteredIdx;
+	g_odoom_quest_window_start = (size_t)scrollIdx;
+	const int windowQuestCount = ODOOM_StarQuestRowCount();
 
 	/* Debug: log bytes received and quest counts (throttle to avoid spam) */
 	{
@@ -1708,8 +2206,8 @@ static void ODOOM_RefreshQuestCVars(void) {
 			s_last_total_f = totalFiltered;
 			s_last_win = windowQuestCount;
 			if (g_star_debug_logging) {
-				StarLogInfo("[Quests] ODOOM: bytes_from_api=%d list_cvar_bytes=%zu top_level=%d filtered_total=%d window_q=%d scroll=%d (STAR debug: full payload in chunk lines)",
-					n, assignLen, totalTopLevelBlocks, totalFiltered, windowQuestCount, scrollIdx);
+				StarLogInfo("[Quests] ODOOM: bytes_from_api=%d top_level=%d filtered_total=%d window_q=%d scroll=%d (STAR debug: full payload in chunk lines)",
+					n, totalTopLevelBlocks, totalFiltered, windowQuestCount, scrollIdx);
 				StarLogQuestListPayloadChunks(questBuf, n);
 			} else {
 				std::string preview;
@@ -1721,175 +2219,60 @@ static void ODOOM_RefreshQuestCVars(void) {
 					else if (ch >= 32 && ch < 127) preview += ch;
 					else preview += ".";
 				}
-				StarLogInfo("[Quests] ODOOM: bytes_from_api=%d list_cvar_bytes=%zu top_level=%d filtered_total=%d window_q=%d scroll=%d preview=%.220s",
-					n, assignLen, totalTopLevelBlocks, totalFiltered, windowQuestCount, scrollIdx, preview.c_str());
+				StarLogInfo("[Quests] ODOOM: bytes_from_api=%d top_level=%d filtered_total=%d window_q=%d scroll=%d preview=%.220s",
+					n, totalTopLevelBlocks, totalFiltered, windowQuestCount, scrollIdx, preview.c_str());
 			}
 		}
 	}
 
-	ODOOM_TruncateUtf8ForZScriptCVar(s_questListValue, ODOOM_ZSCRIPT_CVAR_STRING_MAX_UTF8);
-
-	UCVarValue v;
-	v.String = s_questListValue.empty() ? (char*)"" : (char*)s_questListValue.c_str();
-	listVar->SetGenericRep(v, CVAR_String);
-
-	std::string wantId;
-	if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-		const char* sid = trackerIdVar->GetGenericRep(CVAR_String).String;
-		if (sid && sid[0]) wantId.assign(sid);
-	}
+	std::string wantId(ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_quest_id));
 
-	std::string trackerTitle, trackerObjective;
-	std::string currentId, currentTitle;
-	bool inTargetBlock = false;
-	const char* p = questBuf;
-	const char* endBuf = questBuf + n;
-	while (p < endBuf && *p) {
-		const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(endBuf - p));
-		size_t lineLen = lineEnd ? (size_t)(lineEnd - p) : (size_t)(endBuf - p);
-		if (lineLen >= 3 && p[0] == '-' && p[1] == '-' && p[2] == '-') {
-			inTargetBlock = false;
-			p += 3;
-			if (p < endBuf && *p == '\n') p++;
-			continue;
-		}
-		if (lineLen >= 2 && p[0] == 'Q' && p[1] == '\t') {
-			currentId.clear();
-			currentTitle.clear();
-			/* Q, id, name, desc, status, pct */
-			const char* f = p + 2;
-			const char* lineEndQ = p + lineLen;
-			const char* t0 = (const char*)memchr(f, '\t', (size_t)(lineEndQ - f));
-			const char* t1 = nullptr;
-			if (t0 && t0 - f > 0) currentId.assign(f, (size_t)(t0 - f));
-			if (t0 && t0 + 1 < lineEndQ) {
-				t1 = (const char*)memchr(t0 + 1, '\t', (size_t)(lineEndQ - (t0 + 1)));
-				if (t1 && t1 - (t0 + 1) > 0) currentTitle.assign(t0 + 1, (size_t)(t1 - (t0 + 1)));
-			}
-			inTargetBlock = !wantId.empty() && wantId != "..." && ODOOM_QuestIdEqInsensitive(currentId, wantId);
-			if (inTargetBlock) {
-				trackerTitle = currentTitle;
-				ODOOM_AppendQuestPctFromQLine(p, lineLen, trackerTitle);
-				ODOOM_TruncateUtf8ForZScriptCVar(trackerTitle, ODOOM_QUEST_TRACKER_TITLE_MAX_UTF8);
-				trackerObjective.clear();
-			}
-			p = lineEnd ? lineEnd + 1 : p + lineLen;
-			continue;
+	const std::string* trackerTitle = nullptr;
+	const std::string* trackerObjective = nullptr;
+	if (!wantId.empty() && wantId != "...") {
+		int qi = ODOOM_FindQuestInModel(wantId.c_str());
+		if (qi >= 0 && !model.quests[(size_t)qi].trackerTitle.empty()) {
+			trackerTitle = &model.quests[(size_t)qi].trackerTitle;
+			trackerObjective = &model.quests[(size_t)qi].trackerObjective;
 		}
-		if (lineLen >= 2 && p[0] == 'O' && p[1] == '\t' && inTargetBlock && trackerObjective.empty())
-			ODOOM_ParseOlineTrackerProgress(p, lineLen, trackerObjective);
-		p = lineEnd ? lineEnd + 1 : p + lineLen;
 	}
 
 	/* Profile ActiveQuestId may be stale (deleted quest), a sub-quest id not in top-level lines, or differ only by case — then trackerTitle stays empty and HUD stuck on "Loading...". Fall back to first top-level quest for display + progress. */
-	if (!wantId.empty() && wantId != "..." && trackerTitle.empty() && totalTopLevelBlocks > 0) {
-		const char* fp = questBuf;
-		const char* fend = questBuf + n;
-		std::string firstId, firstTitle;
-		while (fp < fend && *fp) {
-			const char* lineEnd = (const char*)memchr(fp, '\n', (size_t)(fend - fp));
-			size_t lineLen = lineEnd ? (size_t)(lineEnd - fp) : (size_t)(fend - fp);
-			if (lineLen >= 2 && fp[0] == 'Q' && fp[1] == '\t') {
-				const char* f = fp + 2;
-				const char* lineEndQ = fp + lineLen;
-				const char* t0 = (const char*)memchr(f, '\t', (size_t)(lineEndQ - f));
-				if (t0 && t0 - f > 0) firstId.assign(f, (size_t)(t0 - f));
-				if (t0 && t0 + 1 < lineEndQ) {
-					const char* t1 = (const char*)memchr(t0 + 1, '\t', (size_t)(lineEndQ - (t0 + 1)));
-					if (t1 && t1 - (t0 + 1) > 0) firstTitle.assign(t0 + 1, (size_t)(t1 - (t0 + 1)));
-				}
-				break;
-			}
-			fp = lineEnd ? lineEnd + 1 : fp + lineLen;
-		}
-		if (!firstTitle.empty()) {
-			trackerTitle = std::move(firstTitle);
-			{
-				const char* fp2 = questBuf;
-				const char* fend2 = questBuf + n;
-				while (fp2 < fend2 && *fp2) {
-					const char* lineEnd = (const char*)memchr(fp2, '\n', (size_t)(fend2 - fp2));
-					size_t lineLen = lineEnd ? (size_t)(lineEnd - fp2) : (size_t)(fend2 - fp2);
-					if (lineLen >= 2 && fp2[0] == 'Q' && fp2[1] == '\t') {
-						ODOOM_AppendQuestPctFromQLine(fp2, lineLen, trackerTitle);
-						break;
-					}
-					fp2 = lineEnd ? lineEnd + 1 : fp2 + lineLen;
-				}
-			}
-			ODOOM_TruncateUtf8ForZScriptCVar(trackerTitle, ODOOM_QUEST_TRACKER_TITLE_MAX_UTF8);
-			wantId = firstId;
-			if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-				static std::string s_tracker_id_fallback;
-				s_tracker_id_fallback = firstId;
-				UCVarValue q; q.String = (char*)s_tracker_id_fallback.c_str();
-				trackerIdVar->SetGenericRep(q, CVAR_String);
-			}
+	if (!wantId.empty() && wantId != "..." && !trackerTitle && totalTopLevelBlocks > 0) {
+		const ODOOM_QuestEntry& first = model.quests.front();
+		if (!first.trackerTitle.empty()) {
+			trackerTitle = &first.trackerTitle;
+			wantId = first.row.id;
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, first.row.id.c_str());
 		}
 	}
 
-	UCVarValue c;
-	c.Int = totalFiltered;
-	countVar->SetGenericRep(c, CVAR_Int);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_count, totalFiltered);
 	/* Only update tracker title when we have real data; empty list + no wantId => "No Active Quest Found"; empty list + wantId => "Loading quests..." (keep ids until data arrives). */
-	if (trackerTitleVar && trackerTitleVar->GetRealType() == CVAR_String) {
-		if (!trackerTitle.empty())
-			{ UCVarValue t; t.String = (char*)trackerTitle.c_str(); trackerTitleVar->SetGenericRep(t, CVAR_String); }
-		else if (wantId.empty())
-		{
-			UCVarValue t;
-			if (totalTopLevelBlocks == 0)
-				t.String = (char*)"No Active Quest Found";
-			else
-				t.String = (char*)"";
-			trackerTitleVar->SetGenericRep(t, CVAR_String);
-			if (totalTopLevelBlocks == 0)
-			{
-				if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String)
-				{
-					UCVarValue q; q.String = (char*)"";
-					trackerIdVar->SetGenericRep(q, CVAR_String);
-				}
-				FBaseCVar* trackerActiveIdVar = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
-				if (trackerActiveIdVar && trackerActiveIdVar->GetRealType() == CVAR_String)
-				{
-					UCVarValue o; o.String = (char*)"";
-					trackerActiveIdVar->SetGenericRep(o, CVAR_String);
-				}
-			}
-		}
-		else if (totalTopLevelBlocks == 0)
+	if (trackerTitle)
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, trackerTitle->c_str());
+	else if (wantId.empty())
+	{
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, totalTopLevelBlocks == 0 ? "No Active Quest Found" : "");
+		if (totalTopLevelBlocks == 0)
 		{
-			UCVarValue t; t.String = (char*)"Loading quests...";
-			trackerTitleVar->SetGenericRep(t, CVAR_String);
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, "");
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id, "");
 		}
 	}
-	if (trackerObjVar && trackerObjVar->GetRealType() == CVAR_String) {
-		UCVarValue o; o.String = (char*)(trackerObjective.empty() ? "" : trackerObjective.c_str());
-		trackerObjVar->SetGenericRep(o, CVAR_String);
-	}
+	else if (totalTopLevelBlocks == 0)
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "Loading quests...");
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_objective, trackerObjective ? trackerObjective->c_str() : "");
 	/* Tracker objectives (Need/Progress dict lines) and active index for HUD cycle (O key). Skip when placeholder "..." (loading). */
 	if (!wantId.empty() && wantId != "...") {
-		FBaseCVar* trackerActiveIdVar = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
 		ODOOM_PushTrackerProgressCvars(wantId.c_str());
 		/* Persist tracker state to API only when ZScript sets odoom_quest_persist_active_now=1 (user pressed Enter on objective or K to set tracker). Avoids persisting wrong value from UI sync or CVar restore. */
-		{
-			FBaseCVar* persistNowVar = FindCVar("odoom_quest_persist_active_now", nullptr);
-			if (persistNowVar && persistNowVar->GetRealType() == CVAR_Int && persistNowVar->GetGenericRep(CVAR_Int).Int != 0) {
-				std::string cur_q, cur_o;
-				if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-					const char* c = trackerIdVar->GetGenericRep(CVAR_String).String;
-					if (c) cur_q = c;
-				}
-				if (trackerActiveIdVar && trackerActiveIdVar->GetRealType() == CVAR_String) {
-					const char* c = trackerActiveIdVar->GetGenericRep(CVAR_String).String;
-					if (c) cur_o = c;
-				}
-				StarLogInfo("[Quests] ODOOM: Persisting tracker to API (user action): questId=%s objectiveId=%s", cur_q.c_str(), cur_o.c_str());
-				ogengine_set_active_quest(cur_q.empty() ? nullptr : cur_q.c_str(), cur_o.empty() ? nullptr : cur_o.c_str());
-				UCVarValue zero; zero.Int = 0;
-				persistNowVar->SetGenericRep(zero, CVAR_Int);
-			}
+		if (ODOOM_GetCVar(g_odoom_cv.odoom_quest_persist_active_now, 0) != 0) {
+			std::string cur_q(ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_quest_id));
+			std::string cur_o(ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id));
+			StarLogInfo("[Quests] ODOOM: Persisting tracker to API (user action): questId=%s objectiveId=%s", cur_q.c_str(), cur_o.c_str());
+			ogengine_set_active_quest(cur_q.empty() ? nullptr : cur_q.c_str(), cur_o.empty() ? nullptr : cur_o.c_str());
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_persist_active_now, 0);
 		}
 	}
 }
@@ -1901,17 +2284,10 @@ static const size_t ODOOM_QUEST_DETAIL_REQUIREMENTS_CVAR_MAX = ODOOM_ZSCRIPT_CVA
 
 /** When odoom_quest_detail_quest_id is set, fill prereqs/objectives/subquests CVars from STAR API for the 2nd (detail) popup. */
 static void ODOOM_RefreshQuestDetailCVars(void) {
-	FBaseCVar* idVar = FindCVar("odoom_quest_detail_quest_id", nullptr);
-	if (!idVar || idVar->GetRealType() != CVAR_String) return;
-	const char* id = idVar->GetGenericRep(CVAR_String).String;
-	if (!id || !id[0]) return;
-
-	FBaseCVar* prereqVar = FindCVar("odoom_quest_detail_prereqs", nullptr);
-	FBaseCVar* objVar = FindCVar("odoom_quest_detail_objectives", nullptr);
-	FBaseCVar* subVar = FindCVar("odoom_quest_detail_subquests", nullptr);
-	FBaseCVar* reqVar = FindCVar("odoom_quest_detail_requirements", nullptr);
-	FBaseCVar* selObjVar = FindCVar("odoom_quest_detail_selected_objective_id", nullptr);
-	if (!prereqVar || !objVar || !subVar || !reqVar || !selObjVar) return;
+	const char* id = ODOOM_GetCVar(g_odoom_cv.odoom_quest_detail_quest_id);
+	if (!id[0]) return;
+	if (!g_odoom_cv.odoom_quest_detail_prereqs || !g_odoom_cv.odoom_quest_detail_objectives || !g_odoom_cv.odoom_quest_detail_subquests ||
+		!g_odoom_cv.odoom_quest_detail_requirements || !g_odoom_cv.odoom_quest_detail_selected_objective_id) return;
 
 	static char buf[1024];
 	int nr = ogengine_get_quest_prereqs_string(id, buf, sizeof(buf));
@@ -1922,8 +2298,7 @@ static void ODOOM_RefreshQuestDetailCVars(void) {
 	if (len > ODOOM_QUEST_DETAIL_CVAR_MAX) len = ODOOM_QUEST_DETAIL_CVAR_MAX;
 	static std::string s_prereqs;
 	s_prereqs.assign(buf, len);
-	UCVarValue vp; vp.String = (char*)s_prereqs.c_str();
-	prereqVar->SetGenericRep(vp, CVAR_String);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_detail_prereqs, s_prereqs.c_str());
 
 	int no = ogengine_get_quest_objectives_string(id, buf, sizeof(buf));
 	if (no < 0) no = 0;
@@ -1933,8 +2308,7 @@ static void ODOOM_RefreshQuestDetailCVars(void) {
 	if (len > ODOOM_QUEST_DETAIL_CVAR_MAX) len = ODOOM_QUEST_DETAIL_CVAR_MAX;
 	static std::string s_obj;
 	s_obj.assign(buf, len);
-	UCVarValue vo; vo.String = (char*)s_obj.c_str();
-	objVar->SetGenericRep(vo, CVAR_String);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_detail_objectives, s_obj.c_str());
 
 	int ns = ogengine_get_quest_sub_quests_string(id, buf, sizeof(buf));
 	if (ns < 0) ns = 0;
@@ -1944,11 +2318,9 @@ static void ODOOM_RefreshQuestDetailCVars(void) {
 	if (len > ODOOM_QUEST_DETAIL_CVAR_MAX) len = ODOOM_QUEST_DETAIL_CVAR_MAX;
 	static std::string s_sub;
 	s_sub.assign(buf, len);
-	UCVarValue vs; vs.String = (char*)s_sub.c_str();
-	subVar->SetGenericRep(vs, CVAR_String);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_detail_subquests, s_sub.c_str());
 
-	const char* selObj = selObjVar->GetRealType() == CVAR_String ? selObjVar->GetGenericRep(CVAR_String).String : nullptr;
-	if (!selObj) selObj = "";
+	const char* selObj = ODOOM_GetCVar(g_odoom_cv.odoom_quest_detail_selected_objective_id);
 	static char reqBuf[4096];
 	int nreq = ogengine_get_quest_objective_requirements_string(id, selObj, reqBuf, sizeof(reqBuf));
 	if (nreq < 0) nreq = 0;
@@ -1958,11 +2330,11 @@ static void ODOOM_RefreshQuestDetailCVars(void) {
 	if (len > ODOOM_QUEST_DETAIL_REQUIREMENTS_CVAR_MAX) len = ODOOM_QUEST_DETAIL_REQUIREMENTS_CVAR_MAX;
 	static std::string s_req;
 	s_req.assign(reqBuf, len);
-	UCVarValue vr; vr.String = (char*)s_req.c_str();
-	reqVar->SetGenericRep(vr, CVAR_String);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_detail_requirements, s_req.c_str());
 }
 
 static void ODOOM_OnAuthDone(void* user_data);
+static void ODOOM_OnBeaminDone(oglib_beamin_result_t result, const char* username, void* user_data);
 static void ODOOM_OnSendItemDone(void* user_data);
 static void ODOOM_OnUseItemDone(void* user_data);
 
@@ -1977,10 +2349,9 @@ static void ODOOM_StartInventorySyncIfNeeded(void) {
 /** Called from C# client when an async operation completes (e.g. ProfileLoaded after restore or refresh). Run on client thread; we only set a flag and let the frame pump apply it on the main thread. */
 static void ODOOM_StarApiOperationCallback(ogengine_result_t result, int operation_type, void* user_data) {
 	(void)user_data;
+	oglib_beamin_on_operation(&g_odoom_beamin, result, operation_type);  /* atomics only; a rejected restore is reported from ODOOM_OnBeaminDone on the main thread */
 	if (operation_type == OGENGINE_OP_PROFILE_LOADED && result == OGENGINE_SUCCESS)
 		g_odoom_profile_loaded_pending = true;
-	if (operation_type == OGENGINE_OP_PROFILE_LOADED && result != OGENGINE_SUCCESS)
-		Printf(PRINT_NONOTIFY, "Session restore failed (session may have expired). Use 'star beamin' to log in again.\n");
 	if (operation_type == OGENGINE_OP_GET_INVENTORY) {
 		ogengine_item_list_t* list = nullptr;
 		if (result == OGENGINE_SUCCESS)
@@ -2026,35 +2397,20 @@ static void ODOOM_OnAuthDone(void* user_data) {
 		// 	g_star_refresh_xp_called_this_session = true;
 		// 	ogengine_refresh_avatar_xp();
 		// }
-		/* Load avatar (XP + active quest/objective) so we can restore tracker state. Profile load is async so get_active_quest_id is not ready yet; show "Loading..." immediately so tracker appears (like Quake). */
-		ogengine_refresh_avatar_profile();
+		/* Load avatar (XP + active quest/objective), inventory and quests in parallel so the HUD fills after one round trip. Profile load is async so get_active_quest_id is not ready yet; show "Loading..." immediately so tracker appears (like Quake). */
+		oglib_beamin_begin(&g_odoom_beamin, OGLIB_BEAMIN_STATE_PREFETCHING, username_buf);
+		oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+		g_odoom_beamin_prefetched = true;
 		{
 			/* Placeholder tracker id so HUD shows "Loading..." before profile returns; frame pump will replace with real id when get_active_quest_id returns. */
-			static const char s_tracker_loading_placeholder[] = "...";
-			FBaseCVar* trackerIdVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-			if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-				UCVarValue u; u.String = (char*)s_tracker_loading_placeholder;
-				trackerIdVar->SetGenericRep(u, CVAR_String);
-			}
-			FBaseCVar* titleVar = FindCVar("odoom_quest_tracker_title", nullptr);
-			if (titleVar && titleVar->GetRealType() == CVAR_String) {
-				UCVarValue t; t.String = (char*)"Loading...";
-				titleVar->SetGenericRep(t, CVAR_String);
-			}
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, "...");
+			ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "Loading...");
 			char qid[64] = {};
 			char oid[64] = {};
 			if (ogengine_get_active_quest_id(qid, sizeof(qid)) && qid[0]) {
-				if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-					UCVarValue u; u.String = qid;
-					trackerIdVar->SetGenericRep(u, CVAR_String);
-				}
-				if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0]) {
-					FBaseCVar* v = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
-					if (v && v->GetRealType() == CVAR_String) {
-						UCVarValue u; u.String = oid;
-						v->SetGenericRep(u, CVAR_String);
-					}
-				}
+				ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, qid);
+				if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0])
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id, oid);
 			}
 			/* Quest list fetch: avoid duplicate GET — AuthenticateAsync already Invalidate+Request; JWT restore uses profile-loaded path below. */
 			ODOOM_RefreshQuestCVars();  /* push once immediately in case cache already has data */
@@ -2076,19 +2432,39 @@ static void ODOOM_OnAuthDone(void* user_data) {
 			Printf(PRINT_NONOTIFY, "Beam-in failed: %s\n", msg);
 		}
 		/* Show error on screen once via toast so user sees it even if console is closed. */
-		FBaseCVar* toastMsgCv = FindCVar("odoom_star_toast_message", nullptr);
-		FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames", nullptr);
-		if (toastMsgCv && toastMsgCv->GetRealType() == CVAR_String && toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
+		{
 			char toastBuf[256];
 			std::snprintf(toastBuf, sizeof(toastBuf), "Beam-in failed: %s", msg);
-			UCVarValue vMsg; vMsg.String = toastBuf;
-			toastMsgCv->SetGenericRep(vMsg, CVAR_String);
-			UCVarValue vFrames; vFrames.Int = 175;  /* ~5 s at 35 fps */
-			toastFramesCv->SetGenericRep(vFrames, CVAR_Int);
+			ODOOM_ShowToast(toastBuf, 175);  /* ~5 s at 35 fps */
 		}
 	}
 }
 
+/** Called from main thread by oglib_beamin_poll() once profile, stats, inventory and quests have all reported (or timed out), or the saved JWT was rejected. */
+static void ODOOM_OnBeaminDone(oglib_beamin_result_t result, const char* username, void* user_data) {
+	(void)user_data;
+	if (result == OGLIB_BEAMIN_OK) {
+		/* XP/karma can land after the inventory pushed the HUD; re-push HUD and tracker once with the full set. */
+		g_odoom_inventory_refresh_pending = true;
+		g_odoom_quests_cache_refresh_pending = true;
+		if (g_star_debug_logging)
+			StarLogInfo("Beam-in ready for %s: profile, stats, inventory and quests loaded.", username ? username : "(avatar)");
+		return;
+	}
+	if (result == OGLIB_BEAMIN_TIMEOUT) {
+		Printf(PRINT_NONOTIFY, "Session restore timed out (no response from server). Use 'star beamin' to log in again.\n");
+		return;
+	}
+	/* JWT rejected: drop the dead session so the next launch does not restore it again. */
+	g_odoom_saved_jwt[0] = '\0';
+	g_odoom_saved_refresh_token[0] = '\0';
+	g_star_initialized = false;
+	g_star_init_failed_this_session = true;  /* No silent re-restore from door/touch paths; "star beamin" starts over. */
+	odoom_star_username = "";
+	ODOOM_SaveStarConfigToFiles();
+	Printf(PRINT_NONOTIFY, "Session restore failed (session may have expired). Use 'star beamin' to log in again.\n");
+}
+
 /** Called from main thread by ogengine_sync_pump() when send-item completes (same pattern as Quake). */
 static void ODOOM_OnSendItemDone(void* user_data) {
 	(void)user_data;
@@ -2110,14 +2486,19 @@ static void ODOOM_OnSendItemDone(void* user_data) {
 		g_odoom_last_sent_item_name.clear();
 		g_odoom_last_sent_qty = 0;
 	}
-	FBaseCVar* statusVar = FindCVar("odoom_send_status", nullptr);
-	if (statusVar && statusVar->GetRealType() == CVAR_String) {
-		UCVarValue val; val.String = s_send_status_buf;
-		statusVar->SetGenericRep(val, CVAR_String);
-	}
+	ODOOM_SetCVar(g_odoom_cv.odoom_send_status, s_send_status_buf);
 	/* Do NOT refetch inventory here; we updated the cache above. Keeps API hits to minimum. */
 }
 
+/** True if a new send may start now (see ODOOM_CanStartUseItem). */
+static bool ODOOM_CanStartSendItem(void) {
+#ifdef OGENGINE_SYNC_HAS_OP_QUEUES
+	return true;
+#else
+	return !ogengine_sync_send_item_in_progress();
+#endif
+}
+
 /** Strip UI-only [NFT] / [BOSSNFT] prefix so we match API-stored names. */
 static std::string ODOOM_StripNftDisplayPrefix(const std::string& name) {
 	const size_t np = (size_t)(-1);
@@ -2156,9 +2537,7 @@ static bool ODOOM_WouldUseExceedMax(const std::string& name, const std::string&
 	std::string n = ODOOM_StripNftDisplayPrefix(name);
 	/* Megasphere / OASIS.MegaHealthArmor: +200 HP and +200 armor in one STAR row */
 	if (ODOOM_NameEqualsCanon(n, kOasisMegaHealthArmor) || n.find("Mega Sphere") != np) {
-		int configMaxH = 200, configMaxA = 200;
-		{ FBaseCVar* v = FindCVar("odoom_star_max_health", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxH = v->GetGenericRep(CVAR_Int).Int; if (configMaxH <= 0) configMaxH = 200; }
-		{ FBaseCVar* v = FindCVar("odoom_star_max_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxA = v->GetGenericRep(CVAR_Int).Int; if (configMaxA <= 0) configMaxA = 200; }
+		const int configMaxH = ODOOM_ConfigMaxHealth(), configMaxA = ODOOM_ConfigMaxArmor();
 		const int dh = 200, da = 200;
 		int curH = player->mo->health;
 		AActor* arm = player->mo->FindInventory(FName("BasicArmor"), true);
@@ -2174,9 +2553,7 @@ static bool ODOOM_WouldUseExceedMax(const std::string& name, const std::string&
 		n.find("Soul") != np || n.find("Mega") != np || n.find("Health") != np);
 	const bool isArmor = (type.find("Armor") != np || type.find("armor") != np ||
 		n.find("Armor") != np || n.find("Blue") != np || n.find("Green") != np || n.find("Yellow") != np);
-	int configMaxH = 200, configMaxA = 200;
-	{ FBaseCVar* v = FindCVar("odoom_star_max_health", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxH = v->GetGenericRep(CVAR_Int).Int; if (configMaxH <= 0) configMaxH = 200; }
-	{ FBaseCVar* v = FindCVar("odoom_star_max_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxA = v->GetGenericRep(CVAR_Int).Int; if (configMaxA <= 0) configMaxA = 200; }
+	const int configMaxH = ODOOM_ConfigMaxHealth(), configMaxA = ODOOM_ConfigMaxArmor();
 	if (isHealth) {
 		int amount = (description && description[0]) ? ODOOM_ParseAmountFromDescription(std::string(description)) : 0;
 		if (amount <= 0) amount = ODOOM_ParseAmountFromDescription(n);
@@ -2216,28 +2593,18 @@ static void ODOOM_ApplyHealthOrArmor(const std::string& name, const std::string&
 	if (!level) return;
 	player_t* player = level->GetConsolePlayer();
 	if (!player || !player->mo) return;
-	g_star_deferred_apply_health = false;
-	g_star_deferred_apply_armor = false;
-	g_star_deferred_health_value = -1;
-	g_star_deferred_armor_value = -1;
 	const size_t np = (size_t)(-1);
 	std::string n = ODOOM_StripNftDisplayPrefix(name);
 	if (ODOOM_NameEqualsCanon(n, kOasisMegaHealthArmor) || n.find("Mega Sphere") != np) {
-		int configMaxH = 200, configMaxA = 200;
-		{ FBaseCVar* v = FindCVar("odoom_star_max_health", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxH = v->GetGenericRep(CVAR_Int).Int; if (configMaxH <= 0) configMaxH = 200; }
-		{ FBaseCVar* v = FindCVar("odoom_star_max_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxA = v->GetGenericRep(CVAR_Int).Int; if (configMaxA <= 0) configMaxA = 200; }
+		const int configMaxH = ODOOM_ConfigMaxHealth(), configMaxA = ODOOM_ConfigMaxArmor();
 		const int dh = 200, da = 200;
 		if (P_GiveBody(player->mo, dh, configMaxH)) {
-			g_star_deferred_apply_health = true;
-			g_star_deferred_health_value = player->mo->health;
 			Printf(PRINT_HIGH, "STAR: used %s, health now %d\n", n.c_str(), player->mo->health);
 		}
 		AActor* arm = player->mo->FindInventory(FName("BasicArmor"), true);
 		if (arm) {
 			int& a = arm->IntVar(FName("Amount"));
 			{ int newA = a + da; int cap = configMaxA; a = (newA < cap) ? newA : cap; }
-			g_star_deferred_apply_armor = true;
-			g_star_deferred_armor_value = a;
 			Printf(PRINT_HIGH, "STAR: used %s, armor now %d\n", n.c_str(), a);
 		}
 		return;
@@ -2247,9 +2614,7 @@ static void ODOOM_ApplyHealthOrArmor(const std::string& name, const std::string&
 		n.find("Soul") != np || n.find("Mega") != np || n.find("Health") != np);
 	const bool isArmor = (type.find("Armor") != np || type.find("armor") != np ||
 		n.find("Armor") != np || n.find("Blue") != np || n.find("Green") != np || n.find("Yellow") != np);
-	int configMaxH = 200, configMaxA = 200;
-	{ FBaseCVar* v = FindCVar("odoom_star_max_health", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxH = v->GetGenericRep(CVAR_Int).Int; if (configMaxH <= 0) configMaxH = 200; }
-	{ FBaseCVar* v = FindCVar("odoom_star_max_armor", nullptr); if (v && v->GetRealType() == CVAR_Int) configMaxA = v->GetGenericRep(CVAR_Int).Int; if (configMaxA <= 0) configMaxA = 200; }
+	const int configMaxH = ODOOM_ConfigMaxHealth(), configMaxA = ODOOM_ConfigMaxArmor();
 	if (isHealth) {
 		int amount = (description && description[0]) ? ODOOM_ParseAmountFromDescription(std::string(description)) : 0;
 		if (amount <= 0) amount = ODOOM_ParseAmountFromDescription(n);
@@ -2265,8 +2630,6 @@ static void ODOOM_ApplyHealthOrArmor(const std::string& name, const std::string&
 		}
 		/* Use engine path so HUD updates; config max allows over 200 when set higher. */
 		if (P_GiveBody(player->mo, amount, configMaxH)) {
-			g_star_deferred_apply_health = true;
-			g_star_deferred_health_value = player->mo->health;
 			Printf(PRINT_HIGH, "STAR: used %s, health now %d\n", n.c_str(), player->mo->health);
 		}
 	}
@@ -2282,8 +2645,6 @@ static void ODOOM_ApplyHealthOrArmor(const std::string& name, const std::string&
 		if (arm) {
 			int& a = arm->IntVar(FName("Amount"));
 			{ int newA = a + amount; int cap = configMaxA; a = (newA < cap) ? newA : cap; }
-			g_star_deferred_apply_armor = true;
-			g_star_deferred_armor_value = a;
 			Printf(PRINT_HIGH, "STAR: used %s, armor now %d\n", n.c_str(), a);
 		}
 	}
@@ -2313,26 +2674,125 @@ static bool ODOOM_FindFirstHealthOrArmorInInventory(bool want_health, std::strin
 	return false;
 }
 
-/** Called when use-item from inventory (E on STAR row) completes. Defer Health/Armor apply to next frame so the engine does not overwrite it. */
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+/** Success path of a use-item from inventory: defer the Health/Armor apply to the next game tic so prediction does not undo it. */
+static void ODOOM_FinishUseFromInventory(bool success, const std::string& name, const std::string& type, const std::string& description, const char* err) {
+	if (success && !name.empty()) {
+		g_star_deferred_applies.push_back(ODOOM_PendingUse{ name, type, description });
+		g_star_deferred_apply_count++;
+	}
+	if (success)
+		ODOOM_RefreshOverlayFromClient();
+	else if (err && err[0])
+		StarLogError("ogengine_use_item failed: %s", err);
+}
+#endif
+
+/** Health/Armor of one deferred use; (+X) from its description when present. Inside a tic only (ODOOM_PostOneTic). */
+static void ODOOM_ApplyDeferredUse(const ODOOM_PendingUse& use) {
+	ODOOM_ApplyHealthOrArmor(use.name, use.type, use.description.empty() ? nullptr : use.description.c_str());
+}
+
+static void ODOOM_SetToastMessage(const char* msg);
+
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+static int ODOOM_ConsolePlayerArmor(player_t* player) {
+	AActor* arm = (player && player->mo) ? player->mo->FindInventory(FName("BasicArmor"), true) : nullptr;
+	return arm ? arm->IntVar(FName("Amount")) : 0;
+}
+
+/** Optimistic use: apply next tic as if the server had already accepted, and drop the quantity shown now. */
+static int ODOOM_OptimisticUseApply(const char* name, void* user_data) {
+	ODOOM_PendingUse* use = static_cast<ODOOM_PendingUse*>(user_data);
+	(void)name;
+	use->in_use = true;
+	use->apply_pending = true;
+	use->health_gain = use->armor_gain = 0;
+	g_star_deferred_apply_count++;
+	g_odoom_inventory_refresh_pending = true;  /* re-read the client cache through the pending-use adjustment */
+	ODOOM_RefreshOverlayFromClient();
+	return 1;
+}
+
+static void ODOOM_OptimisticUseCommit(const char* name, void* user_data) {
+	ODOOM_PendingUse* use = static_cast<ODOOM_PendingUse*>(user_data);
+	(void)name;
+	use->in_use = false;  /* a pending apply still runs; the slot stays taken until it has */
+	ODOOM_RefreshOverlayFromClient();
+}
+
+/** The server rejected an optimistic use: take back what was applied, restore the quantity and tell the player. */
+static void ODOOM_OptimisticUseRollback(const char* name, const char* error, void* user_data) {
+	ODOOM_PendingUse* use = static_cast<ODOOM_PendingUse*>(user_data);
+	if (use->apply_pending) {
+		use->apply_pending = false;  /* not applied yet: nothing to take back */
+		g_star_deferred_apply_count--;
+	}
+	/* Like the apply, the take-back is written inside the next tic. */
+	g_star_deferred_rollback_health += use->health_gain;
+	g_star_deferred_rollback_armor += use->armor_gain;
+	use->health_gain = use->armor_gain = 0;
+	char msg[384];
+	std::snprintf(msg, sizeof(msg), "Could not use %s: %s", name, error);
+	ODOOM_SetToastMessage(msg);
+	StarLogError("ogengine_use_item failed: %s", error);
+	use->in_use = false;
+	g_odoom_inventory_refresh_pending = true;
+	ODOOM_RefreshOverlayFromClient();
+}
+
+static const ogengine_sync_use_effect_t kOdoomUseEffect = { ODOOM_OptimisticUseApply, ODOOM_OptimisticUseCommit, ODOOM_OptimisticUseRollback };
+
+/** Start an optimistic use; false if too many uses are still waiting for the server (nothing applied). */
+static bool ODOOM_UseFromInventoryOptimistic(const std::string& name, const std::string& type, const std::string& description, const char* context) {
+	for (ODOOM_PendingUse& slot : g_odoom_optimistic_uses) {
+		if (slot.in_use || slot.apply_pending) continue;
+		slot.name = name;
+		slot.type = type;
+		slot.description = description;
+		ogengine_sync_use_item_optimistic(name.c_str(), context, 0, &kOdoomUseEffect, &slot);
+		return true;  /* queued, or already rolled back with a toast if the queue was full */
+	}
+	return false;
+}
+#elif defined(OGENGINE_SYNC_HAS_COROUTINES)
+/** Use an inventory Health/Armor item (E on STAR row); resumes from ogengine_sync_pump when the server answers. */
+static star::task ODOOM_UseFromInventory(std::string name, std::string type, std::string description, const char* context) {
+	star::item_result used = co_await star::use_item(name.c_str(), context);
+	ODOOM_FinishUseFromInventory(used.success, name, type, description, used.error.c_str());
+}
+#else
+/** Called when use-item from inventory (E on STAR row) completes. */
 static void ODOOM_OnUseItemFromInventoryDone(void* user_data) {
-	(void)user_data;
+	ODOOM_PendingUse* pending = static_cast<ODOOM_PendingUse*>(user_data);
 	int success = 0;
 	char err_buf[384] = {};
-	if (!ogengine_sync_use_item_get_result(&success, err_buf, sizeof(err_buf)))
-		return;
-	if (success && !g_star_use_pending_name.empty()) {
-		g_star_deferred_apply_name = g_star_use_pending_name;
-		g_star_deferred_apply_type = g_star_use_pending_type;
-		g_star_deferred_apply_description = g_star_use_pending_description;
-		g_star_deferred_apply_frames = 35; /* re-apply for ~1 sec so engine/voodoo overwrites don't revert health */
-	}
-	g_star_use_pending_name.clear();
-	g_star_use_pending_type.clear();
-	g_star_use_pending_description.clear();
-	if (success)
-		ODOOM_RefreshOverlayFromClient();
-	else if (err_buf[0])
-		StarLogError("ogengine_use_item failed: %s", err_buf);
+	if (ogengine_sync_use_item_get_result(&success, err_buf, sizeof(err_buf)) && pending)
+		ODOOM_FinishUseFromInventory(success != 0, pending->name, pending->type, pending->description, err_buf);
+	delete pending;
+}
+#endif
+
+/** Start a use-item for an inventory Health/Armor item. Optimistic (applied at once, undone if rejected) with the C sync layer; otherwise applied on success. */
+static void ODOOM_StartUseFromInventory(const std::string& name, const std::string& type, const std::string& description, const char* context) {
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+	if (!ODOOM_UseFromInventoryOptimistic(name, type, description, context))
+		ODOOM_SetToastMessage("Too many uses waiting for STAR; try again.");
+#elif defined(OGENGINE_SYNC_HAS_COROUTINES)
+	ODOOM_UseFromInventory(name, type, description, context);
+#else
+	ODOOM_PendingUse* pending = new ODOOM_PendingUse{ name, type, description };
+	ogengine_sync_use_item_start(name.c_str(), context, ODOOM_OnUseItemFromInventoryDone, pending);
+#endif
+}
+
+/** True if a new use-item may start now. The queued C sync keeps overlapping uses (two quick health packs both apply); the single-slot client sync drops them, so wait for it. */
+static bool ODOOM_CanStartUseItem(void) {
+#ifdef OGENGINE_SYNC_HAS_OP_QUEUES
+	return true;
+#else
+	return !ogengine_sync_use_item_in_progress();
+#endif
 }
 
 /** Called from main thread by ogengine_sync_pump() when use-item (e.g. door key) completes. */
@@ -2355,92 +2815,72 @@ static void ODOOM_FlipHudIntCVar(const char* cvarName);
 /** Called every frame from the main loop (see patch_uzdoom_engine.ps1: d_main and g_game). Must run so send/auth/inventory callbacks are invoked. */
 void ODOOM_InventoryInputCaptureFrame(void)
 {
-	/* Deferred health/armor is applied in ODOOM_PostTic (after the tic) so the HUD is not overwritten. */
+	/* Deferred health/armor is applied in ODOOM_PostOneTic (inside the tic) so prediction does not undo it. */
+
+	if (!g_odoom_cv_final) {
+		std::string missing;
+		if (ODOOM_BindCVars(&missing) > 0)
+			StarLogError("odoom_cvarinfo.txt CVars not found (overlay will not see them): %s", missing.c_str());
+		g_odoom_cv_final = true;
+	}
 
 	/* Decrement toast frame counters so ZScript shows messages for their duration. */
 	{
-		FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames", nullptr);
-		if (toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
-			int f = toastFramesCv->GetGenericRep(CVAR_Int).Int;
-			if (f > 0) {
-				UCVarValue v; v.Int = f - 1;
-				toastFramesCv->SetGenericRep(v, CVAR_Int);
-			}
-		}
-		FBaseCVar* pickupFramesCv = FindCVar("odoom_star_pickup_toast_frames", nullptr);
-		if (pickupFramesCv && pickupFramesCv->GetRealType() == CVAR_Int) {
-			int f = pickupFramesCv->GetGenericRep(CVAR_Int).Int;
-			if (f > 0) {
-				UCVarValue v; v.Int = f - 1;
-				pickupFramesCv->SetGenericRep(v, CVAR_Int);
-			}
-		}
+		const int f = ODOOM_GetCVar(g_odoom_cv.odoom_star_toast_frames, 0);
+		if (f > 0) ODOOM_SetCVar(g_odoom_cv.odoom_star_toast_frames, f - 1);
+		const int pf = ODOOM_GetCVar(g_odoom_cv.odoom_star_pickup_toast_frames, 0);
+		if (pf > 0) ODOOM_SetCVar(g_odoom_cv.odoom_star_pickup_toast_frames, pf - 1);
 	}
 
-	ogengine_sync_pump();
-
-	/* --- cross-game spawn poll --- */
+	OGLIB_TRACE_BEGIN("ODOOM ogengine_sync_pump", "odoom");
+#ifdef OGENGINE_SYNC_HAS_PUMP_BUDGET
 	{
-		char entity_id[128];
-		float sx, sy, sz;
-		if (ogengine_poll_spawn_event(entity_id, sizeof(entity_id), &sx, &sy, &sz))
-		{
-			oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: %s at %.0f/%.0f/%.0f", entity_id, sx, sy, sz);
-			FString summonCmd;
-			summonCmd.Format("summon %s", entity_id);
-			C_DoCommand(summonCmd.GetChars());
-			ogengine_confirm_spawn(entity_id);
-		}
+		int backlog = ogengine_sync_pump_budget(ODOOM_SYNC_PUMP_BUDGET_US);
+		OGLIB_TRACE_COUNTER("ODOOM sync backlog", "odoom", backlog);
 	}
+#else
+	ogengine_sync_pump();
+#endif
+	OGLIB_TRACE_END("ODOOM ogengine_sync_pump", "odoom");
+	oglib_beamin_poll(&g_odoom_beamin);
 
-	/* --- cross-game event poll --- */
+	/* --- cross-game spawns and events: drained as one batch of parsed events, so a spawn wave lands this frame --- */
 	{
-		char evt_json[4096];
-		while (ogengine_poll_cross_game_event(evt_json, sizeof(evt_json)))
+		static oglib_event_t s_events[OGLIB_EVENTS_BATCH];
+		const int n = oglib_events_drain(s_events, OGLIB_EVENTS_BATCH);
+		for (int i = 0; i < n; i++)
 		{
-			char evt_type[64] = "";
-			ODOOM_ExtractJsonValue(evt_json, "EventType", evt_type, sizeof(evt_type));
-			if (strcmp(evt_type, "ShowNarration") == 0) {
-				char narration[512] = "";
-				ODOOM_ExtractJsonValue(evt_json, "NarrationText", narration, sizeof(narration));
-				if (narration[0]) {
-					FBaseCVar* toastMsgCv    = FindCVar("odoom_star_toast_message", nullptr);
-					FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames",  nullptr);
-					if (toastMsgCv && toastMsgCv->GetRealType() == CVAR_String &&
-					    toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
-						UCVarValue vMsg;    vMsg.String = narration;
-						UCVarValue vFrames; vFrames.Int = 210; /* ~6 s at 35 fps */
-						toastMsgCv->SetGenericRep(vMsg, CVAR_String);
-						toastFramesCv->SetGenericRep(vFrames, CVAR_Int);
-					}
-				}
-			} else if (strcmp(evt_type, "PlayAudio") == 0) {
-				char audio_url[256] = "";
-				char audio_title[128] = "";
-				ODOOM_ExtractJsonValue(evt_json, "AudioUrl",   audio_url,   sizeof(audio_url));
-				ODOOM_ExtractJsonValue(evt_json, "AudioTitle", audio_title, sizeof(audio_title));
-				oasis_open_url(audio_url);
-				if (audio_title[0]) ODOOM_SetToastMessage(audio_title);
-				oglib_log(OGLIB_LOG_INFO, "OASIS PlayAudio: %s -> %s", audio_title, audio_url);
-			} else if (strcmp(evt_type, "PlayVideo") == 0) {
-				char video_url[256] = "";
-				char video_title[128] = "";
-				ODOOM_ExtractJsonValue(evt_json, "VideoUrl",   video_url,   sizeof(video_url));
-				ODOOM_ExtractJsonValue(evt_json, "VideoTitle", video_title, sizeof(video_title));
-				oasis_open_url(video_url);
-				if (video_title[0]) ODOOM_SetToastMessage(video_title);
-				oglib_log(OGLIB_LOG_INFO, "OASIS PlayVideo: %s -> %s", video_title, video_url);
-			} else if (strcmp(evt_type, "OpenWebsite") == 0) {
-				char website_url[256] = "";
-				ODOOM_ExtractJsonValue(evt_json, "WebsiteUrl", website_url, sizeof(website_url));
-				oasis_open_url(website_url);
-				oglib_log(OGLIB_LOG_INFO, "OASIS OpenWebsite: %s", website_url);
-			} else if (strcmp(evt_type, "UnlockPortal") == 0) {
-				char portal_id[64] = "";
-				ODOOM_ExtractJsonValue(evt_json, "PortalId", portal_id, sizeof(portal_id));
-				ogengine_notify_portal_unlock(portal_id);
+			const oglib_event_t* e = &s_events[i];
+			switch (e->kind) {
+			case OGLIB_EVENT_SPAWN: {
+				oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: %s at %.0f/%.0f/%.0f", e->id, e->x, e->y, e->z);
+				FString summonCmd;
+				summonCmd.Format("summon %s", e->id);
+				C_DoCommand(summonCmd.GetChars());
+				ogengine_confirm_spawn(e->id);
+				break;
+			}
+			case OGLIB_EVENT_NARRATION:
+				if (e->text[0])
+					ODOOM_ShowToast(e->text, 210); /* ~6 s at 35 fps */
+				break;
+			case OGLIB_EVENT_AUDIO:
+			case OGLIB_EVENT_VIDEO:
+				oasis_open_url(e->url);
+				if (e->title[0]) ODOOM_SetToastMessage(e->title);
+				oglib_log(OGLIB_LOG_INFO, "OASIS %s: %s -> %s", e->kind == OGLIB_EVENT_AUDIO ? "PlayAudio" : "PlayVideo", e->title, e->url);
+				break;
+			case OGLIB_EVENT_WEBSITE:
+				oasis_open_url(e->url);
+				oglib_log(OGLIB_LOG_INFO, "OASIS OpenWebsite: %s", e->url);
+				break;
+			case OGLIB_EVENT_PORTAL_UNLOCK:
+				ogengine_notify_portal_unlock(e->id);
 				ODOOM_SetToastMessage("Portal unlocked!");
-				oglib_log(OGLIB_LOG_INFO, "OASIS UnlockPortal: %s", portal_id);
+				oglib_log(OGLIB_LOG_INFO, "OASIS UnlockPortal: %s", e->id);
+				break;
+			default:
+				break;
 			}
 		}
 	}
@@ -2460,6 +2900,10 @@ void ODOOM_InventoryInputCaptureFrame(void)
 		g_star_async_auth_pending_frames++;
 		if (g_star_async_auth_pending_frames > 35 * 30) {  /* 30 s at 35 fps */
 			g_star_async_auth_pending = false;
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+			ogengine_sync_cancel(g_star_auth_op);  /* drop the hung job so a later beamin can start a fresh one */
+			g_star_auth_op = OGENGINE_SYNC_OP_NONE;
+#endif
 			g_star_init_failed_this_session = true;  /* Same as auth callback failure: no silent retry storm. */
 			odoom_star_username = "";
 			if (!g_star_beamin_timeout_was_shown) {
@@ -2467,14 +2911,7 @@ void ODOOM_InventoryInputCaptureFrame(void)
 				static char s_timeout_msg[128];
 				std::snprintf(s_timeout_msg, sizeof(s_timeout_msg), "Beam-in failed: timeout (no response from server).");
 				Printf(PRINT_NONOTIFY, "%s\n", s_timeout_msg);
-				FBaseCVar* toastMsgCv = FindCVar("odoom_star_toast_message", nullptr);
-				FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames", nullptr);
-				if (toastMsgCv && toastMsgCv->GetRealType() == CVAR_String && toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
-					UCVarValue vMsg; vMsg.String = s_timeout_msg;
-					toastMsgCv->SetGenericRep(vMsg, CVAR_String);
-					UCVarValue vFrames; vFrames.Int = 175;
-					toastFramesCv->SetGenericRep(vFrames, CVAR_Int);
-				}
+				ODOOM_ShowToast(s_timeout_msg, 175);
 			}
 		}
 	}
@@ -2498,6 +2935,8 @@ void ODOOM_InventoryInputCaptureFrame(void)
 		if (ogengine_consume_last_mint_result(item_buf, sizeof(item_buf), nft_buf, sizeof(nft_buf), hash_buf, sizeof(hash_buf)))
 			Printf(PRINT_HIGH, "NFT minted: %s | ID: %s | Hash: %s\n", item_buf, nft_buf, hash_buf[0] ? hash_buf : "(none)");
 	}
+	ODOOM_PumpBossNftMints();
+	ODOOM_PumpStarBatch();
 	/* Show any background errors (mint/add_item failure or pickup not queued) in console. */
 	{
 		char err_buf[512] = {};
@@ -2506,6 +2945,7 @@ void ODOOM_InventoryInputCaptureFrame(void)
 	}
 	/* Show STAR log messages in console only when star debug is on. Quest logs are file-only to avoid crashes when consuming. */
 	ogengine_set_debug(g_star_debug_logging ? 1 : 0);
+	oglib_log_async_set_echo_stderr(g_star_debug_logging ? 1 : 0);
 	if (g_star_debug_logging) {
 		char log_buf[512] = {};
 		for (int i = 0; i < 5; i++) {
@@ -2531,70 +2971,43 @@ void ODOOM_InventoryInputCaptureFrame(void)
 	}
 
 	/* ZScript reads this so it only gives/shows OQuake keys when beamed in. */
-	{
-		FBaseCVar* beamedVar = FindCVar("odoom_star_beamed_in", nullptr);
-		if (beamedVar && beamedVar->GetRealType() == CVAR_Int) {
-			UCVarValue u; u.Int = g_star_initialized ? 1 : 0;
-			beamedVar->SetGenericRep(u, CVAR_Int);
-		}
-	}
+	ODOOM_SetCVar(g_odoom_cv.odoom_star_beamed_in, g_star_initialized ? 1 : 0);
 
 	/* Quest: start + set active objective (Not Started detail Enter). ogengine_start_quest_then_set_active_objective — deploy fresh star_api.* with ODOOM (see OASIS Omniverse/Docs/ODOOM_UZDoom_Build_Sync.md). */
-	{
-		FBaseCVar* chainVar = FindCVar("odoom_quest_start_then_track_do_it", nullptr);
-		if (g_star_initialized && chainVar && chainVar->GetRealType() == CVAR_Int && chainVar->GetGenericRep(CVAR_Int).Int != 0) {
-			FBaseCVar* tidVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-			FBaseCVar* oidVar = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
-			const char* qid = (tidVar && tidVar->GetRealType() == CVAR_String) ? tidVar->GetGenericRep(CVAR_String).String : nullptr;
-			const char* oid = (oidVar && oidVar->GetRealType() == CVAR_String) ? oidVar->GetGenericRep(CVAR_String).String : nullptr;
-			if (qid && qid[0] && oid && oid[0])
-				ogengine_start_quest_then_set_active_objective(qid, oid);
-			g_odoom_quest_tracker_needs_refresh = true;
-			UCVarValue z; z.Int = 0;
-			chainVar->SetGenericRep(z, CVAR_Int);
-		}
+	if (g_star_initialized && ODOOM_GetCVar(g_odoom_cv.odoom_quest_start_then_track_do_it, 0) != 0) {
+		const char* qid = ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_quest_id);
+		const char* oid = ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id);
+		if (qid[0] && oid[0])
+			ogengine_start_quest_then_set_active_objective(qid, oid);
+		g_odoom_quest_tracker_needs_refresh = true;
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_start_then_track_do_it, 0);
 	}
 
 	/* Quest: set active from popup first (ZScript set odoom_quest_set_active_id + odoom_quest_set_active_do_it=1 last frame). Process before key capture so we don't miss the one-frame edge. */
-	{
-		FBaseCVar* setActiveDoVar = FindCVar("odoom_quest_set_active_do_it", nullptr);
-		FBaseCVar* setActiveIdVar = FindCVar("odoom_quest_set_active_id", nullptr);
-		if (g_star_initialized && setActiveDoVar && setActiveDoVar->GetRealType() == CVAR_Int && setActiveDoVar->GetGenericRep(CVAR_Int).Int != 0) {
-			const char* questId = nullptr;
-			if (setActiveIdVar && setActiveIdVar->GetRealType() == CVAR_String)
-				questId = setActiveIdVar->GetGenericRep(CVAR_String).String;
-			if (questId && questId[0]) {
-				ogengine_start_quest(questId);
-				/* Do not refresh here: C# client updates cache when StartQuestAsync completes (UpdateQuestStatusInCache). Next 60-frame refresh or cache read will show updated list (like Quake). */
-			}
-			UCVarValue zero; zero.Int = 0;
-			setActiveDoVar->SetGenericRep(zero, CVAR_Int);
-			if (setActiveIdVar && setActiveIdVar->GetRealType() == CVAR_String) {
-				UCVarValue empty; empty.String = (char*)"";
-				setActiveIdVar->SetGenericRep(empty, CVAR_String);
-			}
+	if (g_star_initialized && ODOOM_GetCVar(g_odoom_cv.odoom_quest_set_active_do_it, 0) != 0) {
+		const char* questId = ODOOM_GetCVar(g_odoom_cv.odoom_quest_set_active_id);
+		if (questId[0]) {
+			ogengine_start_quest(questId);
+			/* Do not refresh here: C# client updates cache when StartQuestAsync completes (UpdateQuestStatusInCache). Next 60-frame refresh or cache read will show updated list (like Quake). */
 		}
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_set_active_do_it, 0);
+		ODOOM_SetCVar(g_odoom_cv.odoom_quest_set_active_id, "");
 	}
 
-	FBaseCVar* openVar = FindCVar("odoom_inventory_open", nullptr);
-	FBaseCVar* questPopupVar = FindCVar("odoom_quest_popup_open", nullptr);
-	const bool open = (openVar && openVar->GetRealType() == CVAR_Int && openVar->GetGenericRep(CVAR_Int).Int != 0);
-	const bool questPopupOpen = (questPopupVar && questPopupVar->GetRealType() == CVAR_Int && questPopupVar->GetGenericRep(CVAR_Int).Int != 0);
+	const bool open = ODOOM_GetCVar(g_odoom_cv.odoom_inventory_open, 0) != 0;
+	const bool questPopupOpen = ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0) != 0;
 	const bool anyPopupOpen = open || questPopupOpen;
 
 	/* Refresh overlay from client every frame while open (merge is in-memory, so pickups show immediately). When not beamed in we push empty. */
 	if (open) {
 		ODOOM_RefreshOverlayFromClient();
+		ODOOM_PushInventoryWindowToCVars();  /* follow scroll/tab without waiting for the next list */
 		/* Use STAR item from inventory (E on selected STAR row): ZScript set odoom_star_use_do_it=1, name and type. */
-		if (!ogengine_sync_use_item_in_progress()) {
-			FBaseCVar* doCv = FindCVar("odoom_star_use_do_it", nullptr);
-			if (doCv && doCv->GetRealType() == CVAR_Int && doCv->GetGenericRep(CVAR_Int).Int != 0) {
-				FBaseCVar* nameCv = FindCVar("odoom_star_use_item_name", nullptr);
-				FBaseCVar* typeCv = FindCVar("odoom_star_use_item_type", nullptr);
-				FBaseCVar* descCv = FindCVar("odoom_star_use_item_description", nullptr);
-				const char* nameStr = (nameCv && nameCv->GetRealType() == CVAR_String) ? nameCv->GetGenericRep(CVAR_String).String : "";
-				const char* typeStr = (typeCv && typeCv->GetRealType() == CVAR_String) ? typeCv->GetGenericRep(CVAR_String).String : "Item";
-				const char* descStr = (descCv && descCv->GetRealType() == CVAR_String) ? descCv->GetGenericRep(CVAR_String).String : "";
+		if (ODOOM_CanStartUseItem()) {
+			if (ODOOM_GetCVar(g_odoom_cv.odoom_star_use_do_it, 0) != 0) {
+				const char* nameStr = ODOOM_GetCVar(g_odoom_cv.odoom_star_use_item_name);
+				const char* typeStr = g_odoom_cv.odoom_star_use_item_type ? ODOOM_GetCVar(g_odoom_cv.odoom_star_use_item_type) : "Item";
+				const char* descStr = ODOOM_GetCVar(g_odoom_cv.odoom_star_use_item_description);
 				if (nameStr && nameStr[0]) {
 					std::string nameS(nameStr);
 					std::string typeS(typeStr ? typeStr : "");
@@ -2602,29 +3015,13 @@ void ODOOM_InventoryInputCaptureFrame(void)
 					if (ODOOM_WouldUseExceedMax(nameS, typeS, &blockMsg, descStr && descStr[0] ? descStr : nullptr)) {
 						if (blockMsg) {
 							/* Show only in toast once; don't reset if already showing (avoids spam). */
-							FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames", nullptr);
-							int showFrames = (toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) ? toastFramesCv->GetGenericRep(CVAR_Int).Int : 0;
-							if (showFrames <= 0) {
-								FBaseCVar* toastMsgCv = FindCVar("odoom_star_toast_message", nullptr);
-								if (toastMsgCv && toastMsgCv->GetRealType() == CVAR_String) {
-									UCVarValue val; val.String = (char*)blockMsg;
-									toastMsgCv->SetGenericRep(val, CVAR_String);
-								}
-								if (toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
-									UCVarValue v; v.Int = 105; /* 3 sec at 35 fps */
-									toastFramesCv->SetGenericRep(v, CVAR_Int);
-								}
-							}
+							if (ODOOM_GetCVar(g_odoom_cv.odoom_star_toast_frames, 0) <= 0)
+								ODOOM_ShowToast(blockMsg, 105); /* 3 sec at 35 fps */
 						}
-						UCVarValue u; u.Int = 0;
-						doCv->SetGenericRep(u, CVAR_Int);
+						ODOOM_SetCVar(g_odoom_cv.odoom_star_use_do_it, 0);
 					} else {
-						g_star_use_pending_name = nameStr;
-						g_star_use_pending_type = typeStr ? typeStr : "";
-						g_star_use_pending_description = (descStr && descStr[0]) ? descStr : "";
-						ogengine_sync_use_item_start(nameStr, "odoom_use", ODOOM_OnUseItemFromInventoryDone, nullptr);
-						UCVarValue u; u.Int = 0;
-						doCv->SetGenericRep(u, CVAR_Int);
+						ODOOM_StartUseFromInventory(nameStr, typeStr ? typeStr : "", (descStr && descStr[0]) ? descStr : "", "odoom_use");
+						ODOOM_SetCVar(g_odoom_cv.odoom_star_use_do_it, 0);
 					}
 				}
 			}
@@ -2768,8 +3165,7 @@ void ODOOM_InventoryInputCaptureFrame(void)
 			static int s_odoom_hud_z_raw_was_down = 0;
 			if (g_star_initialized)
 			{
-				FBaseCVar* questPopupHudVar = FindCVar("odoom_quest_popup_open", nullptr);
-				int questHudPopupOpen = (questPopupHudVar && questPopupHudVar->GetRealType() == CVAR_Int && questPopupHudVar->GetGenericRep(CVAR_Int).Int != 0);
+				const bool questHudPopupOpen = ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0) != 0;
 				if (x && !s_odoom_hud_x_raw_was_down)
 					ODOOM_FlipHudIntCVar("odoom_hud_show_xp");
 				/* B toggles Not Started filter while quest list is open (ZScript); do not flip beamed HUD there. */
@@ -2787,19 +3183,14 @@ void ODOOM_InventoryInputCaptureFrame(void)
 			static int s_key_k_was_down = 0;
 			if (g_star_initialized && keyK)
 			{
-				FBaseCVar* questPopupVar = FindCVar("odoom_quest_popup_open", nullptr);
-				int qOpen = (questPopupVar && questPopupVar->GetRealType() == CVAR_Int && questPopupVar->GetGenericRep(CVAR_Int).Int != 0);
+				const bool qOpen = ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0) != 0;
 				if (!s_key_k_was_down && qOpen)
 				{
-					FBaseCVar* selIdVar = FindCVar("odoom_quest_selected_id", nullptr);
-					if (selIdVar && selIdVar->GetRealType() == CVAR_String)
+					const char* id = ODOOM_GetCVar(g_odoom_cv.odoom_quest_selected_id);
+					if (id[0])
 					{
-						const char* id = selIdVar->GetGenericRep(CVAR_String).String;
-						if (id && id[0])
-						{
-							ogengine_start_quest(id);
-							ODOOM_RefreshQuestCVars();
-						}
+						ogengine_start_quest(id);
+						ODOOM_RefreshQuestCVars();
 					}
 				}
 				s_key_k_was_down = 1;
@@ -2810,15 +3201,14 @@ void ODOOM_InventoryInputCaptureFrame(void)
 		/* Quest popup is driven by ZScript only (same as inventory I key): ZScript reads odoom_key_q and toggles; C++ does not set odoom_quest_popup_open. */
 	}
 
-	/* Quest: cache invalidation callback; detail CVars every frame while popup open. Main list odoom_quest_list is refreshed every frame while popup open (see above). */
+	/* Quest: cache invalidation callback; detail CVars every frame while popup open. Main list (OdoomStarData quest rows) is refreshed every frame while popup open (see above). */
 	if (g_star_initialized) {
 		if (g_odoom_quests_cache_refresh_pending) {
 			g_odoom_quests_cache_refresh_pending = false;
 			ODOOM_RefreshQuestCVars();
 			ODOOM_RefreshQuestDetailCVars();
 		}
-		FBaseCVar* questPopupVar = FindCVar("odoom_quest_popup_open", nullptr);
-		int questPopupOpen = (questPopupVar && questPopupVar->GetRealType() == CVAR_Int) ? questPopupVar->GetGenericRep(CVAR_Int).Int : 0;
+		const int questPopupOpen = ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0);
 		static int s_quest_popup_was_open = 0;
 		if (questPopupOpen && !s_quest_popup_was_open) {
 #ifdef ODOOM_OGENGINE_HAS_REFRESH_QUEST_BACKGROUND
@@ -2833,42 +3223,29 @@ void ODOOM_InventoryInputCaptureFrame(void)
 			/* Tracker HUD: when popup is closed, set tracker from API if we have active quest (e.g. after restore session) or replace "..." placeholder when profile loads. */
 			/* Deferred "Loading..." for autobeam-in: set placeholder/title here so we never touch CVars during init. */
 			if (g_odoom_pending_loading_tracker && g_star_initialized) {
-				static const char s_loading_placeholder[] = "...";
-				FBaseCVar* tidVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-				FBaseCVar* titleVar = FindCVar("odoom_quest_tracker_title", nullptr);
-				if (tidVar && tidVar->GetRealType() == CVAR_String && titleVar && titleVar->GetRealType() == CVAR_String) {
-					UCVarValue u; u.String = (char*)s_loading_placeholder;
-					tidVar->SetGenericRep(u, CVAR_String);
-					UCVarValue t; t.String = (char*)"Loading...";
-					titleVar->SetGenericRep(t, CVAR_String);
+				if (g_odoom_cv.odoom_quest_tracker_quest_id && g_odoom_cv.odoom_quest_tracker_title) {
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, "...");
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "Loading...");
 				}
 				g_odoom_pending_loading_tracker = false;
 			}
 			/* When client invoked ProfileLoaded (restore or refresh done), fill tracker from cache on next frame (audit: no timing dependency on polling). */
 			if (g_odoom_profile_loaded_pending) {
 				g_odoom_profile_loaded_pending = false;
-				FBaseCVar* tidVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-				FBaseCVar* titleVar = FindCVar("odoom_quest_tracker_title", nullptr);
+				const bool beaminPrefetched = g_odoom_beamin_prefetched;
+				g_odoom_beamin_prefetched = false;
 				char qid[64] = {};
 				char oid[64] = {};
 				if (ogengine_get_active_quest_id(qid, sizeof(qid)) && qid[0]) {
-					if (tidVar && tidVar->GetRealType() == CVAR_String) {
-						UCVarValue u; u.String = qid;
-						tidVar->SetGenericRep(u, CVAR_String);
-					}
-					if (titleVar && titleVar->GetRealType() == CVAR_String) {
-						UCVarValue t; t.String = (char*)"Loading...";
-						titleVar->SetGenericRep(t, CVAR_String);
-					}
-					if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0]) {
-						FBaseCVar* oidVar = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
-						if (oidVar && oidVar->GetRealType() == CVAR_String) {
-							UCVarValue u; u.String = oid;
-							oidVar->SetGenericRep(u, CVAR_String);
-						}
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, qid);
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "Loading...");
+					if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0])
+						ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id, oid);
+					/* After beam-in these were already requested alongside the profile (oglib_beamin_prefetch). */
+					if (!beaminPrefetched) {
+						ogengine_refresh_quest_cache_in_background();
+						ogengine_request_inventory_in_background();  /* non-blocking: cache ready for overlay/door checks */
 					}
-					ogengine_refresh_quest_cache_in_background();
-					ogengine_request_inventory_in_background();  /* non-blocking: cache ready for overlay/door checks */
 					ODOOM_RefreshQuestCVars();
 				}
 			}
@@ -2881,30 +3258,17 @@ void ODOOM_InventoryInputCaptureFrame(void)
 					ogengine_free_item_list(inv_list);
 				}
 			}
-			FBaseCVar* trackerIdVar = FindCVar("odoom_quest_tracker_quest_id", nullptr);
-			const char* trackerId = (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) ? trackerIdVar->GetGenericRep(CVAR_String).String : nullptr;
+			const char* trackerId = g_odoom_cv.odoom_quest_tracker_quest_id ? ODOOM_GetCVar(g_odoom_cv.odoom_quest_tracker_quest_id) : nullptr;
 			bool trackerIsPlaceholder = (trackerId && std::strcmp(trackerId, "...") == 0);
 			if (!trackerId || !trackerId[0] || trackerIsPlaceholder) {
 				char qid[64] = {};
 				char oid[64] = {};
 				if (ogengine_get_active_quest_id(qid, sizeof(qid)) && qid[0]) {
-					if (trackerIdVar && trackerIdVar->GetRealType() == CVAR_String) {
-						UCVarValue u; u.String = qid;
-						trackerIdVar->SetGenericRep(u, CVAR_String);
-					}
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_quest_id, qid);
 					/* Show "Loading..." until RefreshQuestCVars fills real title (like Quake). */
-					FBaseCVar* titleVar = FindCVar("odoom_quest_tracker_title", nullptr);
-					if (titleVar && titleVar->GetRealType() == CVAR_String) {
-						UCVarValue t; t.String = (char*)"Loading...";
-						titleVar->SetGenericRep(t, CVAR_String);
-					}
-					if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0]) {
-						FBaseCVar* oidVar = FindCVar("odoom_quest_tracker_active_objective_id", nullptr);
-						if (oidVar && oidVar->GetRealType() == CVAR_String) {
-							UCVarValue u; u.String = oid;
-							oidVar->SetGenericRep(u, CVAR_String);
-						}
-					}
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "Loading...");
+					if (ogengine_get_active_objective_id(oid, sizeof(oid)) && oid[0])
+						ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_active_objective_id, oid);
 					/* Do not call ogengine_refresh_quest_cache_in_background here: that forces RequestQuestCacheRefreshInBackground
 					 * (full GET all-for-avatar) every time this block runs. If the tracker CVar stayed empty/placeholder for
 					 * multiple frames (ordering, ZScript), that spammed quest reload during play. Cold cache is filled via
@@ -2912,16 +3276,8 @@ void ODOOM_InventoryInputCaptureFrame(void)
 					ODOOM_RefreshQuestCVars();
 				} else {
 					/* No active quest: don't leave tracker stuck on "Loading...". */
-					FBaseCVar* titleVar = FindCVar("odoom_quest_tracker_title", nullptr);
-					if (titleVar && titleVar->GetRealType() == CVAR_String) {
-						UCVarValue t; t.String = (char*)"No Active Quest Found";
-						titleVar->SetGenericRep(t, CVAR_String);
-					}
-					FBaseCVar* objLinesVar = FindCVar("odoom_quest_tracker_objectives", nullptr);
-					if (objLinesVar && objLinesVar->GetRealType() == CVAR_String) {
-						UCVarValue o; o.String = (char*)"";
-						objLinesVar->SetGenericRep(o, CVAR_String);
-					}
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_title, "No Active Quest Found");
+					ODOOM_SetCVar(g_odoom_cv.odoom_quest_tracker_objectives, "");
 				}
 			} else {
 				/* Tracker id already set: full quest list refresh periodically for title sync; progress lines every frame from cache (real-time kill counts after client merge). */
@@ -2940,11 +3296,8 @@ void ODOOM_InventoryInputCaptureFrame(void)
 	}
 
 	/* Send popup: text input buffer (OQuake-style) and execute send when ZScript requests */
-	FBaseCVar* sendOpenVar = FindCVar("odoom_send_popup_open", nullptr);
 	/* Capture typed name only while send popup is open. */
-	bool sendOpen = false;
-	if (sendOpenVar && sendOpenVar->GetRealType() == CVAR_Int)
-		sendOpen = (sendOpenVar->GetGenericRep(CVAR_Int).Int != 0);
+	const bool sendOpen = ODOOM_GetCVar(g_odoom_cv.odoom_send_popup_open, 0) != 0;
 	if (sendOpen && !g_odoom_send_popup_was_open)
 	{
 		g_odoom_send_input_buffer.clear();
@@ -2962,24 +3315,16 @@ void ODOOM_InventoryInputCaptureFrame(void)
 	}
 
 	/* Send status for ZScript: "Sending...", "Item sent.", or "Send failed: ...". Clear when popup closed. */
-	FBaseCVar* statusVar = FindCVar("odoom_send_status", nullptr);
-	if (statusVar && statusVar->GetRealType() == CVAR_String) {
-		static char s_send_status_buf[384];
+	if (g_odoom_cv.odoom_send_status) {
 		if (!sendOpen) {
-			s_send_status_buf[0] = '\0';
-			UCVarValue val; val.String = s_send_status_buf;
-			statusVar->SetGenericRep(val, CVAR_String);
+			ODOOM_SetCVar(g_odoom_cv.odoom_send_status, "");
 		} else {
 			/* Run pump again so send callback is processed as soon as the background thread finishes (keeps UI responsive). */
 			if (ogengine_sync_send_item_in_progress())
 				ogengine_sync_pump();
 		}
-		if (sendOpen && ogengine_sync_send_item_in_progress()) {
-			std::strncpy(s_send_status_buf, "Sending...", sizeof(s_send_status_buf) - 1);
-			s_send_status_buf[sizeof(s_send_status_buf) - 1] = '\0';
-			UCVarValue val; val.String = s_send_status_buf;
-			statusVar->SetGenericRep(val, CVAR_String);
-		}
+		if (sendOpen && ogengine_sync_send_item_in_progress())
+			ODOOM_SetCVar(g_odoom_cv.odoom_send_status, "Sending...");
 	}
 
 	if (sendOpen)
@@ -3060,39 +3405,26 @@ void ODOOM_InventoryInputCaptureFrame(void)
 		}
 #endif
 		/* ZScript reads this and appends to its display string (string CVar may not work in all builds) */
-		FBaseCVar* lastCharVar = FindCVar("odoom_send_last_char", nullptr);
-		if (lastCharVar && lastCharVar->GetRealType() == CVAR_Int)
-		{
-			UCVarValue u; u.Int = lastChar;
-			lastCharVar->SetGenericRep(u, CVAR_Int);
-		}
+		ODOOM_SetCVar(g_odoom_cv.odoom_send_last_char, lastChar);
 		/* Also write full line to string CVar for display/send */
-		FBaseCVar* lineVar = FindCVar("odoom_send_input_line", nullptr);
-		if (lineVar && lineVar->GetRealType() == CVAR_String)
+		if (g_odoom_cv.odoom_send_input_line)
 		{
 			static char s_send_line_buf[ODOOM_SEND_INPUT_MAX + 1];
 			size_t len = g_odoom_send_input_buffer.size();
 			if (len > (size_t)ODOOM_SEND_INPUT_MAX) len = (size_t)ODOOM_SEND_INPUT_MAX;
 			std::memcpy(s_send_line_buf, g_odoom_send_input_buffer.c_str(), len);
 			s_send_line_buf[len] = '\0';
-			UCVarValue val;
-			val.String = s_send_line_buf;
-			lineVar->SetGenericRep(val, CVAR_String);
+			ODOOM_SetCVar(g_odoom_cv.odoom_send_input_line, s_send_line_buf);
 		}
 	}
 
 	/* Execute send when ZScript set odoom_send_do_it=1 */
-	FBaseCVar* doItVar = FindCVar("odoom_send_do_it", nullptr);
-	if (doItVar && doItVar->GetRealType() == CVAR_Int && doItVar->GetGenericRep(CVAR_Int).Int != 0)
+	if (ODOOM_GetCVar(g_odoom_cv.odoom_send_do_it, 0) != 0)
 	{
-		FBaseCVar* targetVar = FindCVar("odoom_send_target", nullptr);
-		FBaseCVar* classVar = FindCVar("odoom_send_item_class", nullptr);
-		FBaseCVar* qtyVar = FindCVar("odoom_send_quantity", nullptr);
-		FBaseCVar* toClanVar = FindCVar("odoom_send_to_clan", nullptr);
-		const char* target = (targetVar && targetVar->GetRealType() == CVAR_String) ? targetVar->GetGenericRep(CVAR_String).String : "";
-		const char* itemClass = (classVar && classVar->GetRealType() == CVAR_String) ? classVar->GetGenericRep(CVAR_String).String : "";
-		int qty = (qtyVar && qtyVar->GetRealType() == CVAR_Int) ? qtyVar->GetGenericRep(CVAR_Int).Int : 1;
-		int toClan = (toClanVar && toClanVar->GetRealType() == CVAR_Int) ? toClanVar->GetGenericRep(CVAR_Int).Int : 0;
+		const char* target = ODOOM_GetCVar(g_odoom_cv.odoom_send_target);
+		const char* itemClass = ODOOM_GetCVar(g_odoom_cv.odoom_send_item_class);
+		int qty = ODOOM_GetCVar(g_odoom_cv.odoom_send_quantity, 1);
+		int toClan = ODOOM_GetCVar(g_odoom_cv.odoom_send_to_clan, 0);
 		if (qty < 1) qty = 1;
 		if (target && target[0] && itemClass && itemClass[0])
 		{
@@ -3102,7 +3434,7 @@ void ODOOM_InventoryInputCaptureFrame(void)
 				/* STAR item send: use star_sync (background thread + callback via pump, same as Quake). */
 				if (StarInitialized())
 				{
-					if (ogengine_sync_send_item_in_progress())
+					if (!ODOOM_CanStartSendItem())
 						Printf("Send already in progress; try again shortly.\n");
 					else
 					{
@@ -3110,12 +3442,7 @@ void ODOOM_InventoryInputCaptureFrame(void)
 						g_odoom_last_sent_qty = qty;
 						ogengine_sync_send_item_start(target, starItemName, qty, toClan ? 1 : 0, nullptr, ODOOM_OnSendItemDone, nullptr);
 						/* Show "Sending..." in popup; keep popup open until callback sets result (ZScript shows status). */
-						FBaseCVar* sv = FindCVar("odoom_send_status", nullptr);
-						if (sv && sv->GetRealType() == CVAR_String) {
-							static const char sending[] = "Sending...";
-							UCVarValue val; val.String = (char*)sending;
-							sv->SetGenericRep(val, CVAR_String);
-						}
+						ODOOM_SetCVar(g_odoom_cv.odoom_send_status, "Sending...");
 					}
 				}
 				else
@@ -3130,62 +3457,72 @@ void ODOOM_InventoryInputCaptureFrame(void)
 					Printf("Send to avatar: \"%s\" item \"%s\" x%d (local send not yet implemented).\n", target, itemClass, qty);
 			}
 		}
-		{ UCVarValue u; u.Int = 0; doItVar->SetGenericRep(u, CVAR_Int); }
+		ODOOM_SetCVar(g_odoom_cv.odoom_send_do_it, 0);
 		/* Do not close send popup here; ZScript keeps it open and shows Sending.../result, then user closes. */
 		g_odoom_send_popup_was_open = false;
 	}
 }
 
-/** Re-apply stored health/armor to the console player. Called from PostTic (once per frame) and PostOneTic (every tic) so engine overwrites don't stick. */
-static void ODOOM_ReapplyStoredHealthArmor(void) {
+/** Called after every game tic (inside TryRunTics loop, between P_UnPredictPlayer and P_PredictPlayer).
+ *  The one place STAR health/armor is written: a deferred use-item apply or an optimistic-use take-back lands here
+ *  once, on the authoritative player, so nothing needs re-applying afterwards. */
+void ODOOM_PostOneTic(void) {
+	if (g_star_deferred_apply_count <= 0
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+		&& g_star_deferred_rollback_health <= 0 && g_star_deferred_rollback_armor <= 0
+#endif
+		)
+		return;
 	FLevelLocals* level = primaryLevel;
 	player_t* player = level ? level->GetConsolePlayer() : nullptr;
-	if (!player || !player->mo || (!g_star_deferred_apply_health && !g_star_deferred_apply_armor)) return;
-	if (g_star_deferred_apply_health && g_star_deferred_health_value >= 0) {
-		player->health = g_star_deferred_health_value;
-		player->mo->health = g_star_deferred_health_value;
-	}
-	if (g_star_deferred_apply_armor && g_star_deferred_armor_value >= 0) {
+	if (!player || !player->mo)
+		return;  /* no player this tic (level change): keep it for the next one */
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+	if (g_star_deferred_rollback_health > 0) {
+		int h = player->mo->health - g_star_deferred_rollback_health;
+		if (h < 1) h = 1;
+		player->mo->health = h;
+		player->health = h;
+	}
+	if (g_star_deferred_rollback_armor > 0) {
 		AActor* arm = player->mo->FindInventory(FName("BasicArmor"), true);
-		if (arm)
-			arm->IntVar(FName("Amount")) = g_star_deferred_armor_value;
+		if (arm) {
+			int& a = arm->IntVar(FName("Amount"));
+			a = (a > g_star_deferred_rollback_armor) ? a - g_star_deferred_rollback_armor : 0;
+		}
 	}
+	g_star_deferred_rollback_health = g_star_deferred_rollback_armor = 0;
+#endif
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+	for (ODOOM_PendingUse& use : g_odoom_optimistic_uses) {
+		if (!use.apply_pending) continue;
+		if (!player->mo) break;  /* the rest stay pending for the next tic */
+		use.apply_pending = false;
+		g_star_deferred_apply_count--;
+		const int health0 = player->mo->health;
+		const int armor0 = ODOOM_ConsolePlayerArmor(player);
+		ODOOM_ApplyDeferredUse(use);
+		if (!player->mo) continue;
+		/* Remember what this use added so a rejection can take it back. */
+		use.health_gain = player->mo->health - health0;
+		use.armor_gain = ODOOM_ConsolePlayerArmor(player) - armor0;
+	}
+#else
+	for (const ODOOM_PendingUse& use : g_star_deferred_applies)
+		ODOOM_ApplyDeferredUse(use);
+	g_star_deferred_applies.clear();
+	g_star_deferred_apply_count = 0;
+#endif
+	g_star_deferred_apply_landed = true;
 }
 
-/** Called after every game tic (inside TryRunTics loop). Re-applies stored health/armor so whatever overwrites it during the tic is corrected before the next tic. */
-void ODOOM_PostOneTic(void) {
-	if (g_star_deferred_apply_frames <= 0 || g_star_deferred_apply_frames >= 35) return;
-	ODOOM_ReapplyStoredHealthArmor();
-}
-
-/** Called after TryRunTics so health/armor apply runs after the tic. First frame applies via engine; then we re-apply for ~1 s (PostOneTic does per-tic re-apply). */
+/** Called after TryRunTics: refresh the overlay once a deferred apply has landed in one of this frame's tics. */
 void ODOOM_PostTic(void)
 {
-	if (g_star_deferred_apply_frames <= 0)
+	if (!g_star_deferred_apply_landed)
 		return;
-	FLevelLocals* level = primaryLevel;
-	player_t* player = level ? level->GetConsolePlayer() : nullptr;
-	if (g_star_deferred_apply_frames >= 34 && !g_star_deferred_apply_name.empty()) {
-		/* First frame: apply via engine and store target values. (+X) from description when present. */
-		const char* desc = g_star_deferred_apply_description.empty() ? nullptr : g_star_deferred_apply_description.c_str();
-		ODOOM_ApplyHealthOrArmor(g_star_deferred_apply_name, g_star_deferred_apply_type, desc);
-		g_star_deferred_apply_frames = 33; /* 33 more frames; PostOneTic re-applies every tic within each frame */
-	} else if (player && player->mo && (g_star_deferred_apply_health || g_star_deferred_apply_armor)) {
-		ODOOM_ReapplyStoredHealthArmor();
-		g_star_deferred_apply_frames--;
-	} else {
-		g_star_deferred_apply_frames = 0;
-	}
-	if (g_star_deferred_apply_frames <= 0) {
-		g_star_deferred_apply_name.clear();
-		g_star_deferred_apply_type.clear();
-		g_star_deferred_apply_description.clear();
-		g_star_deferred_health_value = -1;
-		g_star_deferred_armor_value = -1;
-		g_star_deferred_apply_health = false;
-		g_star_deferred_apply_armor = false;
-		ODOOM_RefreshOverlayFromClient();
-	}
+	g_star_deferred_apply_landed = false;
+	ODOOM_RefreshOverlayFromClient();
 }
 
 /** Called from engine input code when building ticcmd: set key state CVars for ZScript. */
@@ -3214,36 +3551,34 @@ static void ODOOM_FlipHudIntCVarImpl(const char* cvarName)
 
 void ODOOM_InventorySetKeyState(int up, int down, int left, int right, int use, int a, int c, int z, int x, int i, int o, int p, int keyS, int keyT, int q, int enter, int pgup, int pgdown, int home, int endkey, int keyB, int keyN, int keyM, int keyK, int keyV, int keyD, int backspace)
 {
-	UCVarValue val;
-	FBaseCVar* v;
-#define SET_KEY_CVAR(name, vint) do { val.Int = (vint); v = FindCVar(name, nullptr); if (v && v->GetRealType() == CVAR_Int) v->SetGenericRep(val, CVAR_Int); } while(0)
-	SET_KEY_CVAR("odoom_key_up", up);
-	SET_KEY_CVAR("odoom_key_down", down);
-	SET_KEY_CVAR("odoom_key_left", left);
-	SET_KEY_CVAR("odoom_key_right", right);
-	SET_KEY_CVAR("odoom_key_pgup", pgup);
-	SET_KEY_CVAR("odoom_key_pgdown", pgdown);
-	SET_KEY_CVAR("odoom_key_home", home);
-	SET_KEY_CVAR("odoom_key_end", endkey);
-	SET_KEY_CVAR("odoom_key_b", keyB);
-	SET_KEY_CVAR("odoom_key_n", keyN);
-	SET_KEY_CVAR("odoom_key_m", keyM);
-	SET_KEY_CVAR("odoom_key_v", keyV);
-	SET_KEY_CVAR("odoom_key_use", use);
-	SET_KEY_CVAR("odoom_key_a", a);
-	SET_KEY_CVAR("odoom_key_c", c);
-	SET_KEY_CVAR("odoom_key_z", z);
-	SET_KEY_CVAR("odoom_key_x", x);
-	SET_KEY_CVAR("odoom_key_i", i);
-	SET_KEY_CVAR("odoom_key_o", o);
-	SET_KEY_CVAR("odoom_key_p", p);
-	SET_KEY_CVAR("odoom_key_s", keyS);
-	SET_KEY_CVAR("odoom_key_t", keyT);
-	SET_KEY_CVAR("odoom_key_q", q);
-	SET_KEY_CVAR("odoom_key_enter", enter);
-	SET_KEY_CVAR("odoom_key_k", keyK);
-	SET_KEY_CVAR("odoom_key_d", keyD);
-	SET_KEY_CVAR("odoom_key_backspace", backspace);
+#define SET_KEY_CVAR(name, vint) ODOOM_SetCVar(g_odoom_cv.name, (vint))
+	SET_KEY_CVAR(odoom_key_up, up);
+	SET_KEY_CVAR(odoom_key_down, down);
+	SET_KEY_CVAR(odoom_key_left, left);
+	SET_KEY_CVAR(odoom_key_right, right);
+	SET_KEY_CVAR(odoom_key_pgup, pgup);
+	SET_KEY_CVAR(odoom_key_pgdown, pgdown);
+	SET_KEY_CVAR(odoom_key_home, home);
+	SET_KEY_CVAR(odoom_key_end, endkey);
+	SET_KEY_CVAR(odoom_key_b, keyB);
+	SET_KEY_CVAR(odoom_key_n, keyN);
+	SET_KEY_CVAR(odoom_key_m, keyM);
+	SET_KEY_CVAR(odoom_key_v, keyV);
+	SET_KEY_CVAR(odoom_key_use, use);
+	SET_KEY_CVAR(odoom_key_a, a);
+	SET_KEY_CVAR(odoom_key_c, c);
+	SET_KEY_CVAR(odoom_key_z, z);
+	SET_KEY_CVAR(odoom_key_x, x);
+	SET_KEY_CVAR(odoom_key_i, i);
+	SET_KEY_CVAR(odoom_key_o, o);
+	SET_KEY_CVAR(odoom_key_p, p);
+	SET_KEY_CVAR(odoom_key_s, keyS);
+	SET_KEY_CVAR(odoom_key_t, keyT);
+	SET_KEY_CVAR(odoom_key_q, q);
+	SET_KEY_CVAR(odoom_key_enter, enter);
+	SET_KEY_CVAR(odoom_key_k, keyK);
+	SET_KEY_CVAR(odoom_key_d, keyD);
+	SET_KEY_CVAR(odoom_key_backspace, backspace);
 #undef SET_KEY_CVAR
 	/* B/X/Z: unbound for engine; raw odoom_key_* for ZScript; ZScript toggles odoom_hud_show_* when no STAR popup. */
 }
@@ -3464,6 +3799,19 @@ static void RefreshStarCliOverridesFromExeArgs(void) {
 	if (v) g_star_override_avatar_id = v;
 }
 
+/** Flusher-thread side of the async log: forwards each line to star_api.log. */
+static void ODOOM_AsyncLogLine(oglib_log_level_t level, const char* msg, void* user) {
+	(void)level;
+	(void)user;
+	ogengine_log_to_file(msg);
+}
+
+/** Append to star_api.log without blocking the game thread (falls back to a direct write if the async log is not running or full). */
+static void ODOOM_LogToFile(const char* msg) {
+	if (!oglib_log_enqueue(OGLIB_LOG_INFO, msg))
+		ogengine_log_to_file(msg);
+}
+
 static void StarLogInfo(const char* fmt, ...) {
 	char msg[1024];
 	va_list args;
@@ -3475,7 +3823,7 @@ static void StarLogInfo(const char* fmt, ...) {
 	if (g_star_debug_logging) {
 		char buf[1100];
 		std::snprintf(buf, sizeof(buf), "STAR API: %s", msg);
-		ogengine_log_to_file(buf);
+		ODOOM_LogToFile(buf);
 	}
 }
 
@@ -3515,17 +3863,20 @@ static void StarLogError(const char* fmt, ...) {
 	{
 		char buf[1100];
 		std::snprintf(buf, sizeof(buf), "STAR API ERROR: %s", msg);
-		ogengine_log_to_file(buf);
+		ODOOM_LogToFile(buf);
 	}
 }
 
+/** Per-pickup trace (star debug only). Queued on the async log instead of printed to the console on the touch path. */
+#define ODOOM_PickupLog(...) do { if (g_star_debug_logging) OGLIB_LOGD("STAR API: Pickup detected: " __VA_ARGS__); } while (0)
+
 static void StarLogRuntimeAuthFailureOnce(const char* reason) {
 	if (g_star_logged_runtime_auth_failure) return;
 	g_star_logged_runtime_auth_failure = true;
 	/* Log to file only; avoid spamming console on every pickup/door when not authenticated. */
 	char buf[512];
 	std::snprintf(buf, sizeof(buf), "STAR API: Not authenticated. STAR sync disabled until beam-in succeeds. Reason: %s", reason ? reason : "(unknown)");
-	ogengine_log_to_file(buf);
+	ODOOM_LogToFile(buf);
 	if (g_star_debug_logging)
 		StarLogError("Not authenticated. STAR sync disabled until beam-in succeeds. Reason: %s", reason ? reason : "(unknown)");
 }
@@ -3631,6 +3982,7 @@ static bool StarTryInitializeAndAuthenticate(bool verbose) {
 		g_star_init_failed_this_session = false;
 		if (logVerbose) StarLogInfo("ogengine_init succeeded (interop DLL/API ready).");
 		ogengine_set_operation_callback(ODOOM_StarApiOperationCallback, nullptr);
+		g_odoom_beamin.done_cb = ODOOM_OnBeaminDone;
 		ogengine_set_quest_progress_cache_refresh(g_odoom_quest_progress_cache_refresh);
 	}
 	/* Always (re)apply WEB4 OASIS URL when set so auth/refresh use the correct host. Required for token refresh on restore (expired JWT). */
@@ -3662,7 +4014,11 @@ static bool StarTryInitializeAndAuthenticate(bool verbose) {
 			return false;
 		}
 		if (logVerbose) StarLogInfo("Beaming in... starting async SSO authentication.");
+#ifdef OGENGINE_SYNC_HAS_OP_HANDLES
+		g_star_auth_op = ogengine_sync_auth_start_op(username, password, g_star_config.timeout_seconds * 1000, ODOOM_OnAuthDone, nullptr);
+#else
 		ogengine_sync_auth_start(username, password, ODOOM_OnAuthDone, nullptr);
+#endif
 		g_star_async_auth_pending = true;
 		g_star_async_auth_pending_frames = 0;
 		g_star_beamin_timeout_was_shown = false;
@@ -3695,7 +4051,10 @@ static bool StarTryInitializeAndAuthenticate(bool verbose) {
 		if (result == OGENGINE_SUCCESS) {
 			if (g_odoom_saved_refresh_token[0])
 				ogengine_set_refresh_token(g_odoom_saved_refresh_token);
+			oglib_beamin_begin(&g_odoom_beamin, OGLIB_BEAMIN_STATE_RESTORING, g_odoom_saved_username);  /* before the request so its ProfileLoaded is not missed */
 			result = ogengine_restore_session();
+			if (result != OGENGINE_SUCCESS)
+				oglib_beamin_reset(&g_odoom_beamin);
 			if (result == OGENGINE_SUCCESS) {
 				g_star_initialized = true;
 				ODOOM_ResetCrossGameBeamTransferState();
@@ -3706,7 +4065,8 @@ static bool StarTryInitializeAndAuthenticate(bool verbose) {
 					g_star_effective_username = g_odoom_saved_username;
 				odoom_star_username = g_star_effective_username.empty() ? "Avatar" : g_star_effective_username.c_str();
 				StarApplyBeamFacePreference();
-				ogengine_refresh_avatar_profile();
+				oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+				g_odoom_beamin_prefetched = true;
 				g_odoom_pending_loading_tracker = true;  /* Frame pump will set "Loading..." when CVars are ready */
 				if (logVerbose) StarLogInfo("Restoring saved session for %s.", g_odoom_saved_username[0] ? g_odoom_saved_username : "(avatar)");
 				return true;
@@ -3733,92 +4093,19 @@ static const char* GetKeycardName(int keynum) {
 	}
 }
 
-/** Name variants that the API or other games might store. Used so door check and HUD find keys regardless of name format. */
-static const char* const* GetKeycardNameVariants(int keynum, int* outCount) {
-	static const char* red[] = { "Red Keycard", "red_keycard", "Red keycard", "Red Key Card", "Red Key" };
-	static const char* blue[] = { "Blue Keycard", "blue_keycard", "Blue keycard", "Blue Key Card", "Blue Key" };
-	static const char* yellow[] = { "Yellow Keycard", "yellow_keycard", "Yellow keycard", "Yellow Key Card", "Yellow Key" };
-	static const char* skull[] = { "Skull Key", "skull_key", "Skull key" };
-	switch (keynum) {
-		case 1: *outCount = 5; return red;
-		case 2: *outCount = 5; return blue;
-		case 3: *outCount = 5; return yellow;
-		case 4: *outCount = 3; return skull;
-		case 129: *outCount = 5; return red;    /* ZDoom extended lock 129 = red keycard */
-		case 130: *outCount = 5; return blue;    /* ZDoom extended lock 130 = blue keycard */
-		case 131: *outCount = 5; return yellow;  /* ZDoom extended lock 131 = yellow keycard */
-		default: *outCount = 0; return nullptr;
-	}
-}
-
-/** Substrings (lowercase) that must appear in item name for each key. Fallback when variant has_item fails (e.g. API name differs). */
-static bool KeyNameContainsKeycard(int keynum, const char* itemName) {
-	if (!itemName || !itemName[0]) return false;
-	std::string lower;
-	for (const char* p = itemName; *p; ++p) {
-		char c = *p;
-		lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c == '_' ? ' ' : c))));
-	}
-	auto has = [&lower](const char* sub) {
-		std::string s(sub);
-		for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-		return lower.find(s) != std::string::npos;
-	};
-	switch (keynum) {
-		case 1: case 129: return has("red") && (has("key") || has("keycard"));
-		case 2: case 130: return has("blue") && (has("key") || has("keycard"));
-		case 3: case 131: return has("yellow") && (has("key") || has("keycard"));
-		case 4: return has("skull") && has("key");
-		default: return false;
-	}
+/** Returns true if STAR inventory has this key (the bits from the last fetched list). If outName is non-null, set to the *actual* item name from the API list so use_item can find and consume it (C# matches by exact name). */
+static bool ODOOM_STAR_HasKeycard(int keynum, const char** outName) {
+	const int k = ODOOM_StarKeyForLock(keynum);
+	if (k < 0 || !(g_odoom_star_keys & (1u << k))) return false;
+	if (outName) *outName = g_odoom_star_key_name[k];
+	return true;
 }
 
-/** Returns true if STAR inventory has this key (any name variant). If outName is non-null, set to the *actual* item name from the API list so use_item can find and consume it (C# matches by exact name). */
-static bool ODOOM_STAR_HasKeycard(int keynum, const char** outName) {
-	const char* engineKeyName = (keynum > 4) ? P_GetKeyNameForLock(keynum) : nullptr;
-	ogengine_item_list_t* list = nullptr;
-	if (ogengine_get_inventory(&list) != OGENGINE_SUCCESS || !list || !list->items) {
-		/* No list: try variant names for has_item only (outName would be wrong for use_item). */
-		if (!outName) {
-			int n = 0;
-			const char* const* names = GetKeycardNameVariants(keynum, &n);
-			if (names && n > 0) {
-				for (int i = 0; i < n; i++) {
-					if (ogengine_has_item(names[i])) return true;
-				}
-			}
-		}
-		return false;
-	}
-	static char matched_name[256];
-	matched_name[0] = '\0';
-	bool found = false;
-	for (size_t i = 0; i < list->count; i++) {
-		const ogengine_item_t* it = &list->items[i];
-		if (KeyNameContainsKeycard(keynum, it->name)) {
-			std::strncpy(matched_name, it->name, sizeof(matched_name) - 1);
-			matched_name[sizeof(matched_name) - 1] = '\0';
-			found = true;
-			break;
-		}
-		/* Engine key name fallback: only accept if item name contains engine key string AND matches this door's key type (red/blue/yellow), so e.g. "Keycard" never matches blue for a red door. */
-		if (engineKeyName && it->name[0]) {
-			std::string lowerItem;
-			for (const char* p = it->name; *p; ++p)
-				lowerItem.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(*p == '_' ? ' ' : *p))));
-			std::string lowerKey(engineKeyName);
-			for (auto& c : lowerKey) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-			if (lowerItem.find(lowerKey) != std::string::npos && KeyNameContainsKeycard(keynum, it->name)) {
-				std::strncpy(matched_name, it->name, sizeof(matched_name) - 1);
-				matched_name[sizeof(matched_name) - 1] = '\0';
-				found = true;
-				break;
-			}
-		}
-	}
-	ogengine_free_item_list(list);
-	if (found && outName) *outName = matched_name;
-	return found;
+/** A door consumed one of key k: drop its bit when that was the last one, until the next list says otherwise. */
+static void ODOOM_ConsumeStarKey(int keynum) {
+	const int k = ODOOM_StarKeyForLock(keynum);
+	if (k >= 0 && --g_odoom_star_key_quantity[k] <= 0)
+		g_odoom_star_keys &= ~(1u << k);
 }
 
 static const char* GetKeycardDescription(int keynum) {
@@ -3832,7 +4119,19 @@ static const char* GetKeycardDescription(int keynum) {
 }
 
 void UZDoom_STAR_Init(void) {
+	{
+		oglib_log_async_config_t log_cfg = {};
+		log_cfg.echo_stderr = 0;  /* follows star debug once the config is loaded (frame pump) */
+		log_cfg.line_fn = ODOOM_AsyncLogLine;
+		oglib_log_async_start(&log_cfg);
+	}
+	oglib_trace_set_thread_name("main");
+	oglib_session_init(); /* resolve OGEngineClient exports once; logs any missing */
 	ogengine_sync_init();
+#ifdef OGENGINE_SYNC_HAS_TRACE_CB
+	ogengine_sync_set_trace_cb(oglib_trace_sync_hook, nullptr);
+#endif
+	ODOOM_BindCVars(nullptr);  /* cvarinfo CVars; any the engine has not created yet are retried on the first frame */
 	/* Load STAR options from oasisstar.json; always ensure file exists on disk (same policy as OQuake). */
 	{
 		std::string path;
@@ -3882,84 +4181,129 @@ void UZDoom_STAR_Init(void) {
 	Printf("\n");
 }
 
+/** What touching an actor of one class means for STAR. Built on the first touch of each class (class defaults and names
+ * never change at runtime) so later pickups cost one hash probe instead of FindActor calls and class-name scans. */
+struct ODOOM_PickupClass {
+	int pickup = 0;        /* 0 = not tracked; else a PreTouchSpecial return value (keynum, OGENGINE_PICKUP_*) */
+	std::string starName;  /* ToStarItemName */
+	std::string desc;
+	std::string type;      /* Item, Weapon, Ammo, Armor, Health, Powerup */
+	int amount = 1;
+};
+static std::unordered_map<const PClassActor*, ODOOM_PickupClass> g_odoom_pickup_classes;
+
+static ODOOM_PickupClass ODOOM_BuildPickupClass(PClassActor* actorClass) {
+	ODOOM_PickupClass pc;
+	// OQUAKE runtime key actors in ODOOM: report exact shared-key ids.
+	PClassActor* oqGoldKeyClass = PClass::FindActor("OQGoldKey");
+	PClassActor* oqSilverKeyClass = PClass::FindActor("OQSilverKey");
+	if (oqGoldKeyClass && actorClass->IsDescendantOf(oqGoldKeyClass)) {
+		pc.pickup = OGENGINE_PICKUP_OQUAKE_GOLD_KEY;
+		return pc;
+	}
+	if (oqSilverKeyClass && actorClass->IsDescendantOf(oqSilverKeyClass)) {
+		pc.pickup = OGENGINE_PICKUP_OQUAKE_SILVER_KEY;
+		return pc;
+	}
+
+	auto kt = PClass::FindActor(NAME_Key);
+	if (kt && actorClass->IsDescendantOf(kt)) {
+		AActor* def = GetDefaultByType(actorClass);
+		int keynum = def ? def->special1 : 0;
+		if (keynum >= 1 && keynum <= 4) pc.pickup = keynum;
+		return pc;
+	}
+
+	// Generic inventory sync path: health, armor, ammo, weapons.
+	auto invType = PClass::FindActor(NAME_Inventory);
+	if (!invType || !actorClass->IsDescendantOf(invType)) return pc;
+	const char* cls = actorClass->TypeName.GetChars();
+	const char* type = "Item";
+	auto weaponType = PClass::FindActor(NAME_Weapon);
+	auto ammoType = PClass::FindActor(NAME_Ammo);
+	const bool isWeapon = weaponType && actorClass->IsDescendantOf(weaponType);
+	if (isWeapon) type = "Weapon";
+	else if (ammoType && actorClass->IsDescendantOf(ammoType)) type = "Ammo";
+	else if (cls && (strstr(cls, "Armor") || strstr(cls, "armor"))) type = "Armor";
+	else if (cls && (strstr(cls, "Health") || strstr(cls, "health") || strstr(cls, "Medikit") || strstr(cls, "Stimpack"))) type = "Health";
+	if (cls && (strstr(cls, "SoulSphere") || strstr(cls, "Megasphere") || strstr(cls, "InvulnSphere")
+		|| strstr(cls, "RadSuit") || strstr(cls, "BlurSphere"))) {
+		type = "Powerup";
+	}
+
+	pc.starName = ToStarItemName(cls);
+	int hamt = GetHealthOrArmorAmount(cls);
+	if (cls && strstr(cls, "Megasphere")) {
+		pc.desc = "Megasphere pickup (+200 health, +200 armor)";
+	} else if (hamt > 0) {
+		pc.desc = pc.starName + " (+" + std::to_string(hamt) + ")";  /* 1 qty like OQUAKE; (+X) in description */
+	} else {
+		pc.desc = std::string("Picked up ") + (cls ? cls : "Item");
+		int amt = GetHardcodedAmmoAmount(cls);
+		pc.amount = (amt > 0) ? amt : 1;
+	}
+	pc.type = type;
+	pc.pickup = isWeapon ? OGENGINE_PICKUP_WEAPON : OGENGINE_PICKUP_GENERIC_ITEM;
+	return pc;
+}
+
+static const ODOOM_PickupClass& ODOOM_ClassifyPickup(PClassActor* actorClass) {
+	auto it = g_odoom_pickup_classes.find(actorClass);
+	if (it == g_odoom_pickup_classes.end())
+		it = g_odoom_pickup_classes.emplace(actorClass, ODOOM_BuildPickupClass(actorClass)).first;
+	return it->second;
+}
+
 void UZDoom_STAR_Cleanup(void) {
+	g_odoom_pickup_classes.clear();
 	ODOOM_SaveStarConfigToFiles();
 	ODOOM_PushInventoryToCVars(nullptr);
+	/* Drain queued lines into star_api.log while the client can still take them; anything logged after this is a direct write. */
+	oglib_log_async_stop();
+	/* Boss mints first: a pool-submitted mint would otherwise keep ogengine_sync_cleanup from finding the pool idle. */
+	const bool mints_idle = ODOOM_WaitBossNftMints(ODOOM_BOSS_NFT_SHUTDOWN_GRACE_MS);
 	ogengine_sync_cleanup();
 	g_star_async_auth_pending = false;
-	if (g_star_client_ready) {
+	if (!mints_idle) {
+		StarLogInfo("Boss NFT mint still running after %d ms; leaving STAR API client up for process exit.", ODOOM_BOSS_NFT_SHUTDOWN_GRACE_MS);
+	} else if (g_star_client_ready) {
+		StarLogInfo("Cleaning up STAR API client.");
 		ogengine_cleanup();
 		g_star_client_ready = false;
 		g_star_initialized = false;
-		StarLogInfo("Cleaned up STAR API client.");
 	}
 }
 
 int UZDoom_STAR_PreTouchSpecial(struct AActor* special) {
 	if (!special) return 0;
+	OGLIB_TRACE_SCOPE("UZDoom_STAR_PreTouchSpecial", "odoom");
 	if (!StarTryInitializeAndAuthenticate(false)) {
 		StarLogRuntimeAuthFailureOnce(ogengine_get_last_error());
 		return 0;
 	}
 
-	// OQUAKE runtime key actors in ODOOM: report exact shared-key ids.
-	static PClassActor* oqGoldKeyClass = nullptr;
-	static PClassActor* oqSilverKeyClass = nullptr;
-	if (!oqGoldKeyClass) oqGoldKeyClass = PClass::FindActor("OQGoldKey");
-	if (!oqSilverKeyClass) oqSilverKeyClass = PClass::FindActor("OQSilverKey");
-	if (oqGoldKeyClass && special->IsKindOf(oqGoldKeyClass)) {
-		StarLogInfo("Pickup detected: OQGoldKey (id=%d).", OGENGINE_PICKUP_OQUAKE_GOLD_KEY);
+	PClassActor* actorClass = special->GetClass();
+	const ODOOM_PickupClass& pc = ODOOM_ClassifyPickup(actorClass);
+	if (pc.pickup == OGENGINE_PICKUP_OQUAKE_GOLD_KEY) {
+		ODOOM_PickupLog("OQGoldKey (id=%d).", OGENGINE_PICKUP_OQUAKE_GOLD_KEY);
 		return OGENGINE_PICKUP_OQUAKE_GOLD_KEY;
 	}
-	if (oqSilverKeyClass && special->IsKindOf(oqSilverKeyClass)) {
-		StarLogInfo("Pickup detected: OQSilverKey (id=%d).", OGENGINE_PICKUP_OQUAKE_SILVER_KEY);
+	if (pc.pickup == OGENGINE_PICKUP_OQUAKE_SILVER_KEY) {
+		ODOOM_PickupLog("OQSilverKey (id=%d).", OGENGINE_PICKUP_OQUAKE_SILVER_KEY);
 		return OGENGINE_PICKUP_OQUAKE_SILVER_KEY;
 	}
-
-	auto kt = PClass::FindActor(NAME_Key);
-	if (kt && special->IsKindOf(kt)) {
-		AActor* def = GetDefaultByType(special->GetClass());
-		if (!def) return 0;
-
-		int keynum = def->special1;
-		if (keynum <= 0 || keynum > 4) return 0;
-		StarLogInfo("Pickup detected: Doom key special1=%d.", keynum);
-		return keynum;
+	if (pc.pickup >= 1 && pc.pickup <= 4) {
+		ODOOM_PickupLog("Doom key special1=%d.", pc.pickup);
+		return pc.pickup;
 	}
 
 	// Generic inventory sync path: health, armor, ammo, weapons. Engine CallTouch runs first (gives item to player);
 	// when engine didn't consume we destroy and add to STAR. PostTouchSpecial adds to STAR/mint for all (including weapons).
-	auto invType = PClass::FindActor(NAME_Inventory);
-	if (invType && special->IsKindOf(invType)) {
-		const char* cls = special->GetClass()->TypeName.GetChars();
-		const char* type = "Item";
-		auto weaponType = PClass::FindActor(NAME_Weapon);
-		auto ammoType = PClass::FindActor(NAME_Ammo);
-		if (weaponType && special->IsKindOf(weaponType)) type = "Weapon";
-		else if (ammoType && special->IsKindOf(ammoType)) type = "Ammo";
-		else if (cls && (strstr(cls, "Armor") || strstr(cls, "armor"))) type = "Armor";
-		else if (cls && (strstr(cls, "Health") || strstr(cls, "health") || strstr(cls, "Medikit") || strstr(cls, "Stimpack"))) type = "Health";
-		if (cls && (strstr(cls, "SoulSphere") || strstr(cls, "Megasphere") || strstr(cls, "InvulnSphere")
-			|| strstr(cls, "RadSuit") || strstr(cls, "BlurSphere"))) {
-			type = "Powerup";
-		}
-
-		g_star_pending_item_name = ToStarItemName(cls);
-		{
-			int hamt = GetHealthOrArmorAmount(cls);
-			if (cls && strstr(cls, "Megasphere")) {
-				g_star_pending_item_desc = "Megasphere pickup (+200 health, +200 armor)";
-				g_star_pending_item_amount = 1;
-			} else if (hamt > 0) {
-				g_star_pending_item_desc = g_star_pending_item_name + " (+" + std::to_string(hamt) + ")";
-				g_star_pending_item_amount = 1;  /* 1 qty like OQUAKE; (+X) in description */
-			} else {
-				g_star_pending_item_desc = std::string("Picked up ") + (cls ? cls : "Item");
-				int amt = GetHardcodedAmmoAmount(cls);
-				g_star_pending_item_amount = (amt > 0) ? amt : 1;
-			}
-		}
-		g_star_pending_item_type = type;
+	if (pc.pickup == OGENGINE_PICKUP_GENERIC_ITEM || pc.pickup == OGENGINE_PICKUP_WEAPON) {
+		g_star_pending_item_name = pc.starName;
+		g_star_pending_item_desc = pc.desc;
+		g_star_pending_item_amount = pc.amount;
+		g_star_pending_item_type = pc.type;
 		g_star_has_pending_item = true;
 		/* Store player stats before touch: we only add to STAR when engine would leave item on floor (did not apply). */
 		{
@@ -3974,12 +4318,10 @@ int UZDoom_STAR_PreTouchSpecial(struct AActor* special) {
 				g_star_pre_touch_armor = -1;
 			}
 		}
-		StarLogInfo("Pickup detected: %s (type=%s, amount=%d).", cls ? cls : "Inventory", type, g_star_pending_item_amount);
-		/* Weapons: return OGENGINE_PICKUP_WEAPON so the engine never destroys the actor (CallTouch gives weapon to player); we still run PostTouchSpecial to add/mint in STAR. */
-		if (weaponType && special->IsKindOf(weaponType))
-			return OGENGINE_PICKUP_WEAPON;
-		/* Always return GENERIC_ITEM so engine runs CallTouch; we only add to STAR in PostTouchSpecial when engine didn't consume (e.g. at max). Avoids standing-on-pickup spam and ensures item is destroyed by game logic. use_armor_on_pickup/use_health_on_pickup are respected when at max (add to STAR if allow_pickup_if_max). */
-		return OGENGINE_PICKUP_GENERIC_ITEM;
+		ODOOM_PickupLog("%s (type=%s, amount=%d).", actorClass->TypeName.GetChars(), pc.type.c_str(), pc.amount);
+		/* Weapons: return OGENGINE_PICKUP_WEAPON so the engine never destroys the actor (CallTouch gives weapon to player); we still run PostTouchSpecial to add/mint in STAR.
+		 * Everything else: always return GENERIC_ITEM so engine runs CallTouch; we only add to STAR in PostTouchSpecial when engine didn't consume (e.g. at max). Avoids standing-on-pickup spam and ensures item is destroyed by game logic. use_armor_on_pickup/use_health_on_pickup are respected when at max (add to STAR if allow_pickup_if_max). */
+		return pc.pickup;
 	}
 
 	return 0;
@@ -4022,18 +4364,8 @@ void UZDoom_STAR_PostTouchSpecial(int keynum) {
 		FLevelLocals* level = primaryLevel;
 		player_t* pl = level ? level->GetConsolePlayer() : nullptr;
 		if (pl && pl->mo) {
-			int config_max_health = 200, config_max_armor = 200;
-			int allow_if_max = 1;
-			{
-				FBaseCVar* v = FindCVar("odoom_star_max_health", nullptr);
-				if (v && v->GetRealType() == CVAR_Int) config_max_health = v->GetGenericRep(CVAR_Int).Int;
-				if (config_max_health <= 0) config_max_health = 200;
-				v = FindCVar("odoom_star_max_armor", nullptr);
-				if (v && v->GetRealType() == CVAR_Int) config_max_armor = v->GetGenericRep(CVAR_Int).Int;
-				if (config_max_armor <= 0) config_max_armor = 200;
-				v = FindCVar("odoom_star_always_allow_pickup_if_max", nullptr);
-				if (v && v->GetRealType() == CVAR_Int) allow_if_max = v->GetGenericRep(CVAR_Int).Int ? 1 : 0;
-			}
+			const int config_max_health = ODOOM_ConfigMaxHealth(), config_max_armor = ODOOM_ConfigMaxArmor();
+			const int allow_if_max = odoom_star_always_allow_pickup_if_max ? 1 : 0;
 			int cur_health = pl->mo->health;
 			AActor* arm = pl->mo->FindInventory(FName("BasicArmor"), true);
 			int cur_armor = arm ? arm->IntVar(FName("Amount")) : 0;
@@ -4164,21 +4496,21 @@ void UZDoom_STAR_PostTouchSpecial(int keynum) {
 	static const char ODOOM_DEFAULT_QUEST_ID[] = "cross_dimensional_keycard_hunt";
 	if (keynum >= 1 && keynum <= 3) {
 		const char* obj = (keynum == 1) ? "doom_red_keycard" : (keynum == 2) ? "doom_blue_keycard" : "doom_yellow_keycard";
-		StarLogInfo("[Quests] ODOOM: completing objective quest=%s objective=%s (keycard pickup)", ODOOM_DEFAULT_QUEST_ID, obj);
+		OGLIB_LOGI("STAR API: [Quests] ODOOM: completing objective quest=%s objective=%s (keycard pickup)", ODOOM_DEFAULT_QUEST_ID, obj);
 		ogengine_result_t r = ogengine_complete_quest_objective(ODOOM_DEFAULT_QUEST_ID, obj, "ODOOM");
 		if (r != OGENGINE_SUCCESS)
 			StarLogInfo("[Quests] ODOOM: complete_quest_objective failed: %s", ogengine_get_last_error());
 		else
 			g_odoom_quest_tracker_needs_refresh = true;
 	} else if (keynum == OGENGINE_PICKUP_OQUAKE_SILVER_KEY) {
-		StarLogInfo("[Quests] ODOOM: completing objective quest=%s objective=quake_silver_key (OQuake silver key pickup)", ODOOM_DEFAULT_QUEST_ID);
+		OGLIB_LOGI("STAR API: [Quests] ODOOM: completing objective quest=%s objective=quake_silver_key (OQuake silver key pickup)", ODOOM_DEFAULT_QUEST_ID);
 		ogengine_result_t r = ogengine_complete_quest_objective(ODOOM_DEFAULT_QUEST_ID, "quake_silver_key", "ODOOM");
 		if (r != OGENGINE_SUCCESS)
 			StarLogInfo("[Quests] ODOOM: complete_quest_objective failed: %s", ogengine_get_last_error());
 		else
 			g_odoom_quest_tracker_needs_refresh = true;
 	} else if (keynum == OGENGINE_PICKUP_OQUAKE_GOLD_KEY) {
-		StarLogInfo("[Quests] ODOOM: completing objective quest=%s objective=quake_gold_key (OQuake gold key pickup)", ODOOM_DEFAULT_QUEST_ID);
+		OGLIB_LOGI("STAR API: [Quests] ODOOM: completing objective quest=%s objective=quake_gold_key (OQuake gold key pickup)", ODOOM_DEFAULT_QUEST_ID);
 		ogengine_result_t r = ogengine_complete_quest_objective(ODOOM_DEFAULT_QUEST_ID, "quake_gold_key", "ODOOM");
 		if (r != OGENGINE_SUCCESS)
 			StarLogInfo("[Quests] ODOOM: complete_quest_objective failed: %s", ogengine_get_last_error());
@@ -4224,14 +4556,14 @@ int UZDoom_STAR_CheckDoorAccess(struct AActor* owner, int keynum, int remote) {
 		return 0;
 	}
 
-	/* Consume key matching this door (red door = red keycard only). */
-	bool keyMatchesDoor = (keyname && KeyNameContainsKeycard(keynum, keyname));
-	if (keyname && keyMatchesDoor) {
+	/* Consume key matching this door (red door = red keycard only: the bit is per colour). */
+	if (keyname) {
 		ogengine_sync_use_item_start(keyname, "odoom_door", ODOOM_OnUseItemDone, nullptr);
+		ODOOM_ConsumeStarKey(keynum);
 		/* Minimal logging: one line to file and console when door is opened with key. */
 		char buf[256];
 		std::snprintf(buf, sizeof(buf), "[ODOOM STAR] door keynum=%d opened with key=\"%s\"", keynum, keyname);
-		ogengine_log_to_file(buf);
+		ODOOM_LogToFile(buf);
 		Printf(PRINT_HIGH, TEXTCOLOR_GREEN "%s\n", buf);
 	}
 	return 1;
@@ -4245,9 +4577,7 @@ int UZDoom_STAR_PlayerHasKey(int keynum) {
 }
 
 int UZDoom_STAR_AlwaysAllowPickup(void) {
-	FBaseCVar* v = FindCVar("odoom_star_always_allow_pickup_if_max", nullptr);
-	if (v && v->GetRealType() == CVAR_Int) return (v->GetGenericRep(CVAR_Int).Int != 0) ? 1 : 0;
-	return 1;
+	return odoom_star_always_allow_pickup_if_max ? 1 : 0;
 }
 
 /** Called from a_doors.cpp EV_DoDoor before P_CheckKeys. No-op to avoid log spam (engine calls every tic). */
@@ -4272,17 +4602,9 @@ void ODOOM_STAR_LogDoorLockedRaiseLock(int lock) {
 void UZDoom_STAR_OnBossKilled(const char* boss_name) {
 	if (!boss_name || !boss_name[0] || !g_star_initialized) return;
 	if (!StarTryInitializeAndAuthenticate(false)) return;
-	char nft_id[128] = {};
 	char desc[256];
 	std::snprintf(desc, sizeof(desc), "Boss defeated in ODOOM: %s", boss_name);
-	const char* prov = (const char*)odoom_star_nft_provider;
-	ogengine_result_t r = ogengine_create_monster_nft(boss_name, desc, "ODOOM", "{}", prov && prov[0] ? prov : nullptr, nft_id);
-	if (r == OGENGINE_SUCCESS && nft_id[0])
-		Printf(PRINT_HIGH, "WEB4 OASIS API: Boss NFT created for \"%s\". ID: %s\n", boss_name, nft_id);
-	else if (r != OGENGINE_SUCCESS) {
-		const char* err = ogengine_get_last_error();
-		Printf(PRINT_HIGH, "WEB4 OASIS API: Boss NFT failed for \"%s\": %s\n", boss_name, err && err[0] ? err : "unknown");
-	}
+	ODOOM_StartBossNftMint(boss_name, desc);
 }
 
 static bool ODOOM_StrEqNoCase(const char* a, const char* b) {
@@ -4316,7 +4638,7 @@ void UZDoom_STAR_OnMonsterKilled(const char* monster_name) {
 	if (!monster_name || !monster_name[0] || !g_star_initialized) return;
 	const ODOOM_MonsterEntry* e = ODOOM_FindMonsterByEngineName(monster_name);
 	if (!e) {
-		Printf(PRINT_HIGH, "ODOOM STAR: unknown monster \"%s\" (no XP/mint)\n", monster_name);
+		OGLIB_LOG_EVERY_MS(5000, OGLIB_LOG_WARN, "ODOOM STAR: unknown monster \"%s\" (no XP/mint)", monster_name);
 		return;
 	}
 	if (!StarTryInitializeAndAuthenticate(false)) return;
@@ -4351,30 +4673,13 @@ static void oasis_open_url(const char *url)
 /** Set toast message for ZScript (same as inventory popup "at max" feedback). */
 static void ODOOM_SetToastMessage(const char* msg) {
 	if (!msg || !msg[0]) return;
-	FBaseCVar* toastMsgCv = FindCVar("odoom_star_toast_message", nullptr);
-	FBaseCVar* toastFramesCv = FindCVar("odoom_star_toast_frames", nullptr);
-	if (toastMsgCv && toastMsgCv->GetRealType() == CVAR_String) {
-		UCVarValue val; val.String = (char*)msg;
-		toastMsgCv->SetGenericRep(val, CVAR_String);
-	}
-	if (toastFramesCv && toastFramesCv->GetRealType() == CVAR_Int) {
-		UCVarValue v; v.Int = 105; /* ~3 sec at 35 fps, same as popup */
-		toastFramesCv->SetGenericRep(v, CVAR_Int);
-	}
+	ODOOM_ShowToast(msg, 105); /* ~3 sec at 35 fps, same as popup */
 }
 
 static bool ODOOM_AnyStarPopupOpenForHudToggle(void)
 {
-	FBaseCVar* inv = FindCVar("odoom_inventory_open", nullptr);
-	if (inv && inv->GetRealType() == CVAR_Int && inv->GetGenericRep(CVAR_Int).Int != 0)
-		return true;
-	FBaseCVar* q = FindCVar("odoom_quest_popup_open", nullptr);
-	if (q && q->GetRealType() == CVAR_Int && q->GetGenericRep(CVAR_Int).Int != 0)
-		return true;
-	FBaseCVar* s = FindCVar("odoom_send_popup_open", nullptr);
-	if (s && s->GetRealType() == CVAR_Int && s->GetGenericRep(CVAR_Int).Int != 0)
-		return true;
-	return false;
+	return ODOOM_GetCVar(g_odoom_cv.odoom_inventory_open, 0) != 0 || ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0) != 0 ||
+		ODOOM_GetCVar(g_odoom_cv.odoom_send_popup_open, 0) != 0;
 }
 
 static void ODOOM_FlipHudIntCVar(const char* cvarName)
@@ -4390,7 +4695,7 @@ CCMD(odoom_hud_toggle_timer) { ODOOM_FlipHudIntCVar("odoom_hud_show_timer"); }
 
 CCMD(odoom_use_health)
 {
-	if (!g_star_initialized || ogengine_sync_use_item_in_progress()) return;
+	if (!g_star_initialized || !ODOOM_CanStartUseItem()) return;
 	std::string name, type;
 	if (!ODOOM_FindFirstHealthOrArmorInInventory(true, &name, &type)) {
 		Printf("No health item in STAR inventory.\n");
@@ -4404,14 +4709,12 @@ CCMD(odoom_use_health)
 		}
 		return;
 	}
-	g_star_use_pending_name = name;
-	g_star_use_pending_type = type;
-	ogengine_sync_use_item_start(name.c_str(), "odoom_use_health", ODOOM_OnUseItemFromInventoryDone, nullptr);
+	ODOOM_StartUseFromInventory(name, type, std::string(), "odoom_use_health");
 }
 
 CCMD(odoom_use_armor)
 {
-	if (!g_star_initialized || ogengine_sync_use_item_in_progress()) return;
+	if (!g_star_initialized || !ODOOM_CanStartUseItem()) return;
 	std::string name, type;
 	if (!ODOOM_FindFirstHealthOrArmorInInventory(false, &name, &type)) {
 		Printf("No armor item in STAR inventory.\n");
@@ -4425,20 +4728,80 @@ CCMD(odoom_use_armor)
 		}
 		return;
 	}
-	g_star_use_pending_name = name;
-	g_star_use_pending_type = type;
-	ogengine_sync_use_item_start(name.c_str(), "odoom_use_armor", ODOOM_OnUseItemFromInventoryDone, nullptr);
+	ODOOM_StartUseFromInventory(name, type, std::string(), "odoom_use_armor");
 }
 
 CCMD(odoom_quest_toggle)
 {
 	if (!g_star_initialized) return;
-	FBaseCVar* popupVar = FindCVar("odoom_quest_popup_open", nullptr);
-	if (popupVar && popupVar->GetRealType() == CVAR_Int) {
-		int cur = popupVar->GetGenericRep(CVAR_Int).Int;
-		UCVarValue val; val.Int = cur ? 0 : 1;
-		popupVar->SetGenericRep(val, CVAR_Int);
+	ODOOM_SetCVar(g_odoom_cv.odoom_quest_popup_open, ODOOM_GetCVar(g_odoom_cv.odoom_quest_popup_open, 0) ? 0 : 1);
+}
+
+/** Parse "<subcommand> args..." (args[first] onwards) into a batch command; false with *err set for anything batch mode does not run. */
+static bool ODOOM_ParseStarBatchCmd(FCommandLine& args, int first, ODOOM_StarBatchCmd* cmd, const char** err) {
+	const int n = args.argc() - first;
+	auto arg = [&](int i, const char* def) -> const char* { return (i < n) ? args[first + i] : def; };
+	const char* sub = arg(0, "");
+	const char* qsub = arg(1, "");
+	*err = nullptr;
+	if (strcmp(sub, "has") == 0 && n >= 2) {
+		cmd->op = ODOOM_STAR_BATCH_HAS;
+	} else if (strcmp(sub, "add") == 0 && n >= 2) {
+		cmd->op = ODOOM_STAR_BATCH_ADD;
+		cmd->arg[1] = arg(2, "Added from console");
+		cmd->arg[2] = arg(3, "Miscellaneous");
+	} else if (strcmp(sub, "use") == 0 && n >= 2) {
+		cmd->op = ODOOM_STAR_BATCH_USE;
+		cmd->arg[1] = arg(2, "console");
+	} else if (strcmp(sub, "deploynft") == 0 && n >= 3) {
+		cmd->op = ODOOM_STAR_BATCH_DEPLOY_NFT;
+		cmd->arg[1] = arg(2, "");
+		cmd->arg[2] = arg(3, "");
+	} else if (strcmp(sub, "quest") == 0 && strcmp(qsub, "start") == 0 && n >= 3) {
+		cmd->op = ODOOM_STAR_BATCH_QUEST_START;
+	} else if (strcmp(sub, "quest") == 0 && strcmp(qsub, "objective") == 0 && n >= 4) {
+		cmd->op = ODOOM_STAR_BATCH_QUEST_OBJECTIVE;
+		cmd->arg[1] = arg(3, "");
+	} else if (strcmp(sub, "quest") == 0 && strcmp(qsub, "complete") == 0 && n >= 3) {
+		cmd->op = ODOOM_STAR_BATCH_QUEST_COMPLETE;
+	} else {
+		*err = "expected has|add|use <item> ..., quest start|objective|complete <id> ..., or deploynft <nft_id> <game> [loc]";
+		return false;
+	}
+	cmd->arg[0] = (strcmp(sub, "quest") == 0) ? arg(2, "") : arg(1, "");
+	return true;
+}
+
+/** star batch <file>: one subcommand per line ("star" prefix optional, # comments). The whole file is checked before anything runs. */
+static void ODOOM_StartStarBatchFile(const char* path) {
+	FILE* f = fopen(path, "r");
+	if (!f) { Printf("Cannot open %s.\n", path); return; }
+	std::vector<ODOOM_StarBatchCmd> cmds;
+	char buf[1024];
+	int lineNo = 0, bad = 0;
+	bool anyAdd = false;
+	while (fgets(buf, sizeof(buf), f)) {
+		lineNo++;
+		FCommandLine line(buf);
+		if (line.argc() == 0 || line[0][0] == '#') continue;
+		const int first = (strcmp(line[0], "star") == 0) ? 1 : 0;
+		ODOOM_StarBatchCmd cmd;
+		const char* err = nullptr;
+		if (!ODOOM_ParseStarBatchCmd(line, first, &cmd, &err)) {
+			if (++bad <= ODOOM_STAR_BATCH_FAILURES_SHOWN) Printf("%s:%d: %s\n", path, lineNo, err);
+			continue;
+		}
+		cmd.line = lineNo;
+		anyAdd |= (cmd.op == ODOOM_STAR_BATCH_ADD);
+		cmds.push_back(std::move(cmd));
 	}
+	fclose(f);
+	if (bad) { Printf("%s: %d bad line(s); nothing was run.\n", path, bad); return; }
+	if (cmds.empty()) { Printf("%s: no commands.\n", path); return; }
+	if (anyAdd && !StarAllowPrivilegedCommands()) { Printf("Only dellams or anorak can use star add (in %s).\n", path); return; }
+	const size_t count = cmds.size();
+	if (!ODOOM_StartStarBatch(std::move(cmds), path, false)) { Printf("A STAR batch is already running (star batch status|cancel).\n"); return; }
+	Printf("STAR batch started: %zu command(s) from %s.\n", count, path);
 }
 
 CCMD(star)
@@ -4462,10 +4825,16 @@ CCMD(star)
 		Printf("  star quest complete <id>    - Complete a quest\n");
 		Printf("  star bossnft <name> [desc]   - Create boss NFT\n");
 		Printf("  star deploynft <nft_id> <game> [loc] - Deploy boss NFT\n");
+		Printf("  star async <has|add|use|quest|deploynft ...> - Run that subcommand in the background; result prints when done\n");
+		Printf("  star batch <file>|status|cancel - Run a file of those subcommands (one per line) in the background, with progress\n");
 		Printf("  star pickup ifmax <0|1> - At max: 1=pick up into STAR, 0=original Doom (leave on floor)\n");
 		Printf("  star pickup all <0|1> - 1=always add to STAR even when engine uses it, 0=only when at max\n");
 		Printf("  star pickup keycard <red|blue|yellow|skull> - Add keycard to STAR inventory (admin only)\n");
 		Printf("  star debug on|off|status - Toggle STAR debug logging in console\n");
+		Printf("  star trace on|off|dump [file] - Record OASIS spans; dump writes Chrome/Perfetto JSON (default odoom_trace.json)\n");
+#ifdef OGENGINE_SYNC_HAS_STATS
+		Printf("  star syncstats [reset] - STAR sync latency (queue/network/deliver p50/p95/max) and queue depth per operation\n");
+#endif
 		Printf("  star face on|off|status - Toggle beamed-in face switch (default on)\n");
 		Printf("  star config        - Show current STAR config (URLs, beam face, stack, mint NFT, provider, max_health, max_armor)\n");
 		Printf("  star config save   - Write config to oasisstar.json now (also saved on exit)\n");
@@ -4542,6 +4911,42 @@ CCMD(star)
 		Printf("\n");
 		return;
 	}
+	if (strcmp(sub, "trace") == 0) {
+		Printf("\n");
+		if (argv.argc() >= 3 && strcmp(argv[2], "on") == 0) {
+			oglib_trace_enable(1);
+			Printf("OASIS trace recording on. Use 'star trace dump' to write the trace.\n");
+		} else if (argv.argc() >= 3 && strcmp(argv[2], "off") == 0) {
+			oglib_trace_enable(0);
+			Printf("OASIS trace recording off.\n");
+		} else if (argv.argc() >= 3 && strcmp(argv[2], "dump") == 0) {
+			const char* path = argv.argc() >= 4 ? argv[3] : "odoom_trace.json";
+			if (oglib_trace_export_json(path))
+				Printf("OASIS trace written to %s (open in ui.perfetto.dev or chrome://tracing).\n", path);
+			else
+				Printf("Could not write OASIS trace to %s.\n", path);
+		} else {
+			Printf("OASIS trace recording is %s\n", OGLIB_TRACE_ON() ? "on" : "off");
+			Printf("Usage: star trace on|off|dump [file]\n");
+		}
+		Printf("\n");
+		return;
+	}
+#ifdef OGENGINE_SYNC_HAS_STATS
+	if (strcmp(sub, "syncstats") == 0) {
+		Printf("\n");
+		if (argv.argc() >= 3 && strcmp(argv[2], "reset") == 0) {
+			ogengine_sync_reset_stats();
+			Printf("STAR sync stats cleared.\n");
+		} else {
+			char report[4096];
+			ogengine_sync_format_stats(report, sizeof(report));
+			Printf("%s", report);
+		}
+		Printf("\n");
+		return;
+	}
+#endif
 	if (strcmp(sub, "debug") == 0) {
 		Printf("\n");
 		if (argv.argc() < 3 || strcmp(argv[2], "status") == 0) {
@@ -4670,10 +5075,8 @@ CCMD(star)
 	if (strcmp(sub, "quest") == 0) {
 		if (argv.argc() == 2) {
 			/* "star quest" with no subcommand: open the quest popup */
-			FBaseCVar* popupVar = FindCVar("odoom_quest_popup_open", nullptr);
-			if (popupVar && popupVar->GetRealType() == CVAR_Int) {
-				UCVarValue val; val.Int = 1;
-				popupVar->SetGenericRep(val, CVAR_Int);
+			if (g_odoom_cv.odoom_quest_popup_open) {
+				ODOOM_SetCVar(g_odoom_cv.odoom_quest_popup_open, 1);
 				Printf("Quest popup opened.\n");
 			}
 			return;
@@ -4711,11 +5114,8 @@ CCMD(star)
 		if (argv.argc() < 3) { Printf("Usage: star bossnft <boss_name> [description]\n"); return; }
 		const char* name = argv[2];
 		const char* desc = argv.argc() > 3 ? argv[3] : "Boss from UZDoom";
-		char nft_id[64] = {};
-		const char* prov = (const char*)odoom_star_nft_provider;
-		ogengine_result_t r = ogengine_create_monster_nft(name, desc, "ODOOM", "{}", prov && prov[0] ? prov : nullptr, nft_id);
-		if (r == OGENGINE_SUCCESS) Printf("Boss NFT created. ID: %s\n", nft_id[0] ? nft_id : "(none)");
-		else Printf("Failed: %s\n", ogengine_get_last_error());
+		ODOOM_StartBossNftMint(name, desc);
+		Printf("Boss NFT mint started for \"%s\"; the result appears when it completes.\n", name);
 		return;
 	}
 	if (strcmp(sub, "deploynft") == 0) {
@@ -4725,6 +5125,35 @@ CCMD(star)
 		Printf(r == OGENGINE_SUCCESS ? "NFT deploy requested.\n" : "Failed: %s\n", ogengine_get_last_error());
 		return;
 	}
+	if (strcmp(sub, "batch") == 0) {
+		ODOOM_StarBatch& b = g_odoom_star_batch;
+		if (argv.argc() < 3) { Printf("Usage: star batch <file>|status|cancel\n"); return; }
+		if (strcmp(argv[2], "status") == 0) {
+			if (!b.active) Printf("No STAR batch running.\n");
+			else Printf("STAR batch %s: %zu/%zu done, %zu failed, %d in flight%s.\n", b.source.c_str(), b.done, b.cmds.size(), b.failed, b.inFlight, b.cancelled ? " (cancelling)" : "");
+			return;
+		}
+		if (strcmp(argv[2], "cancel") == 0) {
+			if (!b.active) { Printf("No STAR batch running.\n"); return; }
+			b.cancelled = true;  /* commands already sent still finish and are counted */
+			Printf("Cancelling STAR batch; waiting for %d command(s) in flight.\n", b.inFlight);
+			return;
+		}
+		if (!StarInitialized()) { Printf("STAR API not initialized. %s\n", ogengine_get_last_error()); return; }
+		ODOOM_StartStarBatchFile(argv[2]);
+		return;
+	}
+	if (strcmp(sub, "async") == 0) {
+		ODOOM_StarBatchCmd cmd;
+		const char* err = nullptr;
+		if (!ODOOM_ParseStarBatchCmd(argv, 2, &cmd, &err)) { Printf("Usage: star async <subcommand ...>: %s\n", err); return; }
+		if (cmd.op == ODOOM_STAR_BATCH_ADD && !StarAllowPrivilegedCommands()) { Printf("Only dellams or anorak can use star add.\n"); return; }
+		if (!StarInitialized()) { Printf("STAR API not initialized. %s\n", ogengine_get_last_error()); return; }
+		std::vector<ODOOM_StarBatchCmd> one(1, cmd);
+		if (!ODOOM_StartStarBatch(std::move(one), "async", true)) { Printf("A STAR batch is running; wait for it or star batch cancel.\n"); return; }
+		Printf("Started star %s %s.\n", ODOOM_StarBatchOpName(cmd.op), cmd.arg[0].c_str());
+		return;
+	}
 	if (strcmp(sub, "beamin") == 0) {
 		Printf("\n");
 		g_star_user_beamed_out = false;  /* User explicitly beaming in; allow auth. */
@@ -4851,6 +5280,7 @@ CCMD(star)
 		}
 		g_star_client_ready = false;
 		g_star_initialized = false;
+		oglib_beamin_reset(&g_odoom_beamin);
 		g_star_user_beamed_out = true;  /* Stay logged out until user runs "star beamin" again. */
 		g_star_refresh_xp_called_this_session = false;  /* Next beam-in will call refresh once. */
 		g_star_init_failed_this_session = false;
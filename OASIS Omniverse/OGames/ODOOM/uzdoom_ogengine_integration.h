@@ -81,9 +81,9 @@ void ODOOM_STAR_LogDoorLockedRaiseLock(int lock);
 /** Call every frame from status bar (when OASIS_STAR_API): polls async auth/inventory and when inventory open, clear key bindings (OQuake-style). */
 void ODOOM_InventoryInputCaptureFrame(void);
 
-/** Call after TryRunTics so STAR health/armor apply runs after the tic and is not overwritten; applies deferred use-item health/armor. */
+/** Call after TryRunTics: refreshes the STAR overlay once a deferred use-item health/armor apply has landed. */
 void ODOOM_PostTic(void);
-/** Call after every game tic (inside TryRunTics loop) to re-apply stored health/armor so engine overwrites don't stick. */
+/** Call after every game tic (inside TryRunTics loop): applies deferred use-item health/armor once, on the unpredicted player. */
 void ODOOM_PostOneTic(void);
 
 /** Call from engine input when building ticcmd: set odoom_key_* CVars from raw key state (for ZScript). q = key Q for quest popup. */
@@ -41,8 +41,9 @@ cp -v "$OMNIVERSE_ROOT/d3doom_ogengine_integration.cpp" "$DEST/"
 echo ""
 echo "[2/4] Copying OGLib headers..."
 mkdir -p "$DEST/OGLib"
-for f in oglib.h oglib_str.h oglib_json.h oglib_crossgame.h \
-          oglib_monster.h oglib_session.h oglib_config.h oglib_beamin.h; do
+for f in oglib.h oglib_str.h oglib_json.h oglib_crossgame.h oglib_events.h \
+          oglib_monster.h oglib_session.h oglib_config.h oglib_beamin.h \
+          oglib_log.h oglib_atomic.h oglib_time.h oglib_trace.h ogengine_exports.h; do
     [ -f "$OGLIB_SRC/$f" ] && cp -v "$OGLIB_SRC/$f" "$DEST/OGLib/"
 done
 
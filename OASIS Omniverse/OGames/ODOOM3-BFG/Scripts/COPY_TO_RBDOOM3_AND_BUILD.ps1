@@ -71,10 +71,16 @@ $OGLibFiles = @(
     "oglib_str.h",
     "oglib_json.h",
     "oglib_crossgame.h",
+    "oglib_events.h",
     "oglib_monster.h",
     "oglib_session.h",
     "oglib_config.h",
-    "oglib_beamin.h"
+    "oglib_beamin.h",
+    "oglib_log.h",
+    "oglib_atomic.h",
+    "oglib_time.h",
+    "oglib_trace.h",
+    "ogengine_exports.h"
 )
 foreach ($f in $OGLibFiles) {
     $src = Join-Path $OGLibSrc $f
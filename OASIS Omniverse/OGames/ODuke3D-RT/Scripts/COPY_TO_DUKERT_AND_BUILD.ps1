@@ -77,8 +77,9 @@ Write-Host "`n[2/4] Copying OGLib headers..."
 $OGLibDest = Join-Path $Dest "OGLib"
 if (-not (Test-Path $OGLibDest)) { New-Item -ItemType Directory -Path $OGLibDest | Out-Null }
 
-$OGLibFiles = @("oglib.h","oglib_str.h","oglib_json.h","oglib_crossgame.h",
-                "oglib_monster.h","oglib_session.h","oglib_config.h","oglib_beamin.h")
+$OGLibFiles = @("oglib.h","oglib_str.h","oglib_json.h","oglib_crossgame.h","oglib_events.h",
+                "oglib_monster.h","oglib_session.h","oglib_config.h","oglib_beamin.h",
+                "oglib_log.h","oglib_atomic.h","oglib_time.h","oglib_trace.h","ogengine_exports.h")
 foreach ($f in $OGLibFiles) {
     $src = Join-Path $OGLibSrc $f
     $dst = Join-Path $OGLibDest $f
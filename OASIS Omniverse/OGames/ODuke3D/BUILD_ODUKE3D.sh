@@ -45,8 +45,9 @@ echo "  Copied: oduke3d_ogengine_integration.h / .c"
 echo ""
 echo "[2/3] Copying OGLib headers..."
 mkdir -p "$DEST/OGLib"
-for f in oglib.h oglib_str.h oglib_json.h oglib_crossgame.h \
-          oglib_monster.h oglib_session.h oglib_config.h oglib_beamin.h; do
+for f in oglib.h oglib_str.h oglib_json.h oglib_crossgame.h oglib_events.h \
+          oglib_monster.h oglib_session.h oglib_config.h oglib_beamin.h \
+          oglib_log.h oglib_atomic.h oglib_time.h oglib_trace.h ogengine_exports.h; do
     if [[ -f "$OGLIB_SRC/$f" ]]; then
         cp -f "$OGLIB_SRC/$f" "$DEST/OGLib/"
         echo "  Copied: OGLib/$f"
@@ -15,8 +15,9 @@ set "OGENGINECLIENT=%HERE%..\..\OGEngineClient"
 set "OQUAKE_INTEGRATION=%HERE%"
 REM Set to 1 to always build and deploy OGEngineClient before building (script skips build if client unchanged).
 set "BUILD_STAR_CLIENT=0"
-REM Always use star_sync from ogengine.dll (C# client exports). Do not compile ogengine_sync.c in engine.
-set "OASIS_STAR_SYNC_IN_CLIENT=1"
+REM Default: compile ogengine_sync.c (C: worker pool, op queues, jobs, stats). Set to 1 to use star_sync from ogengine.dll (C#) instead.
+REM apply_oquake_to_vkquake.ps1 reads it too: the vkQuake project builds ogengine_sync.c only when Quake\ogengine_sync.c is present.
+if not defined OASIS_STAR_SYNC_IN_CLIENT set "OASIS_STAR_SYNC_IN_CLIENT=0"
 
 REM Generate OQuake version from Version/oquake_version.txt -> Code/oquake_version.h, Version/version_display.txt
 if exist "%OQUAKE_INTEGRATION%Scripts\generate_oquake_version.ps1" powershell -NoProfile -ExecutionPolicy Bypass -File "%OQUAKE_INTEGRATION%Scripts\generate_oquake_version.ps1" -Root "%OQUAKE_INTEGRATION%"
@@ -81,12 +82,19 @@ if not defined STAR_DLL (
 
 if not exist "%OGENGINECLIENT%\ogengine.h" (echo ogengine.h not found: %OGENGINECLIENT% & pause & exit /b 1)
 
-REM --- star_sync declarations only (implementation comes from ogengine.dll exports). ---
+REM --- star_sync: C implementation (default) needs ogengine_sync.c next to the integration; in-client mode only the header. ---
 set "OGENGINECLIENT=%HERE%..\..\OGEngineClient"
 set "OQUAKE_CODE=%OQUAKE_INTEGRATION%Code\"
 if exist "%OGENGINECLIENT%\ogengine_sync.h" (
     if not exist "%OQUAKE_CODE%" mkdir "%OQUAKE_CODE%"
     copy /Y "%OGENGINECLIENT%\ogengine_sync.h" "%OQUAKE_CODE%" >nul
+    if "%OASIS_STAR_SYNC_IN_CLIENT%"=="1" (
+        if exist "%OQUAKE_CODE%ogengine_sync.c" del /Q "%OQUAKE_CODE%ogengine_sync.c"
+        echo [OQuake][INFO] Using star_sync from ogengine.dll - C# exports
+    ) else (
+        copy /Y "%OGENGINECLIENT%\ogengine_sync.c" "%OQUAKE_CODE%" >nul
+        echo [OQuake][INFO] Compiling ogengine_sync.c - C implementation, default
+    )
 )
 
 REM --- Require at least vkQuake to build the exe. quake-rerelease-qc (QUAKE_SRC) is optional if you only run BUILD QUAKE. ---
@@ -103,6 +111,7 @@ if exist "%QUAKE_SRC%" (
     copy /Y "%OQUAKE_CODE%engine_oquake_hooks.c.example" "%QUAKE_SRC%\" >nul
     copy /Y "%OGENGINECLIENT%\ogengine.h" "%QUAKE_SRC%\" >nul
     if exist "%OQUAKE_CODE%ogengine_sync.h" copy /Y "%OQUAKE_CODE%ogengine_sync.h" "%QUAKE_SRC%\" >nul
+    if exist "%OQUAKE_CODE%ogengine_sync.c" copy /Y "%OQUAKE_CODE%ogengine_sync.c" "%QUAKE_SRC%\" >nul
     copy /Y "%STAR_DLL%" "%QUAKE_SRC%\ogengine.dll" >nul
     if defined STAR_LIB copy /Y "%STAR_LIB%" "%QUAKE_SRC%\ogengine.lib" >nul
     echo   %QUAKE_SRC%
@@ -124,6 +133,7 @@ copy /Y "%OQUAKE_CODE%oquake_ogengine_integration.h" "%VKQUAKE_SRC%\Quake\" >nul
 copy /Y "%OQUAKE_CODE%oquake_version.h" "%VKQUAKE_SRC%\Quake\" >nul
 copy /Y "%OGENGINECLIENT%\ogengine.h" "%VKQUAKE_SRC%\Quake\" >nul
 if exist "%OQUAKE_CODE%ogengine_sync.h" copy /Y "%OQUAKE_CODE%ogengine_sync.h" "%VKQUAKE_SRC%\Quake\" >nul
+if exist "%OQUAKE_CODE%ogengine_sync.c" (copy /Y "%OQUAKE_CODE%ogengine_sync.c" "%VKQUAKE_SRC%\Quake\" >nul) else (if exist "%VKQUAKE_SRC%\Quake\ogengine_sync.c" del /Q "%VKQUAKE_SRC%\Quake\ogengine_sync.c")
 copy /Y "%STAR_DLL%" "%VKQUAKE_SRC%\Quake\ogengine.dll" >nul
 if defined STAR_LIB copy /Y "%STAR_LIB%" "%VKQUAKE_SRC%\Quake\ogengine.lib" >nul
 
@@ -42,6 +42,9 @@ DO_FULL_CLEAN=0
 RUN_AFTER_BUILD=0
 BATCH_MODE=0
 BUILD_STAR_CLIENT=0
+# Default: compile ogengine_sync.c (C: worker pool, op queues, jobs, stats). Set OASIS_STAR_SYNC_IN_CLIENT=1 to use the star_sync exports from star_api (C#) instead.
+# apply_oquake_to_vkquake.ps1 reads it too: vkQuake builds ogengine_sync.c only when Quake/ogengine_sync.c is present.
+export OASIS_STAR_SYNC_IN_CLIENT="${OASIS_STAR_SYNC_IN_CLIENT:-0}"
 for arg in "$@"; do
   [[ "$arg" == "run" ]] && RUN_AFTER_BUILD=1
   [[ "$arg" == "batch" ]] && BATCH_MODE=1
@@ -117,10 +120,18 @@ if [[ ! -f "$OGENGINECLIENT/ogengine.h" ]]; then
   exit 1
 fi
 
-# star_sync API comes from star_api client exports; only header is needed for declarations.
+# star_sync: OGEngineClient is the only source. C implementation (default) needs ogengine_sync.c next to the integration;
+# with OASIS_STAR_SYNC_IN_CLIENT=1 only the header is needed and a stale ogengine_sync.c is removed.
 if [[ -f "$OGENGINECLIENT/ogengine_sync.h" ]]; then
   mkdir -p "$OQUAKE_CODE"
   cp -f "$OGENGINECLIENT/ogengine_sync.h" "$OQUAKE_CODE/"
+  if [[ "$OASIS_STAR_SYNC_IN_CLIENT" == "1" ]]; then
+    rm -f "$OQUAKE_CODE/ogengine_sync.c"
+    echo "[OQuake][INFO] Using star_sync from star_api - C# exports"
+  else
+    cp -f "$OGENGINECLIENT/ogengine_sync.c" "$OQUAKE_CODE/"
+    echo "[OQuake][INFO] Compiling ogengine_sync.c - C implementation (default)"
+  fi
 fi
 
 # Require vkQuake to build the exe. QUAKE_SRC (quake-rerelease-qc) is optional if you only run BUILD QUAKE.
@@ -141,6 +152,7 @@ if [[ -d "$QUAKE_SRC" ]]; then
   [[ -f "$OQUAKE_CODE/engine_oquake_hooks.c.example" ]] && cp -f "$OQUAKE_CODE/engine_oquake_hooks.c.example" "$QUAKE_SRC/"
   cp -f "$OGENGINECLIENT/ogengine.h" "$QUAKE_SRC/"
   [[ -f "$OQUAKE_CODE/ogengine_sync.h" ]] && cp -f "$OQUAKE_CODE/ogengine_sync.h" "$QUAKE_SRC/"
+  [[ -f "$OQUAKE_CODE/ogengine_sync.c" ]] && cp -f "$OQUAKE_CODE/ogengine_sync.c" "$QUAKE_SRC/"
   cp -f "$STAR_SO" "$QUAKE_SRC/"
   echo "  $QUAKE_SRC"
 else
@@ -160,6 +172,11 @@ if [[ -n "$VKQUAKE_SRC" && -d "$VKQUAKE_SRC" && -f "$VKQUAKE_SRC/Quake/pr_ext.c"
     [[ -f "$OQUAKE_CODE/oquake_ogengine_integration.c" ]] && cp -f "$OQUAKE_CODE/oquake_ogengine_integration.c" "$QUAKE_DIR/"
     [[ -f "$OQUAKE_CODE/oquake_ogengine_integration.h" ]] && cp -f "$OQUAKE_CODE/oquake_ogengine_integration.h" "$QUAKE_DIR/"
     [[ -f "$OQUAKE_CODE/ogengine_sync.h" ]] && cp -f "$OQUAKE_CODE/ogengine_sync.h" "$QUAKE_DIR/"
+    if [[ -f "$OQUAKE_CODE/ogengine_sync.c" ]]; then
+      cp -f "$OQUAKE_CODE/ogengine_sync.c" "$QUAKE_DIR/"
+    else
+      rm -f "$QUAKE_DIR/ogengine_sync.c"
+    fi
     cp -f "$OGENGINECLIENT/ogengine.h" "$QUAKE_DIR/"
   fi
   # Stage anorak HUD face (same as apply script): Images/ is canonical; pwsh path may be skipped above.
@@ -202,7 +219,11 @@ if [[ -n "$VKQUAKE_SRC" && -d "$VKQUAKE_SRC" && -f "$VKQUAKE_SRC/Quake/pr_ext.c"
       cd "$VKQUAKE_SRC"
       if [[ ! -d build ]]; then
         meson setup build --buildtype=release
+      elif [[ "$(cat build/.oasis_star_sync_in_client 2>/dev/null)" != "$OASIS_STAR_SYNC_IN_CLIENT" ]]; then
+        # meson picks star_sync (Quake/ogengine_sync.c present or not) at configure time.
+        meson setup --reconfigure build
       fi
+      echo "$OASIS_STAR_SYNC_IN_CLIENT" > build/.oasis_star_sync_in_client
       ninja -C build
       cd "$HERE"
       if [[ -f "$VKQUAKE_SRC/build/vkquake" ]]; then
@@ -1,187 +0,0 @@
-﻿/**
- * OASIS STAR API - Generic game integration layer (async auth, async inventory, local-item sync)
- *
- * Use this from OQUAKE, ODOOM, or any game that links against star_api. It provides:
- * - Async authentication (background thread; completion via callback from main thread)
- * - Async inventory refresh (background thread; completion via callback from main thread)
- * - Async send item (background thread; completion via callback from main thread)
- * - Reusable sync logic so games don't duplicate threading/sync code
- *
- * All completion callbacks are invoked on the main thread when you call ogengine_sync_pump().
- * Call ogengine_sync_pump() once per frame; no per-frame polling of individual operations.
- *
- * Include star_api.h before this header.
- *
- * Build options:
- * - Default: ogengine_sync_* are exported from star_api.dll (C# implementation). Do NOT compile
- *   star_sync.c; link only star_api. BUILD ODOOM / BUILD_OQUAKE set this by default.
- * - To use the C implementation instead: set OASIS_STAR_SYNC_IN_CLIENT=0 and rebuild, or
- *   undefine OASIS_STAR_SYNC_IN_CLIENT and add star_sync.c to the build again.
- * - If you get LNK2001 for ogengine_queue_quest_level_time: either link with a STAR API build
- *   that exports it, or add star_sync.c and define OGENGINE_PROVIDE_QUEST_LEVEL_TIME_STUB, or
- *   add only ogengine_quest_level_time_stub.c to the build (no macro needed).
- */
-
-#ifndef STAR_SYNC_H
-#define STAR_SYNC_H
-
-#include "ogengine.h"
-#include <stddef.h>
-#include <stdbool.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/** Optional callback invoked after add_item (single or batch): (item_name, success, error_message, user_data). Called from main thread. */
-typedef void (*ogengine_sync_add_item_log_fn)(const char* item_name, int success, const char* error_message, void* user_data);
-
-/** Set optional callback for add_item results (e.g. for debug logging). Pass NULL to clear. */
-void ogengine_sync_set_add_item_log_cb(ogengine_sync_add_item_log_fn cb, void* user_data);
-
-/** Call once at game startup (e.g. from OQuake_STAR_Init). Required on Windows to initialize locks. */
-void ogengine_sync_init(void);
-
-/** Call at game shutdown (e.g. from OQuake_STAR_Cleanup). Frees any pending inventory result and tears down locks. */
-void ogengine_sync_cleanup(void);
-
-/**
- * Call once per frame from the main thread. Runs any pending auth/inventory/send_item completion
- * callbacks on the main thread. More efficient than polling each operation every frame.
- */
-void ogengine_sync_pump(void);
-
-/* ---------------------------------------------------------------------------
- * Local item entry: one item to sync to remote (has_item then add_item if missing).
- * name, description, game_source, item_type are inputs; synced is output (1 when synced).
- * nft_id: optional; if set, add_item is called with this NFT ID (item is linked to NFTHolon).
- * Game allocates an array of these and passes to ogengine_sync_inventory_start.
- * --------------------------------------------------------------------------- */
-typedef struct ogengine_sync_local_item {
-    char name[256];
-    char description[512];
-    char game_source[64];
-    char item_type[64];
-    char nft_id[128];  /* optional; empty = no NFT. When set, add_item stores NFTId in item MetaData. */
-    int  synced;  /* output: set to 1 by sync layer when item is on remote */
-} ogengine_sync_local_item_t;
-
-/* ---------------------------------------------------------------------------
- * Async authentication
- * --------------------------------------------------------------------------- */
-
-/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees auth finished. In the callback, call ogengine_sync_auth_get_result() to get the result. */
-typedef void (*ogengine_sync_auth_on_done_fn)(void* user_data);
-
-/** Start authentication on a background thread. When done, on_done(user_data) is invoked from main thread when you call ogengine_sync_pump(). Pass NULL to use polling (ogengine_sync_auth_poll/get_result). */
-void ogengine_sync_auth_start(const char* username, const char* password, ogengine_sync_auth_on_done_fn on_done, void* user_data);
-
-/** Returns: 0 = still in progress, 1 = finished (call ogengine_sync_auth_get_result), -1 = not started / no result. Only needed if not using callbacks. */
-int ogengine_sync_auth_poll(void);
-
-/** Get result after poll returned 1. Copies username/avatar_id/error into buffers. Returns 1 on success, 0 on failure. */
-int ogengine_sync_auth_get_result(
-    int* success_out,
-    char* username_buf, size_t username_size,
-    char* avatar_id_buf, size_t avatar_id_size,
-    char* error_msg_buf, size_t error_msg_size
-);
-/** Copy JWT from last auth result into jwt_buf (call after ogengine_sync_auth_get_result). For oasisstar.json / autobeamin. */
-void ogengine_sync_auth_get_result_jwt(char* jwt_buf, size_t jwt_size);
-
-/** Non-zero if an auth is currently in progress */
-int ogengine_sync_auth_in_progress(void);
-
-/** Force-clear auth state so a new auth can be started (e.g. after timeout). Call when the game has given up waiting; the previous auth thread may still complete later and invoke the callback once. */
-void ogengine_sync_auth_force_reset(void);
-
-/* ---------------------------------------------------------------------------
- * Async inventory refresh (optionally sync local items first, then get_inventory)
- * --------------------------------------------------------------------------- */
-
-/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees inventory finished. In the callback, call ogengine_sync_inventory_get_result() then ogengine_sync_inventory_clear_result() when done. Pass NULL to use polling. */
-typedef void (*ogengine_sync_inventory_on_done_fn)(void* user_data);
-
-/** Start inventory refresh on a background thread. Syncs local_items (has_item/add_item) then get_inventory.
- *  local_items may be NULL (or count 0) to only fetch inventory.
- *  on_done and on_done_user: optional; if non-NULL, on_done(user_data) is called from main thread in ogengine_sync_pump(). Pass NULL, NULL to use polling. */
-void ogengine_sync_inventory_start(
-    ogengine_sync_local_item_t* local_items,
-    int local_count,
-    const char* default_game_source,
-    ogengine_sync_inventory_on_done_fn on_done,
-    void* on_done_user
-);
-
-/** Returns: 0 = in progress, 1 = finished (call ogengine_sync_inventory_get_result and free the list), -1 = not started / no result */
-int ogengine_sync_inventory_poll(void);
-
-/** Get result after poll returned 1. *list_out is valid until next ogengine_sync_inventory_start or ogengine_sync_inventory_clear_result.
- *  Caller must call ogengine_free_item_list() when done. */
-int ogengine_sync_inventory_get_result(
-    ogengine_item_list_t** list_out,
-    ogengine_result_t* result_out,
-    char* error_msg_buf, size_t error_msg_size
-);
-
-/** Clear the stored result (frees the list). Call after you've copied or used the list. */
-void ogengine_sync_inventory_clear_result(void);
-
-/** Deliver inventory result from the game's operation_callback(OGENGINE_OP_GET_INVENTORY). Call after ogengine_get_inventory() when callback fires. Takes ownership of list (may be NULL on error). */
-void ogengine_sync_inventory_deliver_result(ogengine_item_list_t* list, ogengine_result_t result, const char* error_msg);
-
-/** Non-zero if an inventory refresh is currently in progress */
-int ogengine_sync_inventory_in_progress(void);
-
-/* ---------------------------------------------------------------------------
- * One-shot sync of a single local item (has_item then add_item if missing).
- * Can be called from main thread; use for immediate sync when e.g. player picks up a key.
- * --------------------------------------------------------------------------- */
-ogengine_result_t ogengine_sync_single_item(
-    const char* name,
-    const char* description,
-    const char* game_source,
-    const char* item_type,
-    const char* nft_id  /* NULL or empty for non-NFT items */
-);
-
-/* ---------------------------------------------------------------------------
- * Async send item (to avatar or clan) - same background-thread pattern as auth/inventory.
- * --------------------------------------------------------------------------- */
-
-/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees send finished. In the callback, call ogengine_sync_send_item_get_result() to get success/error. */
-typedef void (*ogengine_sync_send_item_on_done_fn)(void* user_data);
-
-/** Start send-item on a background thread. to_clan: 1 = send to clan, 0 = send to avatar. item_id can be NULL. When done, on_done(user_data) is invoked from main thread in ogengine_sync_pump(). Pass NULL to use polling. */
-void ogengine_sync_send_item_start(const char* target, const char* item_name, int quantity, int to_clan, const char* item_id, ogengine_sync_send_item_on_done_fn on_done, void* user_data);
-
-/** Returns: 0 = in progress, 1 = finished (call ogengine_sync_send_item_get_result), -1 = not started / no result. Only needed if not using callbacks. */
-int ogengine_sync_send_item_poll(void);
-
-/** Get result after poll returned 1. success_out: 1 = success, 0 = failure. Returns 1 if result was consumed. */
-int ogengine_sync_send_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size);
-
-/** Non-zero if a send is currently in progress */
-int ogengine_sync_send_item_in_progress(void);
-
-/* ---------------------------------------------------------------------------
- * Async use item (e.g. door/key) - runs on background thread so API is off main thread.
- * --------------------------------------------------------------------------- */
-
-/** Optional completion callback: invoked from main thread when ogengine_sync_pump() sees use-item finished. */
-typedef void (*ogengine_sync_use_item_on_done_fn)(void* user_data);
-
-/** Start use-item on a background thread. When done, on_done(user_data) is invoked from main thread in ogengine_sync_pump(). Pass NULL for polling. */
-void ogengine_sync_use_item_start(const char* item_name, const char* context, ogengine_sync_use_item_on_done_fn on_done, void* user_data);
-
-/** Get result after use-item finished. success_out: 1 = success, 0 = failure. Returns 1 if result was consumed. */
-int ogengine_sync_use_item_get_result(int* success_out, char* error_msg_buf, size_t error_msg_size);
-
-/** Non-zero if a use-item is currently in progress */
-int ogengine_sync_use_item_in_progress(void);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* STAR_SYNC_H */
@@ -114,8 +114,21 @@ void ogengine_refresh_avatar_profile(void) {
 #endif
 #endif
 
-/* OGLib: runtime session forwarders, config, beamin, cross-game utilities. */
+/* OGLib: runtime session forwarders, config, beamin, cross-game utilities.
+ * OGLIB_LOG_ASYNC: oglib_log and star_api.log lines go through the OGLib ring buffer; a flusher thread does the file I/O.
+ * OGLIB_LOG_MIN_LEVEL: keep DEBUG; hot-path OGLIB_LOGD lines are gated on star debug at the call site and compile out with -DOGLIB_LOG_COMPILE_LEVEL=1.
+ * OGLIB_TRACE_ENABLE: spans/instants for "star trace" (recording stays off until "star trace on"). */
 #define OGLIB_SESSION_IMPL
+#define OGLIB_CONFIG_IMPL
+#define OGLIB_BEAMIN_IMPL
+#define OGLIB_LOG_IMPL
+#define OGLIB_LOG_ASYNC
+#define OGLIB_TRACE_IMPL
+#define OGLIB_TRACE_ENABLE
+#define OGLIB_EVENTS_IMPL
+#ifndef OGLIB_LOG_MIN_LEVEL
+#define OGLIB_LOG_MIN_LEVEL OGLIB_LOG_DEBUG
+#endif
 #include "../../OGLib/oglib.h"
 
 #ifdef OQUAKE_DRAW_STRING_COLORED
@@ -129,10 +142,12 @@ extern void Draw_StringColored(cb_context_t* cbx, float x, float y, int palette_
 /* Forward declare callbacks so they can be used before their definitions. */
 static void OQ_OnSendItemDone(void* user_data);
 static void OQ_SaveStarConfigToFiles(void);
-static void OQ_PickupLog(const char* fmt, ...);
 static void OQ_StarDebugLog(const char* fmt, ...);
+static void OQ_AsyncLogLine(oglib_log_level_t level, const char* msg, void* user);
 static int OQ_SelectPersistableObjectiveId(const char* quest_id, const char* preferred_id, char* out_id, size_t out_size);
 static qboolean g_star_debug_logging = false;
+/** Pickup intercept trace (star debug only). Runs on every touch, so it is queued on the async log rather than printed to the console. */
+#define OQ_PickupLog(...) do { if (g_star_debug_logging) OGLIB_LOGD("[OQuake pickup] " __VA_ARGS__); } while (0)
 
 /* OGLib provides oglib_str_contains_nocase — alias for call-site compat. */
 #define OQ_ContainsNoCase(h, n) oglib_str_contains_nocase(h, n)
@@ -187,6 +202,10 @@ static int g_star_beamed_in = 0;
 static int g_star_refresh_xp_called_this_session = 0;
 /** Set by STAR API callback when profile refresh (XP + active quest/objective) completes. Main thread reads this in OQuake_STAR_PollItems and restores tracker + invalidates quest cache. */
 static volatile int g_star_profile_loaded_pending = 0;
+/** Set when beam-in launched profile, inventory and quests together (oglib_beamin_prefetch); the ProfileLoaded handler then skips re-requesting them. */
+static int g_star_beamin_prefetched = 0;
+/** Beam-in state machine (OGLib): armed on auth success / session restore, fed from the operation callback, polled after the sync pump. done_cb is OQ_OnBeaminDone. */
+static oglib_beamin_ctx_t g_oq_beamin;
 /** True when async SSO auth was started (star beamin); cleared when OQ_OnAuthDone runs or timeout. Used to show timeout error if callback never fires. */
 static int g_star_async_auth_pending = 0;
 /* Wall-clock start for async beamin; do not use frame counts (high FPS caused ~7s false timeouts). */
@@ -377,10 +396,12 @@ static char g_inventory_saved_down_bind[128] __attribute__((unused));
 static char g_inventory_saved_left_bind[128] __attribute__((unused));
 static char g_inventory_saved_right_bind[128] __attribute__((unused));
 static char g_inventory_saved_all_binds[MAX_KEYS][128];
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
 /* Pending use-item from overlay (E key): applied in callback after async use completes so inventory refresh shows correct qty/removal. */
 static char g_oq_use_pending_name[256];
 static char g_oq_use_pending_type[64];
 static char g_oq_use_pending_description[512];
+#endif
 /* When we apply health/armor from overlay (use-item), set these so OnStatsChangedEx does not re-add the same item (sync/refresh would otherwise add +1 again). */
 static double g_oq_health_applied_from_overlay_time = 0.0;
 static double g_oq_armor_applied_from_overlay_time = 0.0;
@@ -480,7 +501,9 @@ static int OQ_ItemMatchesTab(const oquake_inventory_entry_t* item, int tab);
 static void OQ_RefreshInventoryCache(void);
 static void OQ_RefreshOverlayFromClient(void);
 static void OQ_ClampSelection(int filtered_count);
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
 static void OQ_OnUseItemFromOverlayDone(void* user_data);
+#endif
 static void OQ_SetToastMessage(const char* msg);
 static void OQ_UseHealth_f(void);
 static void OQ_UseArmor_f(void);
@@ -994,6 +1017,7 @@ static void OQ_ApplyHealthOrArmor(const char* name, const char* type, const char
     }
 }
 
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
 /** Called from main thread by ogengine_sync_pump() when use-item from overlay (E key) completes. Apply health/armor and refresh so qty/removal is correct (like ODOOM). */
 static void OQ_OnUseItemFromOverlayDone(void* user_data) {
     int success = 0;
@@ -1014,6 +1038,96 @@ static void OQ_OnUseItemFromOverlayDone(void* user_data) {
     if (success)
         OQ_RefreshOverlayFromClient();
 }
+#else
+/* Optimistic use: health/armor and the overlay quantity change on the key press; a rejected use is undone.
+ * One slot per use the server has not answered; apply claims it, commit/rollback free it. */
+typedef struct oq_optimistic_use_s {
+    int in_use;
+    int applied;
+    char type[64];
+    char description[512];
+    int health_gain;
+    int armor_gain;
+} oq_optimistic_use_t;
+
+static oq_optimistic_use_t g_oq_optimistic_uses[OGENGINE_SYNC_MAX_PENDING_USES];
+
+/** Take one of name off the overlay list now; rebuilds keep it off via ogengine_sync_use_item_adjust_list until the server answers. */
+static void OQ_TakeOneFromOverlay(const char* name) {
+    int i;
+    for (i = 0; i < g_inventory_count; i++) {
+        if (q_strcasecmp(g_inventory_entries[i].name, name) != 0) continue;
+        if (--g_inventory_entries[i].quantity <= 0) {
+            memmove(&g_inventory_entries[i], &g_inventory_entries[i + 1], (size_t)(g_inventory_count - i - 1) * sizeof(g_inventory_entries[0]));
+            g_inventory_count--;
+        }
+        return;
+    }
+}
+
+static int OQ_OptimisticUseApply(const char* name, void* user_data) {
+    oq_optimistic_use_t* use = (oq_optimistic_use_t*)user_data;
+    int health = cl.stats[STAT_HEALTH], armor = cl.stats[STAT_ARMOR];
+    use->in_use = 1;
+    use->applied = 1;
+    OQ_ApplyHealthOrArmor(name, use->type, use->description);
+    use->health_gain = cl.stats[STAT_HEALTH] - health;
+    use->armor_gain = cl.stats[STAT_ARMOR] - armor;
+    OQ_TakeOneFromOverlay(name);
+    q_snprintf(g_inventory_status, sizeof(g_inventory_status), "Used item: %s", name);
+    return 1;
+}
+
+static void OQ_OptimisticUseCommit(const char* name, void* user_data) {
+    OQ_StarDebugLog("UseItem confirmed: name='%s'", name);
+    ((oq_optimistic_use_t*)user_data)->in_use = 0;
+    OQ_RefreshOverlayFromClient();
+}
+
+static void OQ_OptimisticUseRollback(const char* name, const char* error, void* user_data) {
+    oq_optimistic_use_t* use = (oq_optimistic_use_t*)user_data;
+    char msg[384];
+    cl.stats[STAT_HEALTH] -= use->health_gain;
+    if (cl.stats[STAT_HEALTH] < 1) cl.stats[STAT_HEALTH] = 1;
+    cl.stats[STAT_ARMOR] -= use->armor_gain;
+    if (cl.stats[STAT_ARMOR] < 0) cl.stats[STAT_ARMOR] = 0;
+    OQ_StarDebugLog("UseItem rejected: name='%s' err='%s' (undid +%d health, +%d armor)", name, error, use->health_gain, use->armor_gain);
+    q_snprintf(msg, sizeof(msg), "Use of %s failed: %s", name, error);
+    q_strlcpy(g_inventory_status, msg, sizeof(g_inventory_status));
+    OQ_SetToastMessage(msg);
+    use->in_use = 0;
+    OQ_RefreshOverlayFromClient();
+}
+
+static const ogengine_sync_use_effect_t g_oq_use_effect = { OQ_OptimisticUseApply, OQ_OptimisticUseCommit, OQ_OptimisticUseRollback };
+#endif
+
+/** Start use-item for an overlay entry. Optimistic when the sync layer supports it; otherwise applied in OQ_OnUseItemFromOverlayDone. */
+static void OQ_StartUseItem(const oquake_inventory_entry_t* item, const char* context) {
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+    char name[256];
+    oq_optimistic_use_t* use = NULL;
+    int i;
+    for (i = 0; i < OGENGINE_SYNC_MAX_PENDING_USES && !use; i++)
+        if (!g_oq_optimistic_uses[i].in_use) use = &g_oq_optimistic_uses[i];
+    if (use) {
+        use->applied = 0;
+        q_strlcpy(name, item->name, sizeof(name));  /* item points into the overlay list, which apply edits */
+        q_strlcpy(use->type, item->item_type, sizeof(use->type));
+        q_strlcpy(use->description, item->description, sizeof(use->description));
+        OQ_StarDebugLog("UseItem: optimistic name='%s' context=%s", name, context);
+        ogengine_sync_use_item_optimistic(name, context, 0, &g_oq_use_effect, use);
+    }
+    /* Queue full rolls back with its own message; only a use that never applied needs one here. */
+    if (!use || !use->applied)
+        q_strlcpy(g_inventory_status, "Too many uses waiting for STAR; try again.", sizeof(g_inventory_status));
+#else
+    q_strlcpy(g_oq_use_pending_name, item->name, sizeof(g_oq_use_pending_name));
+    q_strlcpy(g_oq_use_pending_type, item->item_type, sizeof(g_oq_use_pending_type));
+    q_strlcpy(g_oq_use_pending_description, item->description, sizeof(g_oq_use_pending_description));
+    ogengine_sync_use_item_start(item->name, context, OQ_OnUseItemFromOverlayDone, NULL);
+#endif
+}
 
 static void OQ_UseSelectedItem(void)
 {
@@ -1045,17 +1159,18 @@ static void OQ_UseSelectedItem(void)
             q_strlcpy(g_inventory_status, toast_msg, sizeof(g_inventory_status));
         return;
     }
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+    OQ_StartUseItem(item, "inventory_overlay");
+#else
     if (ogengine_sync_use_item_in_progress()) {
         q_strlcpy(g_inventory_status, "Use in progress...", sizeof(g_inventory_status));
         OQ_StarDebugLog("UseItem (E key): blocked (use already in progress)");
         return;
     }
-    q_strlcpy(g_oq_use_pending_name, item->name, sizeof(g_oq_use_pending_name));
-    q_strlcpy(g_oq_use_pending_type, item->item_type, sizeof(g_oq_use_pending_type));
-    q_strlcpy(g_oq_use_pending_description, item->description, sizeof(g_oq_use_pending_description));
     OQ_StarDebugLog("UseItem (E key): starting async name='%s' type='%s' context=inventory_overlay", item->name, item->item_type[0] ? item->item_type : "");
-    ogengine_sync_use_item_start(item->name, "inventory_overlay", OQ_OnUseItemFromOverlayDone, NULL);
     q_snprintf(g_inventory_status, sizeof(g_inventory_status), "Using: %s...", item->name);
+    OQ_StartUseItem(item, "inventory_overlay");
+#endif
 }
 
 /** First health item in g_inventory_entries (Health, Megahealth, or Stimpack). Returns NULL if none. */
@@ -1106,7 +1221,9 @@ static void OQ_UseHealth_f(void) {
     const char* toast_msg = NULL;
     OQ_StarDebugLog("UseHealth (C key): invoked");
     if (!g_star_initialized) { Con_Printf("STAR not initialized. Use star beamin.\n"); OQ_StarDebugLog("UseHealth: skip (not initialized)"); return; }
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
     if (ogengine_sync_use_item_in_progress()) { Con_Printf("Use in progress...\n"); OQ_StarDebugLog("UseHealth: skip (use in progress)"); return; }
+#endif
     OQ_RefreshOverlayFromClient();
     const oquake_inventory_entry_t* item = OQ_FindFirstHealthEntry();
     if (!item) { Con_Printf("No health item in STAR inventory.\n"); OQ_StarDebugLog("UseHealth: no health item found (g_inventory_count=%d)", g_inventory_count); return; }
@@ -1116,19 +1233,18 @@ static void OQ_UseHealth_f(void) {
         OQ_StarDebugLog("UseHealth: blocked (would exceed max) msg='%s'", toast_msg ? toast_msg : "");
         return;
     }
-    q_strlcpy(g_oq_use_pending_name, item->name, sizeof(g_oq_use_pending_name));
-    q_strlcpy(g_oq_use_pending_type, item->item_type, sizeof(g_oq_use_pending_type));
-    q_strlcpy(g_oq_use_pending_description, item->description, sizeof(g_oq_use_pending_description));
     OQ_StarDebugLog("UseHealth: starting async name='%s' context=oquake_use_health", item->name);
-    ogengine_sync_use_item_start(item->name, "oquake_use_health", OQ_OnUseItemFromOverlayDone, NULL);
     Con_Printf("Using: %s...\n", item->name);
+    OQ_StartUseItem(item, "oquake_use_health");
 }
 
 static void OQ_UseArmor_f(void) {
     const char* toast_msg = NULL;
     OQ_StarDebugLog("UseArmor (F key): invoked");
     if (!g_star_initialized) { Con_Printf("STAR not initialized. Use star beamin.\n"); OQ_StarDebugLog("UseArmor: skip (not initialized)"); return; }
+#ifndef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
     if (ogengine_sync_use_item_in_progress()) { Con_Printf("Use in progress...\n"); OQ_StarDebugLog("UseArmor: skip (use in progress)"); return; }
+#endif
     OQ_RefreshOverlayFromClient();
     const oquake_inventory_entry_t* item = OQ_FindFirstArmorEntry();
     if (!item) { Con_Printf("No armor item in STAR inventory.\n"); OQ_StarDebugLog("UseArmor: no armor item found (g_inventory_count=%d)", g_inventory_count); return; }
@@ -1138,12 +1254,9 @@ static void OQ_UseArmor_f(void) {
         OQ_StarDebugLog("UseArmor: blocked (would exceed max) msg='%s'", toast_msg ? toast_msg : "");
         return;
     }
-    q_strlcpy(g_oq_use_pending_name, item->name, sizeof(g_oq_use_pending_name));
-    q_strlcpy(g_oq_use_pending_type, item->item_type, sizeof(g_oq_use_pending_type));
-    q_strlcpy(g_oq_use_pending_description, item->description, sizeof(g_oq_use_pending_description));
     OQ_StarDebugLog("UseArmor: starting async name='%s' context=oquake_use_armor", item->name);
-    ogengine_sync_use_item_start(item->name, "oquake_use_armor", OQ_OnUseItemFromOverlayDone, NULL);
     Con_Printf("Using: %s...\n", item->name);
+    OQ_StartUseItem(item, "oquake_use_armor");
 }
 
 static void OQ_HandleSendPopupTyping(void)
@@ -1285,9 +1398,11 @@ static void OQ_OnAuthDone(void* user_data) {
         //     g_star_refresh_xp_called_this_session = 1;
         //     ogengine_refresh_avatar_xp();
         // }
-        /* Load avatar (XP + active quest/objective) and restore tracker state. */
-        ogengine_refresh_avatar_profile();
-        ogengine_log_to_file("[OQuake] Beamin (auth callback): profile refresh started");
+        /* Load avatar (XP + active quest/objective), inventory and quests in parallel and restore tracker state. */
+        oglib_beamin_begin(&g_oq_beamin, OGLIB_BEAMIN_STATE_PREFETCHING, username);
+        oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+        g_star_beamin_prefetched = 1;
+        ogengine_log_to_file("[OQuake] Beamin (auth callback): profile, inventory and quest fetch started");
         {
             char qid[64] = {0};
             char oid[64] = {0};
@@ -1324,6 +1439,7 @@ static void OQ_OnAuthDone(void* user_data) {
 /** Operation callback: only treat as "profile loaded" when operation_type is OGENGINE_OP_PROFILE_LOADED. Log only ProfileLoaded to file (not GET_INVENTORY failures) to avoid spam. */
 static void OQ_StarApiOperationCallback(ogengine_result_t result, int operation_type, void* user_data) {
     (void)user_data;
+    oglib_beamin_on_operation(&g_oq_beamin, result, operation_type);  /* atomics only; a rejected restore is reported from OQ_OnBeaminDone on the main thread */
     if (operation_type == OGENGINE_OP_PROFILE_LOADED) {
         char buf[160];
         q_snprintf(buf, sizeof(buf), "[OQuake] STAR API operation_callback result=%d op=%d (%s)", (int)result, operation_type, result == OGENGINE_SUCCESS ? "Success" : "other");
@@ -1331,9 +1447,6 @@ static void OQ_StarApiOperationCallback(ogengine_result_t result, int operation_
     }
     if (operation_type == OGENGINE_OP_PROFILE_LOADED && result == OGENGINE_SUCCESS)
         g_star_profile_loaded_pending = 1;
-    if (operation_type == OGENGINE_OP_PROFILE_LOADED && result != OGENGINE_SUCCESS) {
-        Con_Printf("Session restore failed (session may have expired). Use 'star beamin' to log in again.\n");
-    }
     if (operation_type == OGENGINE_OP_GET_INVENTORY) {
         ogengine_item_list_t* list = NULL;
         const char* err_msg = NULL;
@@ -1349,6 +1462,31 @@ static void OQ_StarApiOperationCallback(ogengine_result_t result, int operation_
     }
 }
 
+/** Called from main thread by oglib_beamin_poll() once profile, stats, inventory and quests have all reported (or timed out), or the saved JWT was rejected. */
+static void OQ_OnBeaminDone(oglib_beamin_result_t result, const char* username, void* user_data) {
+    (void)user_data;
+    if (result == OGLIB_BEAMIN_OK) {
+        char logb[192];
+        /* XP/karma can land after the inventory callback; refresh the overlay once with the full set. */
+        g_inventory_refresh_pending = 1;
+        q_snprintf(logb, sizeof(logb), "[OQuake] Beamin ready for %s: profile, stats, inventory and quests loaded", username ? username : "(avatar)");
+        ogengine_log_to_file(logb);
+        return;
+    }
+    if (result == OGLIB_BEAMIN_TIMEOUT) {
+        Con_Printf("Session restore timed out (no response from server). Use 'star beamin' to log in again.\n");
+        return;
+    }
+    /* JWT rejected: drop the dead session so the next launch does not restore it again. */
+    g_oq_saved_jwt[0] = '\0';
+    g_oq_saved_refresh_token[0] = '\0';
+    g_star_initialized = 0;
+    g_star_beamed_in = 0;
+    OQ_SaveStarConfigToFiles();
+    ogengine_log_to_file("[OQuake] Session restore rejected: saved session cleared");
+    Con_Printf("Session restore failed (session may have expired). Use 'star beamin' to log in again.\n");
+}
+
 /** Called from main thread by ogengine_sync_pump() when send-item completes. */
 static void OQ_OnSendItemDone(void* user_data) {
     int success = 0;
@@ -1385,7 +1523,11 @@ static void OQ_RefreshOverlayFromClient(void) {
         g_inventory_refresh_pending = 0;
         g_inventory_count = 0;
         if (ogengine_get_inventory(&list) == OGENGINE_SUCCESS && list) {
-            size_t i, n = list->count;
+            size_t i, n;
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+            ogengine_sync_use_item_adjust_list(list);  /* uses the server has not answered yet */
+#endif
+            n = list->count;
             /* Defensive: avoid null deref or huge loop if C# returns bad data */
             if (list->items && n <= OQ_MAX_INVENTORY_ITEMS * 2) {
                 for (i = 0; i < n && g_inventory_count < OQ_MAX_INVENTORY_ITEMS; i++) {
@@ -1425,7 +1567,11 @@ static void OQ_RefreshOverlayFromClient(void) {
         /* Already have items or request in flight: re-read from cache so pickups (add_item merged in C#) show up. */
         ogengine_item_list_t* list = NULL;
         if (ogengine_get_inventory(&list) == OGENGINE_SUCCESS && list && list->items) {
-            size_t i, n = list->count;
+            size_t i, n;
+#ifdef OGENGINE_SYNC_HAS_OPTIMISTIC_USE
+            ogengine_sync_use_item_adjust_list(list);
+#endif
+            n = list->count;
             if (n > OQ_MAX_INVENTORY_ITEMS * 2) n = OQ_MAX_INVENTORY_ITEMS * 2;
             g_inventory_count = 0;
             for (i = 0; i < n && g_inventory_count < OQ_MAX_INVENTORY_ITEMS; i++) {
@@ -2027,11 +2173,8 @@ static int OQ_TryApplyCrossGameBeamInTransfers(void) {
             if (!OQ_CrossGameApplyQuakeAmmoFromDoom(mapped, qty)) continue;
             ammo_applied++;
             applied = 1;
-            if (g_star_debug_logging) {
-                char logb[384];
-                q_snprintf(logb, sizeof(logb), "[OQuake] Cross-game beam-in: +%d %s (from Doom \"%s\") -> local %s", qty, base, raw_name, mapped);
-                ogengine_log_to_file(logb);
-            }
+            if (g_star_debug_logging)
+                OGLIB_LOGD("[OQuake] Cross-game beam-in: +%d %s (from Doom \"%s\") -> local %s", qty, base, raw_name, mapped);
         }
         if (ammo_applied > 0)
             g_oq_cross_grant_suppress_ammo_star = 5;
@@ -2093,11 +2236,8 @@ static int OQ_TryApplyCrossGameBeamInTransfers(void) {
             applied = 1;
             if (OQ_CrossGameLogEnabled())
                 OQ_CrossGameDbgPrintf("give weapon: \"%s\" -> %s (give %s, dm=%d)", raw_name, mapped, giv, deathmatch.value != 0);
-            if (g_star_debug_logging) {
-                char logb[384];
-                q_snprintf(logb, sizeof(logb), "[OQuake] Cross-game beam-in: weapon \"%s\" -> %s (give %s)", raw_name, mapped, giv);
-                ogengine_log_to_file(logb);
-            }
+            if (g_star_debug_logging)
+                OGLIB_LOGD("[OQuake] Cross-game beam-in: weapon \"%s\" -> %s (give %s)", raw_name, mapped, giv);
         }
         if (weapon_gives > 0)
             g_oq_cross_grant_suppress_weapon_star = 4;
@@ -2791,7 +2931,17 @@ static void OQ_StarConfig_f(void) {
 }
 
 void OQuake_STAR_Init(void) {
+    oglib_log_async_config_t log_cfg;
+    memset(&log_cfg, 0, sizeof(log_cfg));
+    log_cfg.echo_stderr = g_star_debug_logging ? 1 : 0;  /* follows star debug on|off */
+    log_cfg.line_fn = OQ_AsyncLogLine;
+    oglib_log_async_start(&log_cfg);
+    oglib_trace_set_thread_name("main");
+    oglib_session_init(); /* resolve OGEngineClient exports once; logs any missing */
     ogengine_sync_init();
+#ifdef OGENGINE_SYNC_HAS_TRACE_CB
+    ogengine_sync_set_trace_cb(oglib_trace_sync_hook, NULL);
+#endif
     ogengine_sync_set_add_item_log_cb(OQ_AddItemLogCb, NULL);
     ogengine_result_t result;
     const char* username;
@@ -3374,6 +3524,7 @@ void OQuake_STAR_Init(void) {
         printf("OQuake STAR API: Failed to initialize: %s\n", ogengine_get_last_error());
     } else {
         ogengine_set_operation_callback(OQ_StarApiOperationCallback, NULL);
+        g_oq_beamin.done_cb = OQ_OnBeaminDone;
         /* Always (re)apply WEB4 OASIS URL so auth/refresh use the correct host. Required for token auto-renew on restore. */
         {
             const char *oasis_url = oquake_oasis_api_url.string;
@@ -3414,8 +3565,10 @@ void OQuake_STAR_Init(void) {
                 g_star_initialized = 1;
                 g_star_beamed_in = 1;
                 OQ_ResetCrossGameBeamTransferState();
-                ogengine_refresh_avatar_profile();
-                ogengine_log_to_file("[OQuake] Init (username+password): beamed_in=1, profile refresh started");
+                oglib_beamin_begin(&g_oq_beamin, OGLIB_BEAMIN_STATE_PREFETCHING, username);
+                oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+                g_star_beamin_prefetched = 1;
+                ogengine_log_to_file("[OQuake] Init (username+password): beamed_in=1, profile, inventory and quest fetch started");
                 printf("OQuake STAR API: Authenticated. Cross-game assets enabled.\n");
             } else {
                 printf("OQuake STAR API: SSO failed: %s\n", ogengine_get_last_error());
@@ -3439,7 +3592,14 @@ void OQuake_STAR_Init(void) {
                 OQ_ResetCrossGameBeamTransferState();
                 if (g_oq_saved_username[0])
                     q_strlcpy(g_star_username, g_oq_saved_username, sizeof(g_star_username));
-                ogengine_restore_session();
+                /* Armed before the request so its ProfileLoaded is not missed; inventory, quests and stats go out alongside it. */
+                oglib_beamin_begin(&g_oq_beamin, OGLIB_BEAMIN_STATE_RESTORING, g_oq_saved_username);
+                if (ogengine_restore_session() == OGENGINE_SUCCESS) {
+                    oglib_beamin_prefetch(OGLIB_BEAMIN_FETCH_ALL);
+                    g_star_beamin_prefetched = 1;
+                } else {
+                    oglib_beamin_reset(&g_oq_beamin);
+                }
                 ogengine_log_to_file("[OQuake] Init (saved session): restore started, profile load will set beamed_in");
                 printf("OQuake STAR API: Restoring saved session for %s...\n", g_oq_saved_username[0] ? g_oq_saved_username : "(avatar)");
             } else {
@@ -3466,6 +3626,8 @@ void OQuake_STAR_Init(void) {
 
 void OQuake_STAR_Cleanup(void) {
     OQ_SaveStarConfigToFiles(); /* persist any STAR option changes on exit */
+    /* Drain queued lines into star_api.log while the client can still take them; anything logged after this is a direct write. */
+    oglib_log_async_stop();
     ogengine_sync_cleanup();
     if (g_star_initialized) {
         ogengine_cleanup();
@@ -3534,30 +3696,26 @@ void OQuake_STAR_OnMonsterKilled(const char* monster_name) {
     int do_mint;
     const char* prov;
     int idx;
-    char star_log_buf[256];
     if (!monster_name || !monster_name[0]) {
         Con_Printf("OQuake STAR: OnMonsterKilled called with empty name (hook may be mis-installed)\n");
         return;
     }
     if (!g_star_initialized) {
         Con_Printf("OQuake STAR: monster \"%s\" killed but not beamed in (no XP/mint)\n", monster_name);
-        snprintf(star_log_buf, sizeof(star_log_buf), "OQUAKE: monster \"%s\" killed but not beamed in (no XP/mint)", monster_name);
-        ogengine_log_to_file(star_log_buf);
+        OGLIB_LOG_EVERY_MS(5000, OGLIB_LOG_WARN, "OQUAKE: monster \"%s\" killed but not beamed in (no XP/mint)", monster_name);
         return;
     }
     e = OQ_FindMonsterByEngineName(monster_name);
     if (!e) {
         Con_Printf("OQuake STAR: unknown monster \"%s\" (no XP/mint)\n", monster_name);
-        snprintf(star_log_buf, sizeof(star_log_buf), "OQUAKE: unknown monster \"%s\" (no XP/mint)", monster_name);
-        ogengine_log_to_file(star_log_buf);
+        OGLIB_LOG_EVERY_MS(5000, OGLIB_LOG_WARN, "OQUAKE: unknown monster \"%s\" (no XP/mint)", monster_name);
         return;
     }
     idx = (int)(e - OQUAKE_MONSTERS);
     do_mint = OQ_ShouldMintMonster(idx) ? 1 : 0;
     prov = oquake_star_nft_provider.string && oquake_star_nft_provider.string[0] ? oquake_star_nft_provider.string : "SolanaOASIS";
     Con_Printf("OQuake STAR: monster kill queued: %s (%d XP, mint=%d)\n", e->display_name, e->xp, do_mint);
-    snprintf(star_log_buf, sizeof(star_log_buf), "OQUAKE: monster kill queued: %s (%d XP, mint=%d)", e->display_name, e->xp, do_mint);
-    ogengine_log_to_file(star_log_buf);
+    OGLIB_LOGI("OQUAKE: monster kill queued: %s (%d XP, mint=%d)", e->display_name, e->xp, do_mint);
     ogengine_queue_monster_kill(e->engine_name, e->display_name, e->xp, e->is_boss, do_mint, prov, "OQUAKE");
 }
 
@@ -3787,12 +3945,8 @@ static void OQ_QuestApplyKForQuestRow(const char* quest_id, const char* qstatus,
         q_strlcpy(g_quest_tracker_id, quest_id, sizeof(g_quest_tracker_id));
         q_strlcpy(g_quest_tracker_name, display_name && display_name[0] ? display_name : "", sizeof(g_quest_tracker_name));
         g_quest_tracker_show = 1;
-        {
-            static char log_buf[512];
-            const char* qn = g_quest_tracker_name[0] ? g_quest_tracker_name : "(none)";
-            q_snprintf(log_buf, sizeof(log_buf), "[Quest] SAVE (K) quest_id=%s objective_id=%s quest_name=%s", g_quest_tracker_id, g_quest_tracker_active_objective_id, qn);
-            ogengine_log_to_file(log_buf);
-        }
+        OGLIB_LOGI("[Quest] SAVE (K) quest_id=%s objective_id=%s quest_name=%s", g_quest_tracker_id, g_quest_tracker_active_objective_id,
+                   g_quest_tracker_name[0] ? g_quest_tracker_name : "(none)");
         ogengine_set_active_quest(g_quest_tracker_id, NULL);
     }
 }
@@ -3817,17 +3971,17 @@ static int OQ_StrStartsWithNoCase(const char* str, const char* prefix) {
     return 1;
 }
 
-/** Log pickup intercept to console and STAR log file when star debug is on. */
-static void OQ_PickupLog(const char* fmt, ...) {
-    char buf[384];
-    va_list ap;
-    va_start(ap, fmt);
-    vsnprintf(buf, sizeof(buf), fmt, ap);
-    va_end(ap);
-    if (g_star_debug_logging) {
-        Con_Printf("[OQuake pickup] %s\n", buf);
-        ogengine_log_to_file(buf);
-    }
+/** Flusher-thread side of the async log: forwards each line to star_api.log. */
+static void OQ_AsyncLogLine(oglib_log_level_t level, const char* msg, void* user) {
+    (void)level;
+    (void)user;
+    ogengine_log_to_file(msg);
+}
+
+/** Append to star_api.log without blocking the game thread (direct write if the async log is not running or full). */
+static void OQ_LogToFile(const char* msg) {
+    if (!oglib_log_enqueue(OGLIB_LOG_INFO, msg))
+        ogengine_log_to_file(msg);
 }
 
 /** Log to console and star_api.log only when star debug is on. Use for use-item, C/F keys, config, and general STAR flow tracking. */
@@ -3839,7 +3993,7 @@ static void OQ_StarDebugLog(const char* fmt, ...) {
     vsnprintf(buf, sizeof(buf), fmt, ap);
     va_end(ap);
     Con_Printf("[STAR debug] %s\n", buf);
-    ogengine_log_to_file(buf);
+    OQ_LogToFile(buf);
 }
 
 /**
@@ -4143,8 +4297,44 @@ static void OQ_PollCaptureItemStatsBaseline(
     *poll_prev_valid = 1;
 }
 
-/* Frame-based item/stats poll so pickups are reported even when sbar isn't drawn. Call from Host_Frame. */
-void OQuake_STAR_PollItems(void) {
+/* Cross-game spawn: entity_id is the native Quake classname (e.g. "monster_cacodemon"). Spawns near the player when coords are zero. */
+static void OQ_SpawnCrossGameEntity(const char *entity_id, float sx, float sy, float sz)
+{
+    extern server_t sv;
+    extern edict_t *sv_player;
+    edict_t *ent;
+    if (!sv.active || sv_player == NULL || !entity_id[0])
+    {
+        oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: %s (server not active — deferred)", entity_id);
+        return;
+    }
+    ent = ED_Alloc();
+    if (ent)
+    {
+        float ox = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[0] : sx;
+        float oy = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[1] : sy;
+        float oz = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[2] + 64.0f : sz;
+        dfunction_t *f;
+        ent->v.classname = PR_SetEngineString(entity_id);
+        ent->v.origin[0] = ox; ent->v.origin[1] = oy; ent->v.origin[2] = oz;
+        /* Locate and call the QC spawn function for this classname. */
+        f = ED_FindFunction(entity_id);
+        if (f)
+        {
+            pr_global_struct->self = EDICT_TO_PROG(ent);
+            PR_ExecuteProgram(f - pr_functions);
+        }
+        SV_LinkEdict(ent, false);
+        oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: spawned %s at %.0f/%.0f/%.0f", entity_id, ox, oy, oz);
+    }
+    else
+    {
+        oglib_log(OGLIB_LOG_WARN, "OASIS SpawnEvent: ED_Alloc failed for %s", entity_id);
+    }
+}
+
+/* Frame-based item/stats poll so pickups are reported even when sbar isn't drawn. Wrapped by OQuake_STAR_PollItems. */
+static void OQ_PollItemsFrame(void) {
     extern client_state_t cl;
     extern client_static_t cls;
     extern server_t sv;
@@ -4157,98 +4347,43 @@ void OQuake_STAR_PollItems(void) {
 
     /* Run async completions (auth, inventory, use_item) every frame so e.g. "star beamin" finishes even when console is open. */
     ogengine_sync_pump();
+    oglib_beamin_poll(&g_oq_beamin);
 
-    /* --- cross-game spawn poll --- */
-    {
-        char entity_id[128];
-        char entity_category[64];
-        float sx, sy, sz;
-        if (ogengine_poll_spawn_event(entity_id, sizeof(entity_id), &sx, &sy, &sz))
-        {
-            /* entity_id is the native Quake classname (e.g. "monster_cacodemon"). Spawn near the player when coords are zero. */
-            extern server_t sv;
-            extern edict_t *sv_player;
-            if (sv.active && sv_player != NULL && entity_id[0])
-            {
-                edict_t *ent = ED_Alloc();
-                if (ent)
-                {
-                    float ox = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[0] : sx;
-                    float oy = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[1] : sy;
-                    float oz = (sx == 0.0f && sy == 0.0f) ? sv_player->v.origin[2] + 64.0f : sz;
-                    ent->v.classname = PR_SetEngineString(entity_id);
-                    ent->v.origin[0] = ox; ent->v.origin[1] = oy; ent->v.origin[2] = oz;
-                    /* Locate and call the QC spawn function for this classname. */
-                    dfunction_t *f = ED_FindFunction(entity_id);
-                    if (f)
-                    {
-                        pr_global_struct->self = EDICT_TO_PROG(ent);
-                        PR_ExecuteProgram(f - pr_functions);
-                    }
-                    SV_LinkEdict(ent, false);
-                    oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: spawned %s at %.0f/%.0f/%.0f", entity_id, ox, oy, oz);
-                }
-                else
-                {
-                    oglib_log(OGLIB_LOG_WARN, "OASIS SpawnEvent: ED_Alloc failed for %s", entity_id);
-                }
-            }
-            else
-            {
-                oglib_log(OGLIB_LOG_INFO, "OASIS SpawnEvent: %s (server not active — deferred)", entity_id);
-            }
-            ogengine_confirm_spawn(entity_id);
-        }
-    }
-
-    /* --- cross-game objective event poll (ShowNarration, PlayAudio, PlayVideo, OpenWebsite, UnlockPortal) --- */
+    /* --- cross-game spawns and objective events: drained as one batch of parsed events, so a spawn wave lands this frame --- */
     {
-        char evt_json[4096];
-        while (ogengine_poll_cross_game_event(evt_json, sizeof(evt_json)))
+        static oglib_event_t s_events[OGLIB_EVENTS_BATCH];
+        int n = oglib_events_drain(s_events, OGLIB_EVENTS_BATCH);
+        int i;
+        for (i = 0; i < n; i++)
         {
-            char evt_type[64] = "";
-            char narration[512] = "";
-            char audio_url[512] = "";
-            char audio_title[128] = "";
-            char video_url[512] = "";
-            char video_title[128] = "";
-            char website_url[512] = "";
-            char portal_id[128] = "";
-            OQ_ExtractJsonValue(evt_json, "EventType", evt_type, sizeof(evt_type));
-            if (strcmp(evt_type, "ShowNarration") == 0)
-            {
-                OQ_ExtractJsonValue(evt_json, "NarrationText", narration, sizeof(narration));
-                if (narration[0]) OQ_SetToastMessage(narration);
-                oglib_log(OGLIB_LOG_INFO, "OASIS Narration: %s", narration);
-            }
-            else if (strcmp(evt_type, "PlayAudio") == 0)
+            const oglib_event_t *e = &s_events[i];
+            switch (e->kind)
             {
-                OQ_ExtractJsonValue(evt_json, "AudioUrl", audio_url, sizeof(audio_url));
-                OQ_ExtractJsonValue(evt_json, "AudioTitle", audio_title, sizeof(audio_title));
-                oasis_open_url(audio_url);
-                if (audio_title[0]) OQ_SetToastMessage(audio_title);
-                oglib_log(OGLIB_LOG_INFO, "OASIS PlayAudio: %s -> %s", audio_title, audio_url);
-            }
-            else if (strcmp(evt_type, "PlayVideo") == 0)
-            {
-                OQ_ExtractJsonValue(evt_json, "VideoUrl", video_url, sizeof(video_url));
-                OQ_ExtractJsonValue(evt_json, "VideoTitle", video_title, sizeof(video_title));
-                oasis_open_url(video_url);
-                if (video_title[0]) OQ_SetToastMessage(video_title);
-                oglib_log(OGLIB_LOG_INFO, "OASIS PlayVideo: %s -> %s", video_title, video_url);
-            }
-            else if (strcmp(evt_type, "OpenWebsite") == 0)
-            {
-                OQ_ExtractJsonValue(evt_json, "WebsiteUrl", website_url, sizeof(website_url));
-                oasis_open_url(website_url);
-                oglib_log(OGLIB_LOG_INFO, "OASIS OpenWebsite: %s", website_url);
-            }
-            else if (strcmp(evt_type, "UnlockPortal") == 0)
-            {
-                OQ_ExtractJsonValue(evt_json, "PortalId", portal_id, sizeof(portal_id));
-                ogengine_notify_portal_unlock(portal_id);
+            case OGLIB_EVENT_SPAWN:
+                OQ_SpawnCrossGameEntity(e->id, e->x, e->y, e->z);
+                ogengine_confirm_spawn(e->id);
+                break;
+            case OGLIB_EVENT_NARRATION:
+                if (e->text[0]) OQ_SetToastMessage(e->text);
+                oglib_log(OGLIB_LOG_INFO, "OASIS Narration: %s", e->text);
+                break;
+            case OGLIB_EVENT_AUDIO:
+            case OGLIB_EVENT_VIDEO:
+                oasis_open_url(e->url);
+                if (e->title[0]) OQ_SetToastMessage(e->title);
+                oglib_log(OGLIB_LOG_INFO, "OASIS %s: %s -> %s", e->kind == OGLIB_EVENT_AUDIO ? "PlayAudio" : "PlayVideo", e->title, e->url);
+                break;
+            case OGLIB_EVENT_WEBSITE:
+                oasis_open_url(e->url);
+                oglib_log(OGLIB_LOG_INFO, "OASIS OpenWebsite: %s", e->url);
+                break;
+            case OGLIB_EVENT_PORTAL_UNLOCK:
+                ogengine_notify_portal_unlock(e->id);
                 OQ_SetToastMessage("Portal unlocked!");
-                oglib_log(OGLIB_LOG_INFO, "OASIS UnlockPortal: %s", portal_id);
+                oglib_log(OGLIB_LOG_INFO, "OASIS UnlockPortal: %s", e->id);
+                break;
+            default:
+                break;
             }
         }
     }
@@ -4289,7 +4424,9 @@ void OQuake_STAR_PollItems(void) {
 
     /* When profile refresh (XP + active quest/objective) completed, restore tracker from cache and invalidate quest list so it refetches. */
     if (g_star_profile_loaded_pending) {
+        int beamin_prefetched = g_star_beamin_prefetched;
         g_star_profile_loaded_pending = 0;
+        g_star_beamin_prefetched = 0;
         g_star_beamed_in = 1;  /* Set for both auth callback and saved-session restore paths. */
         {
             char qid[64] = {0};
@@ -4313,16 +4450,15 @@ void OQuake_STAR_PollItems(void) {
                 q_strlcpy(g_quest_tracker_active_objective_id, oid, sizeof(g_quest_tracker_active_objective_id));
                 g_quest_tracker_active_display_index = -1;
             }
-            {
-                static char load_log[512];
-                q_snprintf(load_log, sizeof(load_log), "[Quest] LOAD (beam-in from API) quest_id=%s objective_id=%s (names filled when list loads)", qid[0] ? qid : "(none)", oid[0] ? oid : "(none)");
-                ogengine_log_to_file(load_log);
-            }
+            OGLIB_LOGI("[Quest] LOAD (beam-in from API) quest_id=%s objective_id=%s (names filled when list loads)", qid[0] ? qid : "(none)", oid[0] ? oid : "(none)");
+        }
+        /* After beam-in these were already requested alongside the profile (oglib_beamin_prefetch); invalidating now would drop that quest list. */
+        if (!beamin_prefetched) {
+            ogengine_invalidate_quest_cache();
+            ogengine_refresh_quest_cache_in_background();  /* Start loading quest list so tracker can show name without opening popup */
+            ogengine_request_inventory_in_background();    /* Start loading inventory so overlay and door checks have cache */
+            ogengine_log_to_file("[OQuake] Profile loaded: quest cache invalidated, list will refetch");
         }
-        ogengine_invalidate_quest_cache();
-        ogengine_refresh_quest_cache_in_background();  /* Start loading quest list so tracker can show name without opening popup */
-        ogengine_request_inventory_in_background();    /* Start loading inventory so overlay and door checks have cache */
-        ogengine_log_to_file("[OQuake] Profile loaded: quest cache invalidated, list will refetch");
         /* Persist session to oasisstar.json now so we stay logged in even if the game crashes before exit. */
         OQ_SaveStarConfigToFiles();
     }
@@ -4437,6 +4573,13 @@ void OQuake_STAR_PollItems(void) {
     poll_prev_valid = 1;
 }
 
+/* Frame-based item/stats poll so pickups are reported even when sbar isn't drawn. Call from Host_Frame. */
+void OQuake_STAR_PollItems(void) {
+    OGLIB_TRACE_BEGIN("OQuake_STAR_PollItems", "oquake");
+    OQ_PollItemsFrame();
+    OGLIB_TRACE_END("OQuake_STAR_PollItems", "oquake");
+}
+
 /** Called from main thread by ogengine_sync_pump() when use-item (door key) completes. */
 static void OQ_OnUseItemDone(void* user_data) {
     int success = 0;
@@ -4548,6 +4691,7 @@ void OQuake_STAR_Console_f(void) {
         Con_Printf("  star pickup all <0|1> - 1=always add to STAR even when engine uses it, 0=only when at max\n");
         Con_Printf("  star pickup keycard <silver|gold> - Add key to STAR inventory (admin only)\n");
         Con_Printf("  star debug on|off|status - Toggle STAR debug logging\n");
+        Con_Printf("  star trace on|off|dump [file] - Record OASIS spans; dump writes Chrome/Perfetto JSON\n");
         Con_Printf("  CVAR oquake_star_cross_game_log 1 - Log Doom->Quake beam transfer (console + star log)\n");
         Con_Printf("  Keys X / B - Toggle XP HUD / Beamed In line (like ODOOM; B N/A while quest popup open)\n");
         Con_Printf("  star send_avatar <user> <item_class> - Send item to avatar\n");
@@ -4738,6 +4882,26 @@ void OQuake_STAR_Console_f(void) {
         Con_Printf(r == OGENGINE_SUCCESS ? "NFT deploy requested.\n" : "Failed: %s\n", ogengine_get_last_error());
         return;
     }
+    if (strcmp(sub, "trace") == 0) {
+        const char* opt = argc >= 3 ? Cmd_Argv(2) : "";
+        if (strcmp(opt, "on") == 0) {
+            oglib_trace_enable(1);
+            Con_Printf("OASIS trace recording on. Use 'star trace dump' to write the trace.\n");
+        } else if (strcmp(opt, "off") == 0) {
+            oglib_trace_enable(0);
+            Con_Printf("OASIS trace recording off.\n");
+        } else if (strcmp(opt, "dump") == 0) {
+            const char* path = argc >= 4 ? Cmd_Argv(3) : "oquake_trace.json";
+            if (oglib_trace_export_json(path))
+                Con_Printf("OASIS trace written to %s (open in ui.perfetto.dev or chrome://tracing).\n", path);
+            else
+                Con_Printf("Could not write OASIS trace to %s.\n", path);
+        } else {
+            Con_Printf("OASIS trace recording is %s\n", OGLIB_TRACE_ON() ? "on" : "off");
+            Con_Printf("Usage: star trace on|off|dump [file]\n");
+        }
+        return;
+    }
     if (strcmp(sub, "debug") == 0) {
         if (argc < 3 || !Cmd_Argv(2) || strcmp(Cmd_Argv(2), "status") == 0) {
             Con_Printf("STAR debug logging is %s\n", g_star_debug_logging ? "on" : "off");
@@ -4747,6 +4911,7 @@ void OQuake_STAR_Console_f(void) {
         if (strcmp(Cmd_Argv(2), "on") == 0) {
             g_star_debug_logging = true;
             ogengine_set_debug(1);
+            oglib_log_async_set_echo_stderr(1);
             Con_Printf("STAR debug logging enabled. Check console and star_api.log (in id1 or exe dir).\n");
             OQ_StarDebugLog("STAR debug ON | max_health=%s max_armor=%s always_add=%s allow_pickup_if_max=%s use_health_on_pickup=%s use_armor_on_pickup=%s use_powerup_on_pickup=%s",
                 oquake_star_max_health.string, oquake_star_max_armor.string,
@@ -4754,7 +4919,7 @@ void OQuake_STAR_Console_f(void) {
                 oquake_star_use_health_on_pickup.string, oquake_star_use_armor_on_pickup.string, oquake_star_use_powerup_on_pickup.string);
             return;
         }
-        if (strcmp(Cmd_Argv(2), "off") == 0) { g_star_debug_logging = false; ogengine_set_debug(0); Con_Printf("STAR debug logging disabled.\n"); return; }
+        if (strcmp(Cmd_Argv(2), "off") == 0) { g_star_debug_logging = false; ogengine_set_debug(0); oglib_log_async_set_echo_stderr(0); Con_Printf("STAR debug logging disabled.\n"); return; }
         Con_Printf("Unknown debug option: %s. Use on|off|status.\n", Cmd_Argv(2));
         return;
     }
@@ -4782,6 +4947,7 @@ void OQuake_STAR_Console_f(void) {
         ogengine_cleanup();
         g_star_initialized = 0;
         g_star_beamed_in = 0;
+        oglib_beamin_reset(&g_oq_beamin);
         OQ_ResetCrossGameBeamTransferState();
         }
 
@@ -4930,6 +5096,7 @@ void OQuake_STAR_Console_f(void) {
         ogengine_cleanup();
         g_star_initialized = 0;
         g_star_beamed_in = 0;
+        oglib_beamin_reset(&g_oq_beamin);
         OQ_ResetCrossGameBeamTransferState();
         g_star_refresh_xp_called_this_session = 0;  /* Next beam-in will call refresh once. */
         g_star_username[0] = 0;
@@ -5732,11 +5899,7 @@ void OQuake_STAR_DrawInventoryOverlay(cb_context_t* cbx) {
                         if (g_quest_scroll < 0) g_quest_scroll = 0;
                         q_strlcpy(panel_quest_id, q_id[qi], sizeof(panel_quest_id));
                         s_key_debounce_frames = 3;  /* ignore Up/Down for 3 frames to avoid key repeat moving selection */
-                        {
-                            static char sync_log[128];
-                            q_snprintf(sync_log, sizeof(sync_log), "[Quest] Popup sync: fi=%d id=%.36s", fi, g_quest_tracker_id);
-                            ogengine_log_to_file(sync_log);
-                        }
+                        OGLIB_LOGI("[Quest] Popup sync: fi=%d id=%.36s", fi, g_quest_tracker_id);
                         break;
                     }
                 }
@@ -6104,7 +6267,7 @@ void OQuake_STAR_DrawInventoryOverlay(cb_context_t* cbx) {
                         }
                         ogengine_start_quest_then_set_active_objective(panel_quest_id, sel_obj);
                         used_start_then = 1;
-                        ogengine_log_to_file("[Quest] Enter objective: start_then_set_active_objective (ODOOM parity)");
+                        OGLIB_LOGI("[Quest] Enter objective: start_then_set_active_objective (ODOOM parity)");
                     } else if (!same_tracked && inprog) {
                         if (strcmp(panel_quest_id, g_quest_tracker_id) != 0) {
                             g_quest_tracker_active_objective_id[0] = '\0';
@@ -6121,11 +6284,9 @@ void OQuake_STAR_DrawInventoryOverlay(cb_context_t* cbx) {
                         g_quest_tracker_objective_index = g_quest_objectives_selected;
                         g_quest_tracker_active_display_index = g_quest_objectives_selected;
                         {
-                            static char log_buf[512];
                             const char* qn = g_quest_tracker_name[0] ? g_quest_tracker_name : "(none)";
                             const char* on = (g_quest_objectives_selected >= 0 && g_quest_objectives_selected < obj_count && obj_name[g_quest_objectives_selected][0]) ? obj_name[g_quest_objectives_selected] : "(none)";
-                            q_snprintf(log_buf, sizeof(log_buf), "[Quest] SAVE (Enter on objective) quest_id=%s objective_id=%s quest_name=%s objective_name=%s", g_quest_tracker_id, g_quest_tracker_active_objective_id, qn, on);
-                            ogengine_log_to_file(log_buf);
+                            OGLIB_LOGI("[Quest] SAVE (Enter on objective) quest_id=%s objective_id=%s quest_name=%s objective_name=%s", g_quest_tracker_id, g_quest_tracker_active_objective_id, qn, on);
                         }
                         {
                             char persist_obj[64];
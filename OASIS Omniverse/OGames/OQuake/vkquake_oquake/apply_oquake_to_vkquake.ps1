@@ -86,16 +86,24 @@ if (-not $StarDll -and (Test-Path (Join-Path $StarPublishDir "ogengine.dll"))) {
     if (-not (Test-Path $StarLib)) { $StarLib = $null }
 }
 
-# star_sync API is exported from ogengine.dll; only header is copied for declarations.
-$starSyncRoot = $OGEngineClientRoot
+# star_sync: the C implementation (ogengine_sync.c) is compiled into vkQuake by default. OASIS_STAR_SYNC_IN_CLIENT=1 (set by
+# BUILD_OQUAKE) uses the star_sync exports from ogengine.dll instead. Quake\ogengine_sync.c being present is what the project
+# and meson patches below key on, so in-client mode removes it.
+$StarSyncInClient = ($env:OASIS_STAR_SYNC_IN_CLIENT -eq "1")
 $files = @(
     @{ Src = Join-Path $OQuakeCode "oquake_ogengine_integration.c"; Dest = "oquake_ogengine_integration.c" },
     @{ Src = Join-Path $OQuakeCode "oquake_ogengine_integration.h"; Dest = "oquake_ogengine_integration.h" },
     @{ Src = Join-Path $OQuakeCode "oquake_version.h"; Dest = "oquake_version.h" },
     @{ Src = Join-Path $ScriptDir "pr_ext_oquake.c"; Dest = "pr_ext_oquake.c" },
     @{ Src = Join-Path $OGEngineClientRoot "ogengine.h"; Dest = "ogengine.h" },
-    @{ Src = Join-Path $starSyncRoot "star_sync.h"; Dest = "star_sync.h" }
+    @{ Src = Join-Path $OGEngineClientRoot "ogengine_sync.h"; Dest = "ogengine_sync.h" }
 )
+if (-not $StarSyncInClient) {
+    $files += @{ Src = Join-Path $OGEngineClientRoot "ogengine_sync.c"; Dest = "ogengine_sync.c" }
+} elseif (Test-Path (Join-Path $QuakeDir "ogengine_sync.c")) {
+    Remove-Item -Path (Join-Path $QuakeDir "ogengine_sync.c") -Force
+}
+$StarSyncC = (-not $StarSyncInClient) -and (Test-Path (Join-Path $OGEngineClientRoot "ogengine_sync.c"))
 $copied = 0
 foreach ($f in $files) {
     if (Test-Path $f.Src) {
@@ -895,6 +903,11 @@ foreach ($vcxproj in $vcxprojPaths) {
     <ClCompile Include="$pathPrefix`pr_ext_oquake.c">
       <PrecompiledHeader>NotUsing</PrecompiledHeader>
     </ClCompile>
+"@
+    $blockStarSync = @"
+    <ClCompile Include="$pathPrefix`ogengine_sync.c">
+      <PrecompiledHeader>NotUsing</PrecompiledHeader>
+    </ClCompile>
 "@
     if ($projContent -notmatch 'oquake_ogengine_integration\.c') {
         $projContent = $projContent -replace "(\r?\n)(\s*<ClCompile\s+Include=`"[^`"]*pr_ext\.c`"[^\r\n]*)(\r?\n)", "`$1`$2`$3$blockIntegration`r`n"
@@ -916,7 +929,16 @@ foreach ($vcxproj in $vcxprojPaths) {
     if ($projContent -match 'star_sync\.c') {
         $projContent = $projContent -replace '\s*<ClCompile\s+Include="[^"]*star_sync\.c"[^>]*>\s*\r?\n\s*<PrecompiledHeader>[^<]+</PrecompiledHeader>\s*\r?\n\s*</ClCompile>\s*\r?\n', "`r`n"
         $vcxprojChanged = $true
-        Write-Host "[OQuake] Removed star_sync.c from project (use star_sync exports from ogengine.dll only)" -ForegroundColor Green
+        Write-Host "[OQuake] Removed star_sync.c from project (renamed ogengine_sync.c)" -ForegroundColor Green
+    }
+    if ($StarSyncC -and $projContent -notmatch 'ogengine_sync\.c') {
+        $projContent = $projContent -replace "(\r?\n)(\s*<ClCompile\s+Include=`"[^`"]*oquake_ogengine_integration\.c`"[^\r\n]*)(\r?\n)", "`$1`$2`$3$blockStarSync`r`n"
+        $vcxprojChanged = $true
+        Write-Host "[OQuake] Added ogengine_sync.c to project $(Split-Path -Leaf $vcxproj) (C star_sync)" -ForegroundColor Green
+    } elseif (-not $StarSyncC -and $projContent -match 'ogengine_sync\.c') {
+        $projContent = $projContent -replace '\s*<ClCompile\s+Include="[^"]*ogengine_sync\.c"[^>]*>\s*\r?\n\s*<PrecompiledHeader>[^<]+</PrecompiledHeader>\s*\r?\n\s*</ClCompile>\s*\r?\n', "`r`n"
+        $vcxprojChanged = $true
+        Write-Host "[OQuake] Removed ogengine_sync.c from project (star_sync from ogengine.dll)" -ForegroundColor Green
     }
     if ($projContent -notmatch 'star_api\.lib') {
         if ($projContent -match '<AdditionalDependencies>([^<]*)</AdditionalDependencies>') {
@@ -943,11 +965,16 @@ foreach ($vcxproj in $vcxprojPaths) {
         $vcxprojChanged = $true
         Write-Host "[OQuake] Added OASIS_STAR_API to PreprocessorDefinitions in $(Split-Path -Leaf $vcxproj)" -ForegroundColor Green
     }
-    # Always use client-exported star_sync_* from ogengine.dll (do not compile star_sync.c in engine).
-    if ($projContent -notmatch 'OASIS_STAR_SYNC_IN_CLIENT') {
+    # OASIS_STAR_SYNC_IN_CLIENT only when star_sync comes from ogengine.dll; with ogengine_sync.c compiled in it must be absent
+    # or the OGENGINE_SYNC_HAS_* features are compiled out of the integration.
+    if (-not $StarSyncC -and $projContent -notmatch 'OASIS_STAR_SYNC_IN_CLIENT') {
         $projContent = $projContent -replace '(<PreprocessorDefinitions>)([^<]+)(</PreprocessorDefinitions>)', "`$1OASIS_STAR_SYNC_IN_CLIENT;`$2`$3"
         $vcxprojChanged = $true
         Write-Host "[OQuake] Added OASIS_STAR_SYNC_IN_CLIENT to PreprocessorDefinitions (star_sync from DLL)" -ForegroundColor Green
+    } elseif ($StarSyncC -and $projContent -match 'OASIS_STAR_SYNC_IN_CLIENT') {
+        $projContent = $projContent -replace 'OASIS_STAR_SYNC_IN_CLIENT;?', ''
+        $vcxprojChanged = $true
+        Write-Host "[OQuake] Removed OASIS_STAR_SYNC_IN_CLIENT from PreprocessorDefinitions (C star_sync)" -ForegroundColor Green
     }
     # Do NOT define OQUAKE_OGENGINE_TRACKER_STUBS so the game uses the real ogengine.dll for tracker APIs (ogengine_set_active_quest, get_quest_tracker_objectives_string, etc.). If the define is present, remove it so selecting a quest in-game actually persists to the API.
     if ($projContent -match 'OQUAKE_OGENGINE_TRACKER_STUBS') {
@@ -971,15 +998,35 @@ foreach ($vcxproj in $vcxprojPaths) {
 }
 
 # Patch vkQuake meson.build for Linux/macOS: add OQuake sources + star_api so ninja build links integration (same as vcxproj on Windows).
+# star_sync follows Quake/ogengine_sync.c at configure time: compiled in when present, else OASIS_STAR_SYNC_IN_CLIENT (star_api exports).
+$mesonStarSyncBlock = @"
+    if import('fs').exists(join_paths(meson.source_root(), 'Quake', 'ogengine_sync.c'))
+        srcs += ['Quake/ogengine_sync.c']
+        deps += dependency('threads')
+    else
+        cflags += ['-DOASIS_STAR_SYNC_IN_CLIENT']
+    endif
+"@
 $mesonBuildPath = Join-Path $VkQuakeSrc "meson.build"
 if (Test-Path $mesonBuildPath) {
     $mesonContent = Get-Content $mesonBuildPath -Raw
+    if ($mesonContent -match "oquake_ogengine_integration\.c" -and $mesonContent -notmatch "ogengine_sync\.c") {
+        $mesonContent = $mesonContent -replace "(\r?\n)(\s*srcs \+= \['Quake/oquake_ogengine_integration\.c', 'Quake/pr_ext_oquake\.c'\]\s*\r?\n)", "`$1`$2$mesonStarSyncBlock`n"
+        Set-Content -Path $mesonBuildPath -Value $mesonContent -NoNewline
+        Write-Host "[OQuake] Patched meson.build: star_sync from Quake/ogengine_sync.c when present" -ForegroundColor Green
+        $buildDir = Join-Path $VkQuakeSrc "build"
+        if (Test-Path $buildDir) {
+            Remove-Item -Recurse -Force $buildDir
+            Write-Host "[OQuake] Cleared build dir so meson reconfigures with ogengine_sync.c" -ForegroundColor Yellow
+        }
+    }
     if ($mesonContent -notmatch "oquake_ogengine_integration\.c") {
         $mesonBlock = @"
 
 # OQuake (injected by apply_oquake_to_vkquake.ps1): add integration sources + star_api when present
 if import('fs').exists(join_paths(meson.source_root(), 'Quake', 'oquake_ogengine_integration.c'))
     srcs += ['Quake/oquake_ogengine_integration.c', 'Quake/pr_ext_oquake.c']
+$mesonStarSyncBlock
     deps += cc.find_library('star_api', dirs: join_paths(meson.source_root(), 'Quake'), required: true)
     cflags += ['-DOASIS_STAR_API', '-DOQUAKE_OGENGINE_SESSION_IMPL', '-DOQUAKE_OGENGINE_REFRESH_AVATAR_PROFILE_IMPL']
 endif